@@ -0,0 +1,198 @@
+/*
+ * analyzer_bench
+ *
+ * Timeline walks per input and analysis time:
+ *
+ *   separate — each rule's own entry point
+ *              (variable/declaration constraints, scope and variable
+ *              lifetimes, use, scope validation): six walks
+ *   fused    — analyze_timeline(): every rule as a pass, one walk
+ *
+ * The input is a generated program (nested blocks with declarations,
+ * uses, redeclarations and shadowing). Results of both paths are
+ * compared and the bench fails if they differ.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "analyzer/analyzer.h"
+#include "analyzer/constraint/engine/engine.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+
+#define ROUNDS 20
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*
+ * `blocks` sibling blocks, each nested `depth` deep, each level with
+ * a handful of statements. Blocks stay well under the parser's
+ * per-block statement limit.
+ */
+static void write_program(FILE *f, int blocks, int depth)
+{
+    fprintf(f, "int main() {\n  int g;\n");
+    for (int b = 0; b < blocks; b++) {
+        for (int d = 0; d < depth; d++) {
+            fprintf(f, "{\n");
+            fprintf(f, "int a%d;\n", d);
+            fprintf(f, "a%d;\n", d);
+            fprintf(f, "g;\n");
+            if (d % 3 == 0) fprintf(f, "int g;\n");         /* shadow */
+            if (d % 5 == 0) fprintf(f, "int a%d;\n", d);    /* redecl */
+            if (d % 7 == 0) fprintf(f, "missing%d;\n", d);  /* undeclared */
+        }
+        for (int d = 0; d < depth; d++) {
+            fprintf(f, "}\n");
+        }
+    }
+    fprintf(f, "return 0;\n}\n");
+}
+
+/* Field-wise: padding and anchor allocations differ between runs */
+static int same_constraints(const Constraint *a, const Constraint *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (a[i].kind != b[i].kind || a[i].time != b[i].time ||
+            a[i].scope_id != b[i].scope_id ||
+            a[i].storage_id != b[i].storage_id ||
+            !a[i].anchor != !b[i].anchor ||
+            (a[i].anchor && a[i].anchor->node_id != b[i].anchor->node_id)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int same_uses(const UseReport *a, const UseReport *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (a[i].kind != b[i].kind || a[i].time != b[i].time ||
+            a[i].scope_id != b[i].scope_id ||
+            a[i].storage_id != b[i].storage_id) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int same_violations(
+    const ScopeViolation *a,
+    const ScopeViolation *b,
+    size_t n
+)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (a[i].kind != b[i].kind || a[i].time != b[i].time ||
+            a[i].scope_id != b[i].scope_id) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Lifetimes are all 8-byte fields: no padding */
+static int same(const void *a, const void *b, size_t n)
+{
+    return n == 0 || memcmp(a, b, n) == 0;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/liminal_analyzer_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+
+    FILE *f = fdopen(fd, "w");
+    write_program(f, 40, 20);
+    fclose(f);
+
+    ASTProgram *ast = c_parse_file_to_ast(path);
+    remove(path);
+    if (!ast) {
+        fprintf(stderr, "analyzer_bench: parse failed\n");
+        return 1;
+    }
+
+    Universe *u = executor_build(ast);
+    if (!u) {
+        fprintf(stderr, "analyzer_bench: executor failed\n");
+        return 1;
+    }
+
+    const Timeline *tl = &u->timeline;
+    size_t n = tl->count;
+
+    ScopeLifetime *sl = malloc(n * sizeof(*sl));
+    VariableLifetime *vl = malloc(n * sizeof(*vl));
+    UseReport *ur = malloc(n * sizeof(*ur));
+    ScopeViolation *sv = malloc(n * sizeof(*sv));
+
+    size_t nsl = 0, nvl = 0, nur = 0, nsv = 0;
+    ConstraintArtifact c = {0};
+
+    /* separate */
+    double t0 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        free(c.items);
+        c   = analyze_constraints(tl);              /* 2 rules */
+        nsl = lifetime_collect_scopes(tl, sl, n);
+        nvl = lifetime_collect_variables(tl, vl, n);
+        nur = analyze_step_use(tl, sl, nsl, ur, n);
+        nsv = validate_scope_invariants(tl, sv, n);
+    }
+    double t1 = now_ns();
+
+    /* fused */
+    AnalysisResult a = {0};
+    int ran = 1;
+    double t2 = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        analysis_result_free(&a);
+        ran = ran && analyze_timeline(tl, &a);
+    }
+    double t3 = now_ns();
+
+    int ok =
+        ran &&
+        a.constraints.count == c.count &&
+        same_constraints(a.constraints.items, c.items, c.count) &&
+        a.scope_count == nsl &&
+        same(a.scopes, sl, nsl * sizeof(*sl)) &&
+        a.variable_count == nvl &&
+        same(a.variables, vl, nvl * sizeof(*vl)) &&
+        a.use_count == nur &&
+        same_uses(a.uses, ur, nur) &&
+        a.violation_count == nsv &&
+        same_violations(a.violations, sv, nsv);
+
+    printf("== analyzer: %zu steps, %zu constraints ==\n", n, c.count);
+    printf("%-9s walks/input=%d %10.1f us/input\n",
+           "separate", 6, (t1 - t0) / ROUNDS / 1e3);
+    printf("%-9s walks/input=%zu %10.1f us/input\n",
+           "fused", a.traversals, (t3 - t2) / ROUNDS / 1e3);
+    printf("results %s\n", ok ? "identical" : "DIFFER");
+
+    analysis_result_free(&a);
+    free(c.items);
+    free(sl);
+    free(vl);
+    free(ur);
+    free(sv);
+    universe_destroy(u);
+    ast_program_free(ast);
+
+    return ok ? 0 : 1;
+}
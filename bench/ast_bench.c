@@ -0,0 +1,109 @@
+/*
+ * ast_bench
+ *
+ * AST construction and teardown as programs grow:
+ *
+ *   parse — c_parse_file_to_ast on a generated program
+ *   free  — ast_program_free (a single arena release)
+ *
+ * Also reports how many arena chunks back the whole program,
+ * i.e. the heap allocations spent on nodes and statement lists.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*
+ * `leaves` blocks of 48 statements, arranged as a tree with at most
+ * 16 blocks per level.
+ */
+static void write_blocks(FILE *f, size_t leaves)
+{
+    if (leaves <= 1) {
+        fprintf(f, "{\n");
+        for (int i = 0; i < 16; i++) {
+            fprintf(f, "int v%d;\nv%d;\nw%d;\n", i, i, i);
+        }
+        fprintf(f, "}\n");
+        return;
+    }
+
+    size_t per = (leaves + 15) / 16;
+    fprintf(f, "{\n");
+    for (size_t done = 0; done < leaves; done += per) {
+        write_blocks(f, leaves - done < per ? leaves - done : per);
+    }
+    fprintf(f, "}\n");
+}
+
+static void write_program(FILE *f, size_t leaves)
+{
+    fprintf(f, "int main() {\n");
+    write_blocks(f, leaves);
+    fprintf(f, "return 0;\n}\n");
+}
+
+static int bench(size_t blocks)
+{
+    char path[] = "/tmp/liminal_ast_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 0;
+    }
+
+    FILE *f = fdopen(fd, "w");
+    write_program(f, blocks);
+    fclose(f);
+
+    double t0 = now_ns();
+    ASTProgram *p = c_parse_file_to_ast(path);
+    double t1 = now_ns();
+    remove(path);
+
+    if (!p) {
+        fprintf(stderr, "ast_bench: parse failed\n");
+        return 0;
+    }
+
+    size_t nodes = p->count;
+    ArenaStats st;
+    arena_stats(&p->arena, &st);
+
+    double t2 = now_ns();
+    ast_program_free(p);
+    double t3 = now_ns();
+
+    printf("%-8zu nodes=%-8zu chunks=%-3zu reserved=%6zuK "
+           "parse %8.1f ns/node  free %8.1f us\n",
+           blocks, nodes, st.chunks, st.reserved / 1024,
+           (t1 - t0) / nodes, (t3 - t2) / 1e3);
+
+    return 1;
+}
+
+int main(void)
+{
+    printf("== ast: construction and teardown ==\n");
+
+    size_t sizes[] = { 10, 1000, 20000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (!bench(sizes[i])) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
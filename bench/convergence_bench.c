@@ -0,0 +1,191 @@
+/*
+ * convergence_bench
+ *
+ * Grouping diagnostics by cause key, then the fix surface:
+ *
+ *   scan   — the previous convergence_map_add: linear search of
+ *            the entries per diagnostic, one realloc'd array per
+ *            entry (O(n × causes)); only run up to SCAN_MAX
+ *   hashed — convergence_map_build (open addressing, members as
+ *            ranges of one arena buffer) and build_fix_surface
+ *
+ * A quarter of the keys are distinct, spread over the input.
+ * Wherever the scan runs, the bench fails unless both give the
+ * same entries in the same order with the same members.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "analyzer/analyzer.h"
+#include "consumers/consumers.h"
+#include "consumers/fix_surface/fix_surface_build.h"
+
+#define SCAN_MAX 50000
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Previous implementation
+ * ------------------------------------------------------------ */
+
+typedef struct ScanEntry {
+    CauseKey key;
+    const Diagnostic **diagnostics;
+    size_t count;
+    size_t capacity;
+} ScanEntry;
+
+typedef struct ScanMap {
+    ScanEntry *entries;
+    size_t count;
+    size_t capacity;
+} ScanMap;
+
+static void scan_add(ScanMap *m, const CauseKey *key, const Diagnostic *d)
+{
+    ScanEntry *e = NULL;
+
+    for (size_t i = 0; i < m->count; i++) {
+        if (cause_key_equal(&m->entries[i].key, key)) {
+            e = &m->entries[i];
+            break;
+        }
+    }
+
+    if (!e) {
+        if (m->count == m->capacity) {
+            size_t nc = m->capacity ? m->capacity * 2 : 4;
+            m->entries = realloc(m->entries, nc * sizeof(*m->entries));
+            m->capacity = nc;
+        }
+        e = &m->entries[m->count++];
+        memset(e, 0, sizeof(*e));
+        e->key = *key;
+    }
+
+    if (e->count == e->capacity) {
+        size_t nc = e->capacity ? e->capacity * 2 : 4;
+        e->diagnostics = realloc(e->diagnostics, nc * sizeof(*e->diagnostics));
+        e->capacity = nc;
+    }
+    e->diagnostics[e->count++] = d;
+}
+
+static void scan_free(ScanMap *m)
+{
+    for (size_t i = 0; i < m->count; i++) {
+        free(m->entries[i].diagnostics);
+    }
+    free(m->entries);
+}
+
+/* ------------------------------------------------------------
+ * Harness
+ * ------------------------------------------------------------ */
+
+static int same_groups(const ScanMap *a, const ConvergenceMap *b)
+{
+    if (a->count != b->count) {
+        return 0;
+    }
+    for (size_t i = 0; i < a->count; i++) {
+        const ScanEntry *x = &a->entries[i];
+        const ConvergenceEntry *y = &b->entries[i];
+
+        if (!cause_key_equal(&x->key, &y->key) || x->count != y->count) {
+            return 0;
+        }
+        for (size_t j = 0; j < x->count; j++) {
+            if (x->diagnostics[j] != convergence_entry_diagnostic(b, y, j)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    size_t sizes[] = { 1000, 10000, 50000, 1000000 };
+    int ok = 1;
+
+    printf("== convergence ==\n");
+    printf("%-8s %-8s %12s %12s %12s  %s\n",
+           "diags", "causes", "scan ms", "hashed ms", "fix ms", "result");
+
+    for (size_t s = 0; ok && s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        size_t causes = n / 4;
+
+        Diagnostic *items = calloc(n, sizeof(*items));
+        const Diagnostic **diags = malloc(n * sizeof(*diags));
+        CauseKey *keys = malloc(n * sizeof(*keys));
+        if (!items || !diags || !keys) {
+            fprintf(stderr, "convergence_bench: out of memory\n");
+            return 1;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            size_t c = (i * 2654435761u) % causes;
+            items[i].time = i;
+            diags[i] = &items[i];
+            keys[i] = (CauseKey){
+                .step     = (StepKind)(STEP_DECLARE + c % 2),
+                .ast_id   = c / 2,
+                .scope_id = c % 7
+            };
+        }
+
+        Arena arena;
+        arena_init(&arena, 1 << 16);
+        ConvergenceMap map;
+
+        double t0 = now_ns();
+        ok = convergence_map_build(&arena, keys, diags, n, &map) == 0;
+        double t1 = now_ns();
+        FixSurface fs = build_fix_surface(&map);
+        double t2 = now_ns();
+
+        ok = ok && map.count == causes && fs.count == causes;
+
+        char scan[32] = "-";
+        const char *result = ok ? "ok" : "WRONG";
+        if (ok && n <= SCAN_MAX) {
+            ScanMap old = {0};
+            double t3 = now_ns();
+            for (size_t i = 0; i < n; i++) {
+                scan_add(&old, &keys[i], diags[i]);
+            }
+            double t4 = now_ns();
+            snprintf(scan, sizeof(scan), "%.2f", (t4 - t3) / 1e6);
+
+            ok = same_groups(&old, &map);
+            result = ok ? "identical" : "DIFFER";
+            scan_free(&old);
+        }
+
+        printf("%-8zu %-8zu %12s %12.2f %12.2f  %s\n", n, causes, scan,
+               (t1 - t0) / 1e6, (t2 - t1) / 1e6, result);
+
+        free(fs.causes);
+        arena_destroy(&arena);
+        free(keys);
+        free(diags);
+        free(items);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "convergence_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
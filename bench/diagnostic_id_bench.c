@@ -0,0 +1,347 @@
+/*
+ * diagnostic_id_bench
+ *
+ * Diagnostic ids, old and new:
+ *
+ *   old — the previous id: kind ^ time << 16 ^ scope_id << 32
+ *   new — diagnostic_id_from_constraint (hash64 of kind, name and
+ *         function spellings, and the ordinal among constraints
+ *         sharing those)
+ *
+ * Collisions, over synthetic records (every one distinct):
+ *
+ *   run     — one long run: 500 names over 200 functions, times
+ *             well past 2^16, nested scopes
+ *   dense   — four names in one function, so ordinals are all
+ *             that tell records apart
+ *   random  — every field drawn over its full range
+ *
+ * Edits, over real source: a program with one diagnostic of each
+ * kind is analyzed, then again with unrelated code added (a
+ * declaration, a block, a helper function in front, statements
+ * after). "moved" counts the original diagnostics whose id is
+ * missing afterwards.
+ *
+ * The bench fails if the new id collides anywhere, if any new id
+ * moves, or if an edit changes the number of diagnostics other
+ * than by the ones it adds itself.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+#include "executor/executor.h"
+#include "analyzer/analyzer.h"
+
+#define RECORDS 1000000
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rng_state = 0x2545f4914f6cdd1dull;
+
+static uint64_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/* ------------------------------------------------------------
+ * Previous implementation
+ * ------------------------------------------------------------ */
+
+static uint64_t id_old(uint64_t kind, uint64_t time, uint64_t scope_id)
+{
+    return kind ^ time << 16 ^ scope_id << 32;
+}
+
+/* ------------------------------------------------------------
+ * Corpora
+ * ------------------------------------------------------------ */
+
+typedef enum Corpus {
+    CORPUS_RUN,
+    CORPUS_DENSE,
+    CORPUS_RANDOM,
+    CORPUS_MAX
+} Corpus;
+
+static const char *CORPUS_NAMES[CORPUS_MAX] = { "run", "dense", "random" };
+
+#define RUN_KINDS     3
+#define RUN_NAMES     500
+#define RUN_FUNCTIONS 200
+
+/* Spelling hash of the i-th name, as intern_hash64 would give */
+static uint64_t spelling_of(const char *prefix, uint64_t i)
+{
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%s%llu", prefix,
+                       (unsigned long long)i);
+    return hash64(buf, (size_t)len, 0);
+}
+
+/* Ordinals count earlier records of the same kind, name, function */
+static int make_corpus(Corpus k, Constraint *c, uint32_t *ord, size_t n)
+{
+    uint32_t *seen = calloc(RUN_KINDS * RUN_NAMES * RUN_FUNCTIONS,
+                            sizeof(*seen));
+    uint64_t time = 0, scopes = 0, depth = 0;
+
+    if (!seen) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t r = rng();
+        uint64_t kind = (r >> 8) % RUN_KINDS;
+        uint64_t name, fn;
+
+        switch (k) {
+        case CORPUS_RUN:
+            /* A few steps between diagnostics; scopes open and close */
+            time += 1 + r % 8;
+            if (depth == 0 || r % 5 == 0) {
+                scopes++;
+                depth++;
+            } else if (r % 5 == 1 && depth > 1) {
+                depth--;
+            }
+            name = (r >> 16) % RUN_NAMES;
+            fn   = (r >> 32) % RUN_FUNCTIONS;
+            break;
+
+        case CORPUS_DENSE:
+            time += 1 + r % 4;
+            scopes = 1 + (r >> 16) % 8;
+            name = (r >> 24) % 4;
+            fn   = 0;
+            break;
+
+        default:
+            c[i] = (Constraint){
+                .kind     = (ConstraintKind)kind,
+                .time     = rng(),
+                .scope_id = rng(),
+                .spelling = rng(),
+                .function = rng()
+            };
+            ord[i] = (uint32_t)(r >> 32);
+            continue;
+        }
+
+        c[i] = (Constraint){
+            .kind     = (ConstraintKind)kind,
+            .time     = time,
+            .scope_id = k == CORPUS_RUN ? scopes - (r >> 40) % depth
+                                        : scopes,
+            .spelling = spelling_of("v", name),
+            .function = spelling_of("f", fn)
+        };
+        ord[i] = seen[(kind * RUN_NAMES + name) * RUN_FUNCTIONS + fn]++;
+    }
+
+    free(seen);
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Edits
+ * ------------------------------------------------------------ */
+
+#define MAIN_BODY \
+    "    int x;\n" \
+    "    {\n" \
+    "        int x;\n" \
+    "    }\n" \
+    "    int y;\n" \
+    "    int y;\n" \
+    "    z;\n"
+
+/* Shadowing of x, redeclaration of y, use of undeclared z */
+static const char BASE[] =
+    "int main() {\n" MAIN_BODY "    return 0;\n}\n";
+
+typedef struct Edit {
+    const char *name;
+    const char *source;
+    size_t      added;      /* diagnostics of the inserted code */
+} Edit;
+
+static const Edit EDITS[] = {
+    { "decl",
+      "int main() {\n    int a;\n" MAIN_BODY "    return 0;\n}\n", 0 },
+    { "block",
+      "int main() {\n    {\n        int b;\n        b;\n    }\n"
+      MAIN_BODY "    return 0;\n}\n", 0 },
+    { "helper",
+      "int helper() {\n    int q;\n    {\n        int q;\n    }\n"
+      "    return 0;\n}\n\n"
+      "int main() {\n" MAIN_BODY "    return 0;\n}\n", 1 },
+    { "after",
+      "int main() {\n" MAIN_BODY "    int c;\n    c;\n"
+      "    return 0;\n}\n", 0 },
+};
+
+#define EDIT_COUNT (sizeof(EDITS) / sizeof(EDITS[0]))
+
+/* Parse, execute and analyze `src`; empty on any failure */
+static DiagnosticArtifact diagnose(Universe *u, ASTProgram **ast,
+                                   const char *src)
+{
+    *ast = c_parse_source_recycle("edit.c", src, strlen(src), *ast);
+    if (!*ast || !universe_reset(u) || !executor_run(u, *ast)) {
+        return (DiagnosticArtifact){0};
+    }
+    return analyze_diagnostics(&u->timeline);
+}
+
+static uint64_t diag_id_old(const Diagnostic *d)
+{
+    return id_old((uint64_t)d->kind, d->time, d->scope_id);
+}
+
+/* Diagnostics of `a` whose id (old or new) is not in `b` */
+static size_t moved(const DiagnosticArtifact *a,
+                    const DiagnosticArtifact *b, int old)
+{
+    size_t n = 0;
+
+    for (size_t i = 0; i < a->count; i++) {
+        uint64_t id = old ? diag_id_old(&a->items[i])
+                          : a->items[i].id.value;
+        int found = 0;
+
+        for (size_t j = 0; j < b->count && !found; j++) {
+            found = id == (old ? diag_id_old(&b->items[j])
+                               : b->items[j].id.value);
+        }
+        n += !found;
+    }
+    return n;
+}
+
+static int run_edits(void)
+{
+    Universe *u = universe_create();
+    ASTProgram *ast = NULL;
+    DiagnosticArtifact base = {0};
+    int ok = u != NULL;
+
+    if (ok) {
+        base = diagnose(u, &ast, BASE);
+        ok = base.count == 3;
+    }
+
+    printf("\n== diagnostic ids: %zu diagnostics, unrelated code added ==\n",
+           base.count);
+    printf("%-8s %10s %10s %10s  %s\n", "edit", "count", "old moved",
+           "new moved", "result");
+
+    for (size_t e = 0; ok && e < EDIT_COUNT; e++) {
+        DiagnosticArtifact d = diagnose(u, &ast, EDITS[e].source);
+        size_t old_moved = moved(&base, &d, 1);
+        size_t new_moved = moved(&base, &d, 0);
+
+        ok = d.count == base.count + EDITS[e].added && new_moved == 0;
+        printf("%-8s %10zu %10zu %10zu  %s\n", EDITS[e].name, d.count,
+               old_moved, new_moved, ok ? "ok" : "WRONG");
+        diagnostic_artifact_free(&d);
+    }
+
+    diagnostic_artifact_free(&base);
+    ast_program_free(ast);
+    universe_destroy(u);
+    return ok;
+}
+
+/* ------------------------------------------------------------
+ * Harness
+ * ------------------------------------------------------------ */
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Records sharing an id with an earlier one (ids are sorted) */
+static size_t collisions(uint64_t *ids, size_t n)
+{
+    size_t dup = 0;
+
+    qsort(ids, n, sizeof(*ids), cmp_u64);
+    for (size_t i = 1; i < n; i++) {
+        dup += ids[i] == ids[i - 1];
+    }
+    return dup;
+}
+
+int main(void)
+{
+    Constraint *c = malloc(RECORDS * sizeof(*c));
+    uint32_t *ord = malloc(RECORDS * sizeof(*ord));
+    uint64_t *old_ids = malloc(RECORDS * sizeof(*old_ids));
+    uint64_t *new_ids = malloc(RECORDS * sizeof(*new_ids));
+    int ok = c && ord && old_ids && new_ids;
+
+    if (!ok) {
+        fprintf(stderr, "diagnostic_id_bench: out of memory\n");
+        return 1;
+    }
+
+    printf("== diagnostic ids: %d records ==\n", RECORDS);
+    printf("%-8s %10s %10s %10s %10s  %s\n", "corpus", "old coll",
+           "new coll", "old ns/id", "new ns/id", "result");
+
+    for (Corpus k = 0; ok && k < CORPUS_MAX; k++) {
+        ok = make_corpus(k, c, ord, RECORDS);
+
+        /* Untimed pass, so both timings start on warm pages */
+        for (size_t i = 0; i < RECORDS; i++) {
+            old_ids[i] = new_ids[i] = 0;
+        }
+
+        double t0 = now_ns();
+        for (size_t i = 0; i < RECORDS; i++) {
+            old_ids[i] = id_old((uint64_t)c[i].kind, c[i].time,
+                                c[i].scope_id);
+        }
+        double t1 = now_ns();
+        for (size_t i = 0; i < RECORDS; i++) {
+            new_ids[i] = diagnostic_id_from_constraint(&c[i], ord[i]).value;
+        }
+        double t2 = now_ns();
+
+        size_t old_coll = collisions(old_ids, RECORDS);
+        size_t new_coll = collisions(new_ids, RECORDS);
+        ok = ok && new_coll == 0;
+
+        printf("%-8s %10zu %10zu %10.2f %10.2f  %s\n", CORPUS_NAMES[k],
+               old_coll, new_coll, (t1 - t0) / RECORDS, (t2 - t1) / RECORDS,
+               ok ? "ok" : "WRONG");
+    }
+
+    free(c);
+    free(ord);
+    free(old_ids);
+    free(new_ids);
+
+    ok = ok && run_edits();
+
+    if (!ok) {
+        fprintf(stderr, "diagnostic_id_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
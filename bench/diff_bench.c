@@ -0,0 +1,199 @@
+/*
+ * diff_bench
+ *
+ * semantic_diff and diagnostic_diff as runs grow:
+ *
+ *   nested — the previous O(n²) semantic_diff (scan the other run
+ *            for every diagnostic); only run up to NESTED_MAX
+ *   hashed — semantic_diff / diagnostic_diff (DiagnosticIndex join)
+ *
+ * The new run keeps 90% of the old diagnostics (a third of those
+ * at a different time), drops the rest and adds as many, with its
+ * order rotated. Wherever the nested diff runs, the bench fails
+ * unless both produce the same entries in the same order.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "analyzer/analyzer.h"
+#include "consumers/consumers.h"
+
+#define NESTED_MAX 20000
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Previous implementation
+ * ------------------------------------------------------------ */
+
+static size_t semantic_diff_nested(
+    const DiagnosticArtifact *old_run,
+    const DiagnosticArtifact *new_run,
+    SemanticDiff *out,
+    size_t cap
+)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < old_run->count; i++) {
+        const Diagnostic *d_old = &old_run->items[i];
+        int found = 0;
+
+        for (size_t j = 0; j < new_run->count; j++) {
+            const Diagnostic *d_new = &new_run->items[j];
+            if (d_new->id.value == d_old->id.value) {
+                found = 1;
+                if (count >= cap)
+                    return count;
+                out[count++] = (SemanticDiff){
+                    .kind = d_new->time == d_old->time ? SEMDIFF_UNCHANGED
+                                                       : SEMDIFF_MOVED,
+                    .id = d_old->id,
+                    .old_time = d_old->time,
+                    .new_time = d_new->time
+                };
+                break;
+            }
+        }
+
+        if (!found && count < cap) {
+            out[count++] = (SemanticDiff){
+                .kind = SEMDIFF_REMOVED,
+                .id = d_old->id,
+                .old_time = d_old->time
+            };
+        }
+    }
+
+    for (size_t i = 0; i < new_run->count; i++) {
+        const Diagnostic *d_new = &new_run->items[i];
+        int found = 0;
+
+        for (size_t j = 0; j < old_run->count; j++) {
+            if (old_run->items[j].id.value == d_new->id.value) {
+                found = 1;
+                break;
+            }
+        }
+
+        if (!found && count < cap) {
+            out[count++] = (SemanticDiff){
+                .kind = SEMDIFF_ADDED,
+                .id = d_new->id,
+                .new_time = d_new->time
+            };
+        }
+    }
+
+    return count;
+}
+
+/* ------------------------------------------------------------
+ * Input
+ * ------------------------------------------------------------ */
+
+static void make_runs(size_t n, DiagnosticArtifact *a, DiagnosticArtifact *b)
+{
+    a->items = calloc(n, sizeof(Diagnostic));
+    b->items = calloc(n, sizeof(Diagnostic));
+    a->count = b->count = n;
+
+    for (size_t i = 0; i < n; i++) {
+        a->items[i].id.value = hash64(&i, sizeof(i), 1);
+        a->items[i].time = i;
+        a->items[i].kind = (DiagnosticKind)(i % DIAG_KIND_MAX);
+    }
+
+    /* Rotated by a third; every tenth replaced, every third moved */
+    for (size_t i = 0; i < n; i++) {
+        size_t src = (i + n / 3) % n;
+        Diagnostic d = a->items[src];
+
+        if (src % 10 == 0) {
+            size_t k = src + n;
+            d.id.value = hash64(&k, sizeof(k), 1);
+        } else if (src % 3 == 0) {
+            d.time += 1;
+        }
+        b->items[i] = d;
+    }
+}
+
+int main(void)
+{
+    size_t sizes[] = { 1000, 4000, 16000, 100000, 1000000 };
+    int ok = 1;
+
+    printf("== diagnostic diff ==\n");
+    printf("%-8s %14s %14s %14s  %s\n",
+           "n", "nested ms", "semantic ms", "diagnostic ms", "result");
+
+    for (size_t s = 0; ok && s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        DiagnosticArtifact a, b;
+        make_runs(n, &a, &b);
+
+        size_t cap = 2 * n;
+        SemanticDiff *x = malloc(cap * sizeof(*x));
+        SemanticDiff *y = malloc(cap * sizeof(*y));
+        DiagnosticDiff *z = malloc(cap * sizeof(*z));
+        if (!a.items || !b.items || !x || !y || !z) {
+            fprintf(stderr, "diff_bench: out of memory\n");
+            return 1;
+        }
+
+        double t0 = now_ns();
+        size_t ny = semantic_diff(&a, &b, y, cap);
+        double t1 = now_ns();
+        size_t nz = diagnostic_diff(&a, &b, z, cap);
+        double t2 = now_ns();
+
+        /* 10% removed, 10% added */
+        ok = ny == n + n / 10 && nz == ny;
+        for (size_t i = 0; ok && i < nz; i++) {
+            ok = z[i].id.value == y[i].id.value &&
+                 (z[i].kind == DIFF_ADDED) == (y[i].kind == SEMDIFF_ADDED);
+        }
+
+        char nested[32] = "-";
+        const char *result = ok ? "ok" : "WRONG";
+        if (ok && n <= NESTED_MAX) {
+            double t3 = now_ns();
+            size_t nx = semantic_diff_nested(&a, &b, x, cap);
+            double t4 = now_ns();
+            snprintf(nested, sizeof(nested), "%.2f", (t4 - t3) / 1e6);
+
+            ok = nx == ny;
+            for (size_t i = 0; ok && i < nx; i++) {
+                ok = x[i].kind == y[i].kind &&
+                     x[i].id.value == y[i].id.value &&
+                     x[i].old_time == y[i].old_time &&
+                     x[i].new_time == y[i].new_time;
+            }
+            result = ok ? "identical" : "DIFFER";
+        }
+
+        printf("%-8zu %14s %14.2f %14.2f  %s\n", n, nested,
+               (t1 - t0) / 1e6, (t2 - t1) / 1e6, result);
+
+        free(x);
+        free(y);
+        free(z);
+        free(a.items);
+        free(b.items);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "diff_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
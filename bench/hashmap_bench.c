@@ -0,0 +1,197 @@
+/*
+ * hashmap_bench
+ *
+ * Scope-binding cost per declaration:
+ *
+ *   legacy     — the previous bucket-array map, cloned (32 pointers
+ *                memcpy'd) before every insert
+ *   persistent — src/common/hashmap (HAMT over interned symbols,
+ *                path copying)
+ *
+ * Both models keep every older version readable, which is what
+ * universe_declare_variable requires.
+ *
+ * Reports bytes allocated and ns per declaration, and ns per lookup
+ * against the final version. Interning happens once per identifier
+ * occurrence in the lexer and is reported separately (ns/ident,
+ * every spelling seen twice).
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "common/common.h"
+
+#define LEGACY_BUCKETS 32
+
+/* ------------------------------------------------------------
+ * Legacy bucket-clone map (verbatim model of the old hashmap)
+ * ------------------------------------------------------------ */
+
+typedef struct LegacyEntry {
+    const char *key;
+    void *value;
+    struct LegacyEntry *next;
+} LegacyEntry;
+
+typedef struct LegacyMap {
+    Arena *arena;
+    size_t bucket_count;
+    LegacyEntry **buckets;
+} LegacyMap;
+
+static uint64_t legacy_hash(const char *s)
+{
+    uint64_t h = 1469598103934665603ULL;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static LegacyMap *legacy_clone(LegacyMap *src, Arena *arena)
+{
+    LegacyMap *m = arena_alloc(arena, sizeof(LegacyMap));
+    m->arena = arena;
+    m->bucket_count = src ? src->bucket_count : LEGACY_BUCKETS;
+    m->buckets = arena_alloc(arena, sizeof(LegacyEntry *) * m->bucket_count);
+    if (src) {
+        memcpy(m->buckets, src->buckets,
+               sizeof(LegacyEntry *) * m->bucket_count);
+    }
+    return m;
+}
+
+static void legacy_put(LegacyMap *m, const char *key, void *value)
+{
+    size_t idx = legacy_hash(key) % m->bucket_count;
+    for (LegacyEntry *e = m->buckets[idx]; e; e = e->next) {
+        if (strcmp(e->key, key) == 0) {
+            e->value = value;
+            return;
+        }
+    }
+    LegacyEntry *e = arena_alloc(m->arena, sizeof(LegacyEntry));
+    e->key = key;
+    e->value = value;
+    e->next = m->buckets[idx];
+    m->buckets[idx] = e;
+}
+
+static void *legacy_get(LegacyMap *m, const char *key)
+{
+    size_t idx = legacy_hash(key) % m->bucket_count;
+    for (LegacyEntry *e = m->buckets[idx]; e; e = e->next) {
+        if (strcmp(e->key, key) == 0) {
+            return e->value;
+        }
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------
+ * Harness
+ * ------------------------------------------------------------ */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static char **make_keys(size_t n)
+{
+    char **keys = malloc(n * sizeof(*keys));
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = malloc(24);
+        snprintf(keys[i], 24, "v%zu", i);
+    }
+    return keys;
+}
+
+static void bench(size_t n)
+{
+    char **keys = make_keys(n);
+    volatile uintptr_t sink = 0;
+
+    /* legacy */
+    Arena la;
+    ArenaStats st;
+    arena_init(&la, 64 * 1024);
+    double t0 = now_ns();
+    LegacyMap *lm = NULL;
+    for (size_t i = 0; i < n; i++) {
+        lm = legacy_clone(lm, &la);
+        legacy_put(lm, keys[i], keys[i]);
+    }
+    double t1 = now_ns();
+    arena_stats(&la, &st);
+    size_t lbytes = st.used;
+    for (size_t i = 0; i < n; i++) {
+        sink += (uintptr_t)legacy_get(lm, keys[i]);
+    }
+    double t2 = now_ns();
+
+    /* interning: first sight, then a repeat */
+    InternTable it;
+    intern_init(&it);
+    Symbol *syms = malloc(n * sizeof(*syms));
+    double ti0 = now_ns();
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < n; i++) {
+            syms[i] = intern(&it, keys[i], strlen(keys[i]));
+        }
+    }
+    double ti1 = now_ns();
+
+    /* persistent */
+    Arena pa;
+    arena_init(&pa, 64 * 1024);
+    double t3 = now_ns();
+    const HashMap *pm = hashmap_create(&pa);
+    for (size_t i = 0; i < n; i++) {
+        pm = hashmap_put(pm, syms[i], keys[i]);
+    }
+    double t4 = now_ns();
+    arena_stats(&pa, &st);
+    size_t pbytes = st.used;
+    for (size_t i = 0; i < n; i++) {
+        sink += (uintptr_t)hashmap_get(pm, syms[i]);
+    }
+    double t5 = now_ns();
+
+    printf("%-8zu %-11s %10.1f B/decl %8.1f ns/decl %8.1f ns/get\n",
+           n, "legacy", (double)lbytes / n, (t1 - t0) / n, (t2 - t1) / n);
+    printf("%-8zu %-11s %10.1f B/decl %8.1f ns/decl %8.1f ns/get\n",
+           n, "persistent", (double)pbytes / n, (t4 - t3) / n, (t5 - t4) / n);
+    printf("%-8zu %-11s %10s        %8.1f ns/ident\n",
+           n, "intern", "", (ti1 - ti0) / (2.0 * n));
+
+    arena_destroy(&la);
+    arena_destroy(&pa);
+    intern_free(&it);
+    free(syms);
+    for (size_t i = 0; i < n; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+    (void)sink;
+}
+
+int main(void)
+{
+    printf("== scope bindings: bytes and time per declaration ==\n");
+
+    size_t sizes[] = { 16, 256, 4096, 32768 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench(sizes[i]);
+    }
+
+    return 0;
+}
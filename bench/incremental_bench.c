@@ -0,0 +1,389 @@
+/*
+ * incremental_bench
+ *
+ * Re-analysis after an edit, on a translation unit of many
+ * functions:
+ *
+ *   full        — executor_run, analyze_diagnostics
+ *   incremental — incremental_run (only changed functions are
+ *                 executed and analyzed)
+ *
+ * Both parse the edited source first; parsing is not timed.
+ *
+ * Edits: none, one statement in the middle function, one in the
+ * first function (every later id shifts), a function inserted at
+ * the front, and two functions swapped.
+ *
+ * KiB/fn is what the session keeps per function between runs.
+ *
+ * After every edit the incremental history and diagnostics must
+ * equal the full run's, step for step, down to the storage every
+ * scope frame binds each name to. No edit touches a name
+ * involved in a diagnostic, so every diagnostic id of the unedited
+ * program must also survive it ("kept"). The bench fails otherwise.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+#include "executor/executor.h"
+#include "analyzer/analyzer.h"
+
+#define FUNCTIONS 2000
+#define ROUNDS    5
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Input
+ * ------------------------------------------------------------ */
+
+typedef struct Buf {
+    char  *data;
+    size_t len;
+    size_t cap;
+} Buf;
+
+static void put(Buf *b, const char *s)
+{
+    size_t n = strlen(s);
+    if (b->len + n > b->cap) {
+        b->cap = (b->len + n) * 2;
+        b->data = realloc(b->data, b->cap);
+        if (!b->data) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+/*
+ * Function `f`: declarations and uses in nested blocks, varying in
+ * count and spelling with `f`; every 64th also shadows, redeclares
+ * and uses an undeclared name. `extra` adds one declaration.
+ */
+static void write_function(Buf *b, int f, int extra)
+{
+    char line[128];
+
+    snprintf(line, sizeof(line), "int f%d() {\n", f);
+    put(b, line);
+
+    for (int i = 0; i < 4 + f % 5; i++) {
+        int v = i + f % 13;
+        snprintf(line, sizeof(line), "    int v%d;\n    v%d;\n", v, v);
+        put(b, line);
+    }
+    snprintf(line, sizeof(line), "    {\n        int w;\n        v%d;\n",
+             f % 13);
+    put(b, line);
+    put(b, "        {\n"
+           "            w;\n            int z;\n        }\n    }\n");
+
+    if (f % 64 == 0) {
+        snprintf(line, sizeof(line),
+                 "    { int v%d; }\n    int w;\n    int w;\n    nope;\n",
+                 f % 13);
+        put(b, line);
+    }
+    if (extra) {
+        put(b, "    int edited;\n");
+    }
+
+    put(b, "    return 0;\n}\n");
+}
+
+typedef enum Edit {
+    EDIT_NONE,
+    EDIT_MIDDLE,
+    EDIT_FIRST,
+    EDIT_INSERT,
+    EDIT_SWAP
+} Edit;
+
+static const char *const EDIT_NAMES[] = {
+    "none", "middle", "first", "insert", "swap"
+};
+
+static void write_program(Buf *b, Edit e)
+{
+    b->len = 0;
+
+    if (e == EDIT_INSERT) {
+        write_function(b, FUNCTIONS, 0);
+    }
+
+    for (int f = 0; f < FUNCTIONS; f++) {
+        int at = f;
+        if (e == EDIT_SWAP && (f == 10 || f == 20)) {
+            at = f == 10 ? 20 : 10;
+        }
+        write_function(b, at, (e == EDIT_MIDDLE && f == FUNCTIONS / 2) ||
+                              (e == EDIT_FIRST && f == 0));
+    }
+}
+
+/* ------------------------------------------------------------
+ * Comparison
+ * ------------------------------------------------------------ */
+
+static uint32_t node_of(void *origin)
+{
+    return origin ? ((const ASTNode *)origin)->id : 0;
+}
+
+/* Storage `name` is bound to in frame `s` alone; 0 if unbound */
+static int binding_of(const Scope *s, Symbol name, Storage *out)
+{
+    const Storage *st = s && s->bindings ? hashmap_get(s->bindings, name)
+                                         : NULL;
+    if (st) {
+        *out = *st;
+    }
+    return st != NULL;
+}
+
+/*
+ * Both frames bind the same storage (id and time of declaration)
+ * to every variable name of the program. Symbols are the
+ * program's, and both sides parsed the same source.
+ */
+static int same_bindings(const Scope *a, const Scope *b,
+                         const Symbol *names, size_t n)
+{
+    if (!a || !b) {
+        return !a && !b;
+    }
+    if ((a->bindings ? hashmap_count(a->bindings) : 0) !=
+        (b->bindings ? hashmap_count(b->bindings) : 0)) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        Storage x, y;
+        int bx = binding_of(a, names[i], &x);
+        int by = binding_of(b, names[i], &y);
+
+        if (bx != by ||
+            (bx && (x.id != y.id || x.declared_at != y.declared_at))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Distinct variable names of `p`; NULL (n = 0) if out of memory */
+static Symbol *variable_names(const ASTProgram *p, size_t *n)
+{
+    size_t cap = p->symbols.count ? p->symbols.count : 1;
+    Symbol *names = malloc(cap * sizeof(*names));
+    uint8_t *seen = calloc(cap, 1);
+
+    *n = 0;
+    for (uint32_t id = 1; names && seen && id <= p->count; id++) {
+        const ASTNode *x = ast_node_get(p, id);
+        Symbol s = x->kind == AST_VAR_DECL ? x->as.vdecl.name
+                 : x->kind == AST_VAR_USE  ? x->as.vuse.name
+                 : SYMBOL_NONE;
+
+        if (s != SYMBOL_NONE && s < cap && !seen[s]) {
+            seen[s] = 1;
+            names[(*n)++] = s;
+        }
+    }
+    free(seen);
+    return names;
+}
+
+static int same_history(const Universe *a, const Universe *b,
+                        const ASTProgram *p)
+{
+    const Timeline *x = &a->timeline, *y = &b->timeline;
+    size_t n;
+    Symbol *names = variable_names(p, &n);
+    int same = names != NULL;
+
+    for (size_t t = 0; same && t < x->count && t < y->count; t++) {
+        same = same_bindings(timeline_scope(x, t), timeline_scope(y, t),
+                             names, n);
+    }
+    free(names);
+
+    if (!same || x->count != y->count ||
+        a->next_scope_id != b->next_scope_id ||
+        a->next_storage_id != b->next_storage_id) {
+        return 0;
+    }
+
+    for (size_t t = 0; t < x->count; t++) {
+        const Scope *sx = timeline_scope(x, t);
+        const Scope *sy = timeline_scope(y, t);
+
+        if (timeline_kind(x, t) != timeline_kind(y, t) ||
+            node_of(timeline_origin(x, t)) != node_of(timeline_origin(y, t)) ||
+            timeline_info(x, t) != timeline_info(y, t) ||
+            (sx ? sx->id : 0) != (sy ? sy->id : 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorted ids of `d`; NULL if out of memory */
+static uint64_t *sorted_ids(const DiagnosticArtifact *d)
+{
+    uint64_t *ids = malloc((d->count ? d->count : 1) * sizeof(*ids));
+    if (!ids) {
+        return NULL;
+    }
+    for (size_t i = 0; i < d->count; i++) {
+        ids[i] = d->items[i].id.value;
+    }
+    qsort(ids, d->count, sizeof(*ids), cmp_u64);
+    return ids;
+}
+
+/* Ids of the sorted `ids` that `d` still reports */
+static size_t kept_ids(const uint64_t *ids, size_t n,
+                       const DiagnosticArtifact *d)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < d->count; i++) {
+        uint64_t id = d->items[i].id.value;
+        kept += bsearch(&id, ids, n, sizeof(*ids), cmp_u64) != NULL;
+    }
+    return kept;
+}
+
+static int same_diagnostics(const DiagnosticArtifact *a,
+                            const DiagnosticArtifact *b)
+{
+    if (a->count != b->count) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < a->count; i++) {
+        const Diagnostic *x = &a->items[i], *y = &b->items[i];
+
+        if (x->id.value != y->id.value || x->kind != y->kind ||
+            x->time != y->time || x->scope_id != y->scope_id ||
+            x->prev_scope != y->prev_scope ||
+            !x->anchor != !y->anchor) {
+            return 0;
+        }
+        if (x->anchor &&
+            (x->anchor->node_id != y->anchor->node_id ||
+             x->anchor->line != y->anchor->line ||
+             x->anchor->col != y->anchor->col)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Main
+ * ------------------------------------------------------------ */
+
+int main(void)
+{
+    Buf src = {0};
+    ASTProgram *full_ast = NULL;
+    ASTProgram *inc_ast = NULL;
+    Universe *u = universe_create();
+    Incremental *inc = incremental_create();
+    int ok = u && inc;
+
+    /* Initial analysis of the unedited program */
+    write_program(&src, EDIT_NONE);
+    inc_ast = c_parse_source_recycle("bench.c", src.data, src.len, inc_ast);
+    ok = ok && inc_ast && incremental_run(inc, inc_ast);
+
+    /* Ids before any edit */
+    size_t base_count = ok ? inc->diagnostics.count : 0;
+    uint64_t *base_ids = ok ? sorted_ids(&inc->diagnostics) : NULL;
+    ok = ok && base_ids && base_count > 0;
+
+    printf("== incremental: %d functions, %.1f KiB ==\n",
+           FUNCTIONS, (double)src.len / 1024.0);
+    printf("%-8s %12s %12s %12s %10s %10s  %s\n", "edit", "full us",
+           "incr us", "redone", "KiB/fn", "kept", "result");
+
+    for (Edit e = EDIT_NONE; ok && e <= EDIT_SWAP; e++) {
+        double full_ns = 0, inc_ns = 0;
+        int same = 1;
+
+        for (int r = 0; ok && r < ROUNDS; r++) {
+            /* Alternate so every round really is an edit */
+            write_program(&src, r % 2 ? EDIT_NONE : e);
+
+            /* Parsing is the same for both; only analysis is timed */
+            full_ast = c_parse_source_recycle("bench.c", src.data, src.len,
+                                              full_ast);
+            inc_ast = c_parse_source_recycle("bench.c", src.data, src.len,
+                                             inc_ast);
+            ok = full_ast && inc_ast;
+
+            double t0 = now_ns();
+            ok = ok && universe_reset(u) && executor_run(u, full_ast);
+            DiagnosticArtifact d = ok ? analyze_diagnostics(&u->timeline)
+                                      : (DiagnosticArtifact){0};
+            double t1 = now_ns();
+
+            ok = ok && incremental_run(inc, inc_ast);
+            double t2 = now_ns();
+
+            if (r % 2 == 0) {
+                full_ns += t1 - t0;
+                inc_ns  += t2 - t1;
+            }
+
+            same = same && ok && same_history(u, inc->universe, full_ast) &&
+                   same_diagnostics(&d, &inc->diagnostics);
+            diagnostic_artifact_free(&d);
+        }
+
+        /* The last round was an edit (ROUNDS is odd) */
+        int rounds = (ROUNDS + 1) / 2;
+        size_t kept = kept_ids(base_ids, base_count, &inc->diagnostics);
+        printf("%-8s %12.0f %12.0f %8zu/%-4zu %10.1f %5zu/%-4zu  %s\n",
+               EDIT_NAMES[e], full_ns / rounds / 1e3, inc_ns / rounds / 1e3,
+               inc->reanalyzed, inc->functions,
+               (double)inc->retained / 1024.0 / inc->functions,
+               kept, base_count,
+               !same ? "DIFFER" : kept != base_count ? "MOVED"
+                                                      : "identical");
+        ok = ok && same && kept == base_count;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "incremental_bench: FAILED\n");
+    }
+
+    free(base_ids);
+    incremental_destroy(inc);
+    universe_destroy(u);
+    ast_program_free(full_ast);
+    ast_program_free(inc_ast);
+    free(src.data);
+
+    return ok ? 0 : 1;
+}
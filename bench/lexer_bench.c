@@ -0,0 +1,224 @@
+/*
+ * lexer_bench
+ *
+ * Lexer throughput on a large synthetic translation unit:
+ *
+ *   legacy — the previous scanner (isspace per byte, strncmp per
+ *            keyword, NUL-terminated input)
+ *   table  — lexer_next on demand: class table, SSE2 run skipping
+ *            where available, perfect-hash keywords, line/column
+ *   stream — lexer_tokenize: the same scan into a TokenStream
+ *   parse  — c_parse_file_to_ast on the same file (tokenise once,
+ *            interning, AST construction)
+ *
+ * The legacy and on-demand scanners must produce the same tokens,
+ * and the token stream must match on-demand scanning including
+ * positions; the bench fails otherwise.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+
+#define TARGET_MIB 32
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Legacy scanner (replicated)
+ * ------------------------------------------------------------ */
+
+static Token legacy_next(const char *src, size_t len, size_t *pos)
+{
+    while (*pos < len && isspace((unsigned char)src[*pos])) {
+        (*pos)++;
+    }
+
+    if (*pos >= len) {
+        return (Token){ .kind = TOK_EOF };
+    }
+
+    const char *s = src + *pos;
+
+    if (strncmp(s, "int", 3) == 0 && !isalnum(s[3])) {
+        *pos += 3;
+        return (Token){ .kind = TOK_INT, .lexeme = s, .len = 3 };
+    }
+
+    if (strncmp(s, "return", 6) == 0 && !isalnum(s[6])) {
+        *pos += 6;
+        return (Token){ .kind = TOK_RETURN, .lexeme = s, .len = 6 };
+    }
+
+    if (isalpha((unsigned char)*s)) {
+        size_t i = 0;
+        while (isalnum((unsigned char)s[i])) i++;
+        *pos += i;
+        return (Token){ .kind = TOK_IDENT, .lexeme = s, .len = i };
+    }
+
+    if (isdigit((unsigned char)*s)) {
+        size_t i = 0;
+        while (isdigit((unsigned char)s[i])) i++;
+        *pos += i;
+        return (Token){ .kind = TOK_INT_LIT, .lexeme = s, .len = i };
+    }
+
+    (*pos)++;
+    switch (*s) {
+    case '(': return (Token){ .kind = TOK_LPAREN, .lexeme = s, .len = 1 };
+    case ')': return (Token){ .kind = TOK_RPAREN, .lexeme = s, .len = 1 };
+    case '{': return (Token){ .kind = TOK_LBRACE, .lexeme = s, .len = 1 };
+    case '}': return (Token){ .kind = TOK_RBRACE, .lexeme = s, .len = 1 };
+    case ';': return (Token){ .kind = TOK_SEMI,   .lexeme = s, .len = 1 };
+    default:  return (Token){ .kind = TOK_EOF };
+    }
+}
+
+/* ------------------------------------------------------------
+ * Input
+ * ------------------------------------------------------------ */
+
+/*
+ * Indented blocks of declarations, uses and returns, nested as a
+ * tree of at most 16 blocks per level.
+ */
+static size_t write_blocks(FILE *f, size_t leaves, int depth)
+{
+    size_t n = 0;
+    int ind = depth * 4;
+
+    if (leaves <= 1) {
+        n += (size_t)fprintf(f, "%*s{\n", ind, "");
+        for (int i = 0; i < 12; i++) {
+            n += (size_t)fprintf(f, "%*sint counter%dValue;\n",
+                                 ind + 4, "", i);
+            n += (size_t)fprintf(f, "%*scounter%dValue;\n", ind + 4, "", i);
+            n += (size_t)fprintf(f, "%*sx%d;\n", ind + 4, "", i);
+        }
+        n += (size_t)fprintf(f, "%*sreturn 12345;\n", ind + 4, "");
+        n += (size_t)fprintf(f, "%*s}\n", ind, "");
+        return n;
+    }
+
+    size_t per = (leaves + 15) / 16;
+    n += (size_t)fprintf(f, "%*s{\n", ind, "");
+    for (size_t done = 0; done < leaves; done += per) {
+        n += write_blocks(f, leaves - done < per ? leaves - done : per,
+                          depth + 1);
+    }
+    n += (size_t)fprintf(f, "%*s}\n", ind, "");
+    return n;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/liminal_lexer_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+
+    FILE *f = fdopen(fd, "w");
+    fprintf(f, "int main() {\n");
+    /* ~1.1 KiB per leaf block */
+    write_blocks(f, (size_t)TARGET_MIB * 1024 * 1024 / 1100, 1);
+    fprintf(f, "return 0;\n}\n");
+    fclose(f);
+
+    /* NUL-terminated copy for the legacy scanner */
+    char *buf = NULL;
+    size_t len = 0;
+    if (!read_entire_file(path, &buf, &len)) {
+        fprintf(stderr, "lexer_bench: read failed\n");
+        remove(path);
+        return 1;
+    }
+
+    double mib = (double)len / (1024.0 * 1024.0);
+
+    /* legacy */
+    size_t ltokens = 0;
+    size_t pos = 0;
+    double t0 = now_ns();
+    while (legacy_next(buf, len, &pos).kind != TOK_EOF) {
+        ltokens++;
+    }
+    double t1 = now_ns();
+
+    /* table */
+    size_t ttokens = 0;
+    Lexer lx;
+    lexer_init(&lx, path, buf, len);
+    double t2 = now_ns();
+    while (lexer_next(&lx).kind != TOK_EOF) {
+        ttokens++;
+    }
+    double t3 = now_ns();
+
+    /* stream */
+    Lexer sx;
+    lexer_init(&sx, path, buf, len);
+    double t6 = now_ns();
+    int tokenized = lexer_tokenize(&sx);
+    double t7 = now_ns();
+
+    /* same tokens, one by one */
+    int same = tokenized && ltokens == ttokens &&
+               sx.stream.count == ttokens + 1;
+    pos = 0;
+    lexer_init(&lx, path, buf, len);
+    while (same) {
+        Token a = legacy_next(buf, len, &pos);
+        Token b = lexer_next(&lx);
+        Token c = lexer_next(&sx);
+        if (a.kind != b.kind || a.len != b.len || a.lexeme != b.lexeme ||
+            b.kind != c.kind || b.lexeme != c.lexeme ||
+            b.line != c.line || b.col != c.col) {
+            same = 0;
+        }
+        if (a.kind == TOK_EOF) {
+            break;
+        }
+    }
+    size_t stream_bytes = sx.stream.count * sizeof(TokenRec);
+    lexer_free(&sx);
+
+    /* full parse */
+    double t4 = now_ns();
+    ASTProgram *p = c_parse_file_to_ast(path);
+    double t5 = now_ns();
+    remove(path);
+
+    printf("== lexer: %.1f MiB, %zu tokens (%s) ==\n", mib, ttokens,
+#if defined(__SSE2__) && !defined(LEXER_NO_SIMD)
+           "sse2"
+#else
+           "scalar"
+#endif
+    );
+    printf("%-7s %8.1f MB/s\n", "legacy", mib / ((t1 - t0) / 1e9));
+    printf("%-7s %8.1f MB/s\n", "table", mib / ((t3 - t2) / 1e9));
+    printf("%-7s %8.1f MB/s  (%zu KiB of token records)\n", "stream",
+           mib / ((t7 - t6) / 1e9), stream_bytes / 1024);
+    printf("%-7s %8.1f MB/s  (%s)\n", "parse", mib / ((t5 - t4) / 1e9),
+           p ? "ok" : "FAILED");
+    printf("tokens %s\n", same ? "identical" : "DIFFER");
+
+    ast_program_free(p);
+    free(buf);
+
+    return same && p ? 0 : 1;
+}
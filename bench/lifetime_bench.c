@@ -0,0 +1,190 @@
+/*
+ * lifetime_bench
+ *
+ * Use-after-scope and variable lifetime cost as the number of
+ * scopes grows:
+ *
+ *   scan    — the previous rules: every USE scans all scope
+ *             lifetimes, every EXIT scans all variables
+ *   indexed — analyze_step_use / lifetime_collect_variables
+ *             (dense scope-id index, per-scope open lists)
+ *
+ * The timeline is built through the Universe API: sibling scopes,
+ * each declaring and using a few variables. Results are compared
+ * and the bench fails if they differ.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "analyzer/analyzer.h"
+#include "executor/executor.h"
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Symbols as an InternTable would hand them out */
+enum { SYM_G = 1, SYM_A };
+
+static Universe *build(size_t scopes)
+{
+    Universe *u = universe_create();
+    universe_enter_scope(u, NULL);
+    universe_declare_variable(u, SYM_G, NULL);
+
+    for (size_t s = 0; s < scopes; s++) {
+        universe_enter_scope(u, NULL);
+        for (int i = 0; i < 4; i++) {
+            universe_declare_variable(u, SYM_A + i, NULL);
+        }
+        for (int i = 0; i < 8; i++) {
+            universe_use_variable(u, SYM_A + i % 4, NULL);
+        }
+        universe_use_variable(u, SYM_G, NULL);
+        universe_exit_scope(u, NULL);
+    }
+
+    universe_exit_scope(u, NULL);
+    return u;
+}
+
+/* ------------------------------------------------------------
+ * Previous scanning rules (replicated)
+ * ------------------------------------------------------------ */
+
+static size_t scan_variables(const Timeline *tl, VariableLifetime *out,
+                             size_t cap)
+{
+    size_t n = 0;
+    for (size_t t = 0; t < tl->count; t++) {
+        StepKind k = timeline_kind(tl, t);
+        if (k == STEP_DECLARE) {
+            if (n >= cap) break;
+            const Scope *sc = timeline_scope(tl, t);
+            out[n++] = (VariableLifetime){
+                .var_id       = timeline_info(tl, t),
+                .scope_id     = sc ? sc->id : 0,
+                .declare_time = t,
+                .end_time     = UINT64_MAX
+            };
+        }
+        if (k == STEP_EXIT_SCOPE) {
+            uint64_t sid = timeline_info(tl, t);
+            for (size_t i = 0; i < n; i++) {
+                if (out[i].scope_id == sid && out[i].end_time == UINT64_MAX) {
+                    out[i].end_time = t;
+                }
+            }
+        }
+    }
+    return n;
+}
+
+static size_t scan_uses(const Timeline *tl, const ScopeLifetime *lts,
+                        size_t nlt, UseReport *out, size_t cap)
+{
+    size_t count = 0;
+    for (size_t t = 0; t < tl->count; t++) {
+        if (timeline_kind(tl, t) != STEP_USE)
+            continue;
+        if (count >= cap)
+            break;
+
+        const Scope *sc = timeline_scope(tl, t);
+        UseReport r = {
+            .time = t,
+            .scope_id = sc ? sc->id : 0,
+            .storage_id = timeline_info(tl, t),
+            .kind = USE_OK
+        };
+
+        if (r.storage_id == UINT64_MAX) {
+            r.kind = USE_BEFORE_DECLARE;
+            out[count++] = r;
+            continue;
+        }
+
+        for (size_t i = 0; i < nlt; i++) {
+            if (lts[i].scope_id == r.scope_id &&
+                lts[i].exit_time != UINT64_MAX &&
+                r.time > lts[i].exit_time) {
+                r.kind = USE_AFTER_SCOPE;
+                out[count++] = r;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+static int same_uses(const UseReport *a, const UseReport *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (a[i].kind != b[i].kind || a[i].time != b[i].time ||
+            a[i].scope_id != b[i].scope_id ||
+            a[i].storage_id != b[i].storage_id) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int bench(size_t scopes)
+{
+    Universe *u = build(scopes);
+    const Timeline *tl = &u->timeline;
+    size_t n = tl->count;
+
+    ScopeLifetime *lts = malloc(n * sizeof(*lts));
+    size_t nlt = lifetime_collect_scopes(tl, lts, n);
+
+    VariableLifetime *v0 = malloc(n * sizeof(*v0));
+    VariableLifetime *v1 = malloc(n * sizeof(*v1));
+    UseReport *u0 = malloc(n * sizeof(*u0));
+    UseReport *u1 = malloc(n * sizeof(*u1));
+
+    double t0 = now_ns();
+    size_t nv0 = scan_variables(tl, v0, n);
+    size_t nu0 = scan_uses(tl, lts, nlt, u0, n);
+    double t1 = now_ns();
+    size_t nv1 = lifetime_collect_variables(tl, v1, n);
+    size_t nu1 = analyze_step_use(tl, lts, nlt, u1, n);
+    double t2 = now_ns();
+
+    int ok = nv0 == nv1 && nu0 == nu1 &&
+             memcmp(v0, v1, nv0 * sizeof(*v0)) == 0 &&
+             same_uses(u0, u1, nu0);
+
+    printf("%-7zu steps=%-8zu scan %10.1f us  indexed %8.1f us  %s\n",
+           scopes, n, (t1 - t0) / 1e3, (t2 - t1) / 1e3,
+           ok ? "identical" : "DIFFER");
+
+    free(lts);
+    free(v0);
+    free(v1);
+    free(u0);
+    free(u1);
+    universe_destroy(u);
+
+    return ok;
+}
+
+int main(void)
+{
+    printf("== lifetimes: use-after-scope + variable lifetimes ==\n");
+
+    int ok = 1;
+    size_t sizes[] = { 100, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        ok &= bench(sizes[i]);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/*
+ * ndjson_bench
+ *
+ * Artifact emission throughput, records per second:
+ *
+ *   fprintf — the previous emitters: one fprintf per record (two
+ *             for anchored diagnostics) straight into stdio
+ *   writer  — diagnostic_project_ndjson / timeline_emit_ndjson
+ *             through the buffered JsonWriter
+ *
+ * Output goes to /dev/null for timing. Both are also written to
+ * memory once and compared; the bench fails unless they are byte
+ * for byte the same.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+#include "analyzer/analyzer.h"
+#include "consumers/consumers.h"
+
+#define DIAGNOSTICS 1000000
+#define STEPS       2000000
+#define NODES       65536
+#define ROUNDS      3
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Previous emitters
+ * ------------------------------------------------------------ */
+
+static void diagnostics_fprintf(const DiagnosticArtifact *a, FILE *out)
+{
+    for (size_t i = 0; i < a->count; i++) {
+        const Diagnostic *d = &a->items[i];
+
+        fprintf(out,
+                "{\"id\":\"%016llx\",\"time\":%llu,\"kind\":\"%s\","
+                "\"scope\":%llu,\"prev_scope\":%llu",
+                (unsigned long long)d->id.value,
+                (unsigned long long)d->time,
+                diagnostic_kind_name(d->kind),
+                (unsigned long long)d->scope_id,
+                (unsigned long long)d->prev_scope);
+
+        if (d->anchor) {
+            fprintf(out, ",\"anchor\":{\"node\":%u,\"line\":%u,\"col\":%u}",
+                    d->anchor->node_id, d->anchor->line, d->anchor->col);
+        }
+
+        fprintf(out, "}\n");
+    }
+}
+
+static void timeline_fprintf(const Timeline *tl, FILE *out)
+{
+    for (size_t t = 0; t < tl->count; t++) {
+        const ASTNode *n = timeline_origin(tl, t);
+
+        fprintf(out, "{\"v\":1,\"t\":%llu,\"step\":\"%s\",\"ast\":%u}\n",
+                (unsigned long long)t,
+                step_kind_name(timeline_kind(tl, t)),
+                n ? n->id : 0);
+    }
+}
+
+/* ------------------------------------------------------------
+ * Harness
+ * ------------------------------------------------------------ */
+
+typedef void (*EmitFn)(const void *input, FILE *out);
+
+static void emit_diag_old(const void *in, FILE *out)
+{
+    diagnostics_fprintf(in, out);
+}
+
+static void emit_diag_new(const void *in, FILE *out)
+{
+    diagnostic_project_ndjson(in, out);
+}
+
+static void emit_tl_old(const void *in, FILE *out)
+{
+    timeline_fprintf(in, out);
+}
+
+static void emit_tl_new(const void *in, FILE *out)
+{
+    timeline_emit_ndjson(in, out);
+}
+
+static double time_emit(EmitFn fn, const void *in, FILE *sink)
+{
+    double best = 0;
+    for (int r = 0; r < ROUNDS; r++) {
+        double t0 = now_ns();
+        fn(in, sink);
+        fflush(sink);
+        double dt = now_ns() - t0;
+        if (r == 0 || dt < best) best = dt;
+    }
+    return best;
+}
+
+static int same_bytes(EmitFn a, EmitFn b, const void *in)
+{
+    char *pa = NULL, *pb = NULL;
+    size_t la = 0, lb = 0;
+    FILE *fa = open_memstream(&pa, &la);
+    FILE *fb = open_memstream(&pb, &lb);
+    int ok = fa && fb;
+
+    if (ok) {
+        a(in, fa);
+        b(in, fb);
+    }
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+
+    ok = ok && la == lb && memcmp(pa, pb, la) == 0;
+    free(pa);
+    free(pb);
+    return ok;
+}
+
+static int report(const char *what, size_t records, EmitFn old_fn,
+                  EmitFn new_fn, const void *in, FILE *sink)
+{
+    double old_ns = time_emit(old_fn, in, sink);
+    double new_ns = time_emit(new_fn, in, sink);
+    int same = same_bytes(old_fn, new_fn, in);
+
+    printf("%-12s %-8s %12.0f rec/s\n", what, "fprintf",
+           records / (old_ns / 1e9));
+    printf("%-12s %-8s %12.0f rec/s  %.1fx  %s\n", what, "writer",
+           records / (new_ns / 1e9), old_ns / new_ns,
+           same ? "identical" : "DIFFER");
+    return same;
+}
+
+int main(void)
+{
+    FILE *sink = fopen("/dev/null", "w");
+    Diagnostic *items = calloc(DIAGNOSTICS, sizeof(Diagnostic));
+    SourceAnchor *anchors = calloc(DIAGNOSTICS, sizeof(SourceAnchor));
+    ASTNode *nodes = calloc(NODES, sizeof(ASTNode));
+    Timeline tl;
+    timeline_init(&tl);
+
+    if (!sink || !items || !anchors || !nodes) {
+        fprintf(stderr, "ndjson_bench: setup failed\n");
+        return 1;
+    }
+
+    /* Diagnostics: every kind, most anchored, wide value ranges */
+    for (size_t i = 0; i < DIAGNOSTICS; i++) {
+        Diagnostic *d = &items[i];
+        d->id.value   = (uint64_t)i * 0x9e3779b97f4a7c15ull;
+        d->kind       = (DiagnosticKind)(i % DIAG_KIND_MAX);
+        d->time       = i * 7;
+        d->scope_id   = i % 97;
+        d->prev_scope = i % 3 ? 0 : i % 89;
+        if (i % 4) {
+            anchors[i] = (SourceAnchor){
+                .node_id = (uint32_t)(i % 100000),
+                .line    = (uint32_t)(i % 5000) + 1,
+                .col     = (uint32_t)(i % 80) + 1
+            };
+            d->anchor = &anchors[i];
+        }
+    }
+    DiagnosticArtifact diags = { .items = items, .count = DIAGNOSTICS };
+
+    /* Timeline: step mix of a real run */
+    for (uint32_t i = 0; i < NODES; i++) {
+        nodes[i].id = i;
+    }
+    for (size_t t = 0; t < STEPS; t++) {
+        StepKind k = t ? (StepKind)(STEP_ENTER_SCOPE + t % 4) : STEP_UNKNOWN;
+        timeline_append(&tl, k, t ? &nodes[t % NODES] : NULL, t, NULL);
+    }
+
+    printf("== ndjson emission (best of %d) ==\n", ROUNDS);
+    int ok = report("diagnostics", DIAGNOSTICS, emit_diag_old, emit_diag_new,
+                    &diags, sink);
+    ok = report("timeline", STEPS, emit_tl_old, emit_tl_new, &tl, sink) && ok;
+
+    timeline_free(&tl);
+    free(nodes);
+    free(anchors);
+    free(items);
+    fclose(sink);
+
+    if (!ok) {
+        fprintf(stderr, "ndjson_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+/*
+ * ndjson_read_bench
+ *
+ * Reading artifacts back, records per second:
+ *
+ *   stream — diagnostic_read_ndjson / timeline_read_ndjson with a
+ *            counting callback (constant memory)
+ *   load   — load_diagnostics / load_timeline into arrays
+ *
+ * Input is written by the real emitters. The stream phase runs
+ * first and reports how much the peak RSS grew while it ran; the
+ * bench fails unless every loaded record equals the one written,
+ * anchors included.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+#include "analyzer/analyzer.h"
+#include "consumers/consumers.h"
+
+#define DIAGNOSTICS 1000000
+#define STEPS       2000000
+#define NODES       65536
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static long peak_rss_kib(void)
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+static int count_diag(const Diagnostic *d, void *ctx)
+{
+    (void)d;
+    ++*(size_t *)ctx;
+    return 1;
+}
+
+static int count_event(const TimelineEvent *e, void *ctx)
+{
+    (void)e;
+    ++*(size_t *)ctx;
+    return 1;
+}
+
+static int same_diagnostic(const Diagnostic *a, const Diagnostic *b)
+{
+    if (a->id.value != b->id.value || a->kind != b->kind ||
+        a->time != b->time || a->scope_id != b->scope_id ||
+        a->prev_scope != b->prev_scope || !a->anchor != !b->anchor) {
+        return 0;
+    }
+    return !a->anchor ||
+           (a->anchor->node_id == b->anchor->node_id &&
+            a->anchor->line == b->anchor->line &&
+            a->anchor->col == b->anchor->col);
+}
+
+int main(void)
+{
+    const char *dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char dpath[512], tpath[512];
+    snprintf(dpath, sizeof(dpath), "%s/ndread.%ld.diag", dir, (long)getpid());
+    snprintf(tpath, sizeof(tpath), "%s/ndread.%ld.tl", dir, (long)getpid());
+
+    Diagnostic *items = calloc(DIAGNOSTICS, sizeof(Diagnostic));
+    SourceAnchor *anchors = calloc(DIAGNOSTICS, sizeof(SourceAnchor));
+    ASTNode *nodes = calloc(NODES, sizeof(ASTNode));
+    Timeline tl;
+    timeline_init(&tl);
+    if (!items || !anchors || !nodes) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < DIAGNOSTICS; i++) {
+        Diagnostic *d = &items[i];
+        d->id.value   = (uint64_t)i * 0x9e3779b97f4a7c15ull;
+        d->kind       = (DiagnosticKind)(i % DIAG_KIND_MAX);
+        d->time       = i * 7;
+        d->scope_id   = i % 97;
+        d->prev_scope = i % 3 ? 0 : i % 89;
+        if (i % 4) {
+            anchors[i] = (SourceAnchor){
+                .node_id = (uint32_t)(i % 100000),
+                .line    = (uint32_t)(i % 5000) + 1,
+                .col     = (uint32_t)(i % 80) + 1
+            };
+            d->anchor = &anchors[i];
+        }
+    }
+    DiagnosticArtifact diags = { .items = items, .count = DIAGNOSTICS };
+
+    for (uint32_t i = 0; i < NODES; i++) {
+        nodes[i].id = i;
+    }
+    for (size_t t = 0; t < STEPS; t++) {
+        StepKind k = t ? (StepKind)(STEP_ENTER_SCOPE + t % 4) : STEP_UNKNOWN;
+        timeline_append(&tl, k, t ? &nodes[t % NODES] : NULL, t, NULL);
+    }
+
+    FILE *f = fopen(dpath, "w");
+    FILE *g = fopen(tpath, "w");
+    if (!f || !g) {
+        return 1;
+    }
+    diagnostic_project_ndjson(&diags, f);
+    timeline_emit_ndjson(&tl, g);
+    fclose(f);
+    fclose(g);
+
+    int ok = 1;
+    printf("== ndjson reading ==\n");
+
+    /* ---- STREAM ---- */
+    long rss0 = peak_rss_kib();
+    size_t nd = 0, nt = 0;
+
+    double t0 = now_ns();
+    f = fopen(dpath, "r");
+    ok = ok && f && diagnostic_read_ndjson(f, count_diag, &nd, NULL) == 0;
+    if (f) fclose(f);
+    double t1 = now_ns();
+    g = fopen(tpath, "r");
+    ok = ok && g && timeline_read_ndjson(g, count_event, &nt, NULL) == 0;
+    if (g) fclose(g);
+    double t2 = now_ns();
+
+    long grew = peak_rss_kib() - rss0;
+    ok = ok && nd == DIAGNOSTICS && nt == STEPS;
+
+    printf("%-12s %-7s %12.0f rec/s\n", "diagnostics", "stream",
+           nd / ((t1 - t0) / 1e9));
+    printf("%-12s %-7s %12.0f rec/s\n", "timeline", "stream",
+           nt / ((t2 - t1) / 1e9));
+    printf("stream peak RSS growth: %ld KiB\n", grew);
+
+    /* ---- LOAD ---- */
+    DiagnosticArtifact loaded = {0};
+    TimelineEvent *events = NULL;
+    size_t event_count = 0;
+
+    t0 = now_ns();
+    ok = load_diagnostics(dpath, &loaded) == 0 && ok;
+    t1 = now_ns();
+    ok = load_timeline(tpath, &events, &event_count) == 0 && ok;
+    t2 = now_ns();
+
+    printf("%-12s %-7s %12.0f rec/s\n", "diagnostics", "load",
+           loaded.count / ((t1 - t0) / 1e9));
+    printf("%-12s %-7s %12.0f rec/s\n", "timeline", "load",
+           event_count / ((t2 - t1) / 1e9));
+
+    ok = ok && loaded.count == DIAGNOSTICS && event_count == STEPS;
+    for (size_t i = 0; ok && i < loaded.count; i++) {
+        ok = same_diagnostic(&loaded.items[i], &items[i]);
+    }
+    for (size_t t = 0; ok && t < event_count; t++) {
+        const ASTNode *n = timeline_origin(&tl, t);
+        ok = events[t].time == t &&
+             events[t].step_kind == timeline_kind(&tl, t) &&
+             events[t].ast_id == (n ? n->id : 0);
+    }
+
+    diagnostic_artifact_free(&loaded);
+    free(events);
+    remove(dpath);
+    remove(tpath);
+    timeline_free(&tl);
+    free(nodes);
+    free(anchors);
+    free(items);
+
+    if (!ok) {
+        fprintf(stderr, "ndjson_read_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
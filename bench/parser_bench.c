@@ -0,0 +1,123 @@
+/*
+ * parser_bench
+ *
+ * Parsing very large blocks:
+ *
+ *   flat   — main() holding N statements directly
+ *   nested — one inner block holding N statements, followed by
+ *            N single-statement blocks
+ *
+ * Every block's statement list is built on the parser's shared
+ * scratch stack and copied into the AST once, so ns/node should
+ * stay flat as N grows. The widest block must hold every statement.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void write_stmts(FILE *f, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        switch (i % 3) {
+        case 0:  fprintf(f, "int v%zu;\n", i % 1000); break;
+        case 1:  fprintf(f, "v%zu;\n", i % 1000);     break;
+        default: fprintf(f, "w%zu;\n", i % 1000);     break;
+        }
+    }
+}
+
+/* Statements in the block with the most of them */
+static size_t widest_block(const ASTProgram *p)
+{
+    size_t widest = 0;
+    for (size_t i = 1; i <= p->count; i++) {
+        const ASTNode *n = ast_node_get(p, (uint32_t)i);
+        if (n->kind == AST_BLOCK && n->as.block.stmt_count > widest) {
+            widest = n->as.block.stmt_count;
+        }
+    }
+    return widest;
+}
+
+static int bench(const char *label, size_t n, int nested)
+{
+    char path[] = "/tmp/liminal_parser_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 0;
+    }
+
+    FILE *f = fdopen(fd, "w");
+    fprintf(f, "int main() {\n");
+    if (nested) {
+        fprintf(f, "{\n");
+        write_stmts(f, n);
+        fprintf(f, "}\n");
+        for (size_t i = 0; i < n; i++) {
+            fprintf(f, "{ x; }\n");
+        }
+    } else {
+        write_stmts(f, n);
+    }
+    fprintf(f, "return 0;\n}\n");
+    fclose(f);
+
+    double t0 = now_ns();
+    ASTProgram *p = c_parse_file_to_ast(path);
+    double t1 = now_ns();
+    remove(path);
+
+    if (!p) {
+        fprintf(stderr, "parser_bench: parse failed\n");
+        return 0;
+    }
+
+    /* main's body: the N statements or blocks, plus the return */
+    size_t widest = widest_block(p);
+    size_t expect = nested ? n + 2 : n + 1;
+    size_t nodes = p->count;
+
+    printf("%-7s N=%-8zu widest=%-8zu parse %8.2f ms  %6.1f ns/node\n",
+           label, n, widest, (t1 - t0) / 1e6, (t1 - t0) / nodes);
+
+    ast_program_free(p);
+
+    if (widest != expect) {
+        fprintf(stderr, "parser_bench: expected %zu statements, got %zu\n",
+                expect, widest);
+        return 0;
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("== parser: statements per block ==\n");
+
+    size_t sizes[] = { 1000, 10000, 100000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (!bench("flat", sizes[i], 0)) {
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (!bench("nested", sizes[i], 1)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
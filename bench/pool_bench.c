@@ -0,0 +1,96 @@
+/*
+ * pool_bench
+ *
+ * Skewed workloads on the work-stealing pool:
+ *
+ *   serial — every item on the calling thread
+ *   pool   — pool_run with one worker per CPU (at least 4, so
+ *            stealing is exercised even on small machines)
+ *
+ * Item cost follows the shape of a real tree: most files are tiny,
+ * a few are huge, and the huge ones are clustered together (as in
+ * a generated/ directory), which is the case a static split
+ * handles worst. Every item must run exactly once.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/common.h"
+
+#define ITEMS 4096
+
+typedef struct {
+    unsigned *runs;         /* per item, written by its one worker */
+    const unsigned *cost;
+    volatile unsigned long sink[256];
+} Work;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void work_item(void *ctx, unsigned worker, size_t item)
+{
+    Work *w = ctx;
+    unsigned long x = item;
+
+    for (unsigned i = 0; i < w->cost[item]; i++) {
+        x = x * 6364136223846793005UL + 1442695040888963407UL;
+    }
+
+    w->sink[worker % 256] += x;
+    w->runs[item]++;
+}
+
+static int check(const Work *w)
+{
+    for (size_t i = 0; i < ITEMS; i++) {
+        if (w->runs[i] != 1) {
+            fprintf(stderr, "pool_bench: item %zu ran %u times\n",
+                    i, w->runs[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    unsigned cost[ITEMS];
+    unsigned runs[ITEMS];
+    unsigned long total = 0;
+
+    for (size_t i = 0; i < ITEMS; i++) {
+        cost[i] = (i >= ITEMS / 8 && i < ITEMS / 8 + 64) ? 400000 : 2000;
+        total += cost[i];
+    }
+
+    unsigned cpus = pool_cpu_count();
+    Work w = { .runs = runs, .cost = cost };
+
+    printf("== pool: %d items, %lu steps, %u cpus ==\n", ITEMS, total, cpus);
+
+    for (size_t i = 0; i < ITEMS; i++) runs[i] = 0;
+    double t0 = now_ns();
+    pool_run(ITEMS, 1, work_item, &w);
+    double t1 = now_ns();
+    if (!check(&w)) return 1;
+
+    for (size_t i = 0; i < ITEMS; i++) runs[i] = 0;
+    double t2 = now_ns();
+    unsigned ran = pool_run(ITEMS, cpus < 4 ? 4 : cpus, work_item, &w);
+    double t3 = now_ns();
+    if (!check(&w)) return 1;
+
+    printf("%-7s %8.2f ms\n", "serial", (t1 - t0) / 1e6);
+    printf("%-7s %8.2f ms  (%u workers, %.2fx)\n", "pool",
+           (t3 - t2) / 1e6, ran, (t1 - t0) / (t3 - t2));
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ * root_chain_bench
+ *
+ * Root chains and root causes for every diagnostic of a run:
+ *
+ *   copy    — the previous build_root_chain: each chain copies
+ *             every step up to its diagnostic into the arena and
+ *             assigns roles (O(diagnostics × timeline)); only run
+ *             up to COPY_MAX steps
+ *   indexed — causal_index_build once, then build_root_chain and
+ *             root_cause_extract per diagnostic in O(1)
+ *
+ * Wherever the copy runs, the bench fails unless every node of
+ * every chain reads the same through root_chain_node; the root
+ * cause of every diagnostic is checked against the previous
+ * backward walk at all sizes.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+#include "analyzer/analyzer.h"
+#include "consumers/consumers.h"
+#include "consumers/root/chain/build.h"
+#include "consumers/root/chain/role.h"
+
+#define COPY_MAX 100000
+#define NODES    4096
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+/* ------------------------------------------------------------
+ * Previous implementation
+ * ------------------------------------------------------------ */
+
+static RootChainNode *chain_copy(Arena *arena, const Timeline *tl,
+                                 const Diagnostic *diag, size_t *count)
+{
+    *count = 0;
+    if (tl->count == 0)
+        return NULL;
+
+    size_t last = diag->time < tl->count ? (size_t)diag->time
+                                         : tl->count - 1;
+    RootChainNode *nodes = arena_alloc(arena, (last + 1) * sizeof(*nodes));
+    if (!nodes)
+        return NULL;
+
+    size_t i = 0;
+    for (size_t t = last + 1; t-- > 0; ) {
+        StepKind kind = timeline_kind(tl, t);
+        const ASTNode *ast = timeline_origin(tl, t);
+        RootChainNode *n = &nodes[i];
+
+        n->time = t;
+        n->step = kind;
+        n->ast_id = ast ? ast->id : 0;
+        n->scope_id = kind == STEP_ENTER_SCOPE || kind == STEP_EXIT_SCOPE
+                    ? timeline_info(tl, t)
+                    : diag->scope_id;
+        n->role = root_chain_role(diag->kind, i, kind);
+        i++;
+    }
+
+    *count = i;
+    return nodes;
+}
+
+static RootCause cause_walk(const Timeline *tl, const Diagnostic *d)
+{
+    size_t t = d->time < tl->count ? (size_t)d->time : 0;
+
+    while (t > 0) {
+        t--;
+
+        StepKind kind = timeline_kind(tl, t);
+        const ASTNode *n = timeline_origin(tl, t);
+        uint64_t ast_id = n ? n->id : 0;
+
+        if ((d->kind == DIAG_REDECLARATION || d->kind == DIAG_SHADOWING) &&
+            kind == STEP_DECLARE) {
+            return (RootCause){ ROOT_CAUSE_DECLARATION, t, ast_id,
+                                d->scope_id };
+        }
+        if (d->kind == DIAG_USE_BEFORE_DECLARE && kind == STEP_USE) {
+            return (RootCause){ ROOT_CAUSE_USE, t, ast_id, d->scope_id };
+        }
+        if (kind == STEP_ENTER_SCOPE || kind == STEP_EXIT_SCOPE) {
+            return (RootCause){
+                kind == STEP_ENTER_SCOPE ? ROOT_CAUSE_SCOPE_ENTRY
+                                         : ROOT_CAUSE_SCOPE_EXIT,
+                t, ast_id, timeline_info(tl, t)
+            };
+        }
+    }
+
+    return (RootCause){ ROOT_CAUSE_UNKNOWN, d->time, 0, d->scope_id };
+}
+
+/* ------------------------------------------------------------
+ * Input
+ * ------------------------------------------------------------ */
+
+/* Nested blocks of declarations and uses, a scope step in ~1/40 */
+static void make_timeline(Timeline *tl, ASTNode *nodes, size_t steps)
+{
+    uint64_t storages = 0, scopes = 0;
+    size_t depth = 0;
+
+    timeline_append(tl, STEP_UNKNOWN, NULL, 0, NULL);
+    while (tl->count < steps) {
+        uint32_t r = rng() % 40;
+        ASTNode *origin = &nodes[rng() % NODES];
+
+        if (r == 0 || (r == 1 && depth == 0)) {
+            timeline_append(tl, STEP_ENTER_SCOPE, origin, ++scopes, NULL);
+            depth++;
+        } else if (r == 1) {
+            timeline_append(tl, STEP_EXIT_SCOPE, origin, scopes - depth + 1,
+                            NULL);
+            depth--;
+        } else if (r < 12) {
+            timeline_append(tl, STEP_DECLARE, origin, ++storages, NULL);
+        } else if (r < 36) {
+            uint64_t st = storages && rng() % 8 ? 1 + rng() % storages
+                                                : UINT64_MAX;
+            timeline_append(tl, STEP_USE, origin, st, NULL);
+        } else {
+            timeline_append(tl, STEP_RETURN, origin, 0, NULL);
+        }
+    }
+}
+
+static void make_diagnostics(DiagnosticArtifact *a, size_t n, size_t steps)
+{
+    a->items = calloc(n, sizeof(Diagnostic));
+    a->count = n;
+
+    for (size_t i = 0; i < n; i++) {
+        Diagnostic *d = &a->items[i];
+        d->id.value = hash64(&i, sizeof(i), 3);
+        d->kind = (DiagnosticKind)(rng() % DIAG_KIND_MAX);
+        /* A few past the end, as a truncated timeline would have */
+        d->time = rng() % (steps + steps / 50);
+        d->scope_id = rng() % 100;
+    }
+}
+
+static int same_node(const RootChainNode *a, const RootChainNode *b)
+{
+    return a->time == b->time && a->step == b->step &&
+           a->ast_id == b->ast_id && a->scope_id == b->scope_id &&
+           a->role == b->role;
+}
+
+static int same_cause(const RootCause *a, const RootCause *b)
+{
+    return a->kind == b->kind && a->time == b->time &&
+           a->ast_id == b->ast_id && a->scope_id == b->scope_id;
+}
+
+int main(void)
+{
+    static const size_t sizes[][2] = {
+        { 20000,   500   },
+        { 100000,  2000  },
+        { 1000000, 20000 },
+        { 4000000, 50000 },
+    };
+    ASTNode *nodes = calloc(NODES, sizeof(ASTNode));
+    int ok = nodes != NULL;
+
+    for (uint32_t i = 0; ok && i < NODES; i++) {
+        nodes[i].id = i + 1;
+    }
+
+    printf("== root chains ==\n");
+    printf("%-8s %-7s %12s %12s %12s  %s\n",
+           "steps", "diags", "copy ms", "index ms", "chains ms", "result");
+
+    for (size_t s = 0; ok && s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t steps = sizes[s][0], n = sizes[s][1];
+        Timeline tl;
+        DiagnosticArtifact diags;
+
+        timeline_init(&tl);
+        make_timeline(&tl, nodes, steps);
+        make_diagnostics(&diags, n, steps);
+
+        RootChain *chains = malloc(n * sizeof(*chains));
+        RootCause *causes = malloc(n * sizeof(*causes));
+        Arena arena;
+        arena_init(&arena, 1 << 20);
+        CausalIndex ix;
+
+        ok = chains && causes && diags.items;
+
+        double t0 = now_ns();
+        ok = ok && causal_index_build(&arena, &tl, &ix) == 0;
+        double t1 = now_ns();
+        for (size_t i = 0; ok && i < n; i++) {
+            chains[i] = build_root_chain(&ix, &diags.items[i]);
+            causes[i] = root_cause_extract(&ix, &diags.items[i]);
+        }
+        double t2 = now_ns();
+
+        for (size_t i = 0; ok && i < n; i++) {
+            RootCause want = cause_walk(&tl, &diags.items[i]);
+            ok = same_cause(&want, &causes[i]);
+        }
+
+        char copy[32] = "-";
+        const char *result = ok ? "ok" : "WRONG";
+        if (ok && steps <= COPY_MAX) {
+            Arena old;
+            arena_init(&old, 1 << 20);
+            RootChainNode **copied = malloc(n * sizeof(*copied));
+            size_t *counts = malloc(n * sizeof(*counts));
+            ok = copied && counts;
+
+            double t3 = now_ns();
+            for (size_t i = 0; ok && i < n; i++) {
+                copied[i] = chain_copy(&old, &tl, &diags.items[i], &counts[i]);
+            }
+            double t4 = now_ns();
+            snprintf(copy, sizeof(copy), "%.2f", (t4 - t3) / 1e6);
+
+            for (size_t i = 0; ok && i < n; i++) {
+                ok = counts[i] == chains[i].count;
+                for (size_t k = 0; ok && k < counts[i]; k++) {
+                    RootChainNode got = root_chain_node(&chains[i], k);
+                    ok = same_node(&copied[i][k], &got);
+                }
+            }
+            result = ok ? "identical" : "DIFFER";
+
+            free(copied);
+            free(counts);
+            arena_destroy(&old);
+        }
+
+        printf("%-8zu %-7zu %12s %12.2f %12.2f  %s\n", steps, n, copy,
+               (t1 - t0) / 1e6, (t2 - t1) / 1e6, result);
+
+        arena_destroy(&arena);
+        free(chains);
+        free(causes);
+        free(diags.items);
+        timeline_free(&tl);
+    }
+
+    free(nodes);
+
+    if (!ok) {
+        fprintf(stderr, "root_chain_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+/*
+ * scope_align_bench
+ *
+ * Scope graphs of two runs, extracted and aligned:
+ *
+ *   old — the previous code: backward scan for the open node on
+ *         every exit (into a buffer sized up front, since the
+ *         real one held 128 nodes) and a nested-loop alignment
+ *         recomputing signatures per pair; only run up to
+ *         OLD_MAX scopes
+ *   new — scope_graph_extract (growable, stack of open scopes)
+ *         and scope_align (signatures once, sorted lookups)
+ *
+ * The new run has one step inserted halfway, so the later half
+ * of its scopes change signature. Wherever the old code runs,
+ * the bench fails unless graphs and alignments are identical.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+#include "consumers/consumers.h"
+#include "consumers/scope/scope.h"
+
+#define OLD_MAX 20000
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------
+ * Previous implementation
+ * ------------------------------------------------------------ */
+
+static ScopeGraph extract_old(const Timeline *tl, size_t max_nodes)
+{
+    ScopeNode *buf = calloc(max_nodes ? max_nodes : 1, sizeof(ScopeNode));
+    size_t count = 0;
+
+    for (size_t t = 0; buf && t < tl->count; t++) {
+        StepKind kind = timeline_kind(tl, t);
+
+        if (kind == STEP_ENTER_SCOPE) {
+            const Scope *parent = t ? timeline_scope(tl, t - 1) : NULL;
+            ScopeNode *n = &buf[count++];
+            n->scope_id   = timeline_info(tl, t);
+            n->parent_id  = parent ? parent->id : 0;
+            n->enter_time = t;
+            n->exit_time  = UINT64_MAX;
+        }
+
+        if (kind == STEP_EXIT_SCOPE) {
+            uint64_t sid = timeline_info(tl, t);
+            for (size_t i = count; i > 0; i--) {
+                if (buf[i - 1].scope_id == sid &&
+                    buf[i - 1].exit_time == UINT64_MAX) {
+                    buf[i - 1].exit_time = t;
+                    break;
+                }
+            }
+        }
+    }
+
+    return (ScopeGraph){ .nodes = buf, .count = count };
+}
+
+static size_t align_old(const ScopeGraph *a, const ScopeGraph *b,
+                        ScopeAlignment *out, size_t cap)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < a->count && count < cap; i++) {
+        uint64_t sig_a = scope_signature(&a->nodes[i]);
+        int found = 0;
+        for (size_t j = 0; j < b->count; j++) {
+            if (sig_a == scope_signature(&b->nodes[j])) {
+                found = 1;
+                break;
+            }
+        }
+        out[count++] = (ScopeAlignment){
+            .old_sig = sig_a,
+            .new_sig = found ? sig_a : 0,
+            .kind = found ? SCOPE_UNCHANGED : SCOPE_REMOVED
+        };
+    }
+
+    for (size_t j = 0; j < b->count && count < cap; j++) {
+        uint64_t sig_b = scope_signature(&b->nodes[j]);
+        int found = 0;
+        for (size_t i = 0; i < a->count; i++) {
+            if (sig_b == scope_signature(&a->nodes[i])) {
+                found = 1;
+                break;
+            }
+        }
+        if (!found) {
+            out[count++] = (ScopeAlignment){
+                .new_sig = sig_b,
+                .kind = SCOPE_ADDED
+            };
+        }
+    }
+
+    return count;
+}
+
+/* ------------------------------------------------------------
+ * Input
+ * ------------------------------------------------------------ */
+
+static uint64_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+/*
+ * `scopes` blocks, nested up to 32 deep with a few steps between
+ * scope changes; one extra step at `extra_at` (if reached). The
+ * same seed gives the same program.
+ */
+static void make_timeline(Timeline *tl, Scope *frames, size_t scopes,
+                          size_t extra_at)
+{
+    Scope *stack[33];
+    size_t depth = 0, made = 0;
+
+    rng_state = 0x853c49e6748fea9bull;
+    timeline_init(tl);
+    timeline_append(tl, STEP_UNKNOWN, NULL, 0, NULL);
+
+    while (made < scopes || depth > 0) {
+        Scope *active = depth ? stack[depth - 1] : NULL;
+
+        if (tl->count == extra_at) {
+            timeline_append(tl, STEP_DECLARE, NULL, 0, active);
+        }
+
+        uint32_t r = rng() % 8;
+        if (made < scopes && depth < 32 && (r < 3 || depth == 0)) {
+            Scope *s = &frames[made++];
+            s->id = made;
+            stack[depth++] = s;
+            timeline_append(tl, STEP_ENTER_SCOPE, NULL, s->id, s);
+        } else if (depth > 0 && (r < 6 || made == scopes)) {
+            Scope *s = stack[--depth];
+            timeline_append(tl, STEP_EXIT_SCOPE, NULL, s->id,
+                            depth ? stack[depth - 1] : NULL);
+        } else {
+            timeline_append(tl, STEP_USE, NULL, 0, active);
+        }
+    }
+}
+
+static int same_graph(const ScopeGraph *a, const ScopeGraph *b)
+{
+    if (a->count != b->count) {
+        return 0;
+    }
+    for (size_t i = 0; i < a->count; i++) {
+        const ScopeNode *x = &a->nodes[i], *y = &b->nodes[i];
+        if (x->scope_id != y->scope_id || x->parent_id != y->parent_id ||
+            x->enter_time != y->enter_time || x->exit_time != y->exit_time) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    size_t sizes[] = { 1000, 5000, 20000, 100000, 1000000 };
+    int ok = 1;
+
+    printf("== scope alignment ==\n");
+    printf("%-8s %12s %12s %12s %12s %9s  %s\n", "scopes", "old ext ms",
+           "old align ms", "extract ms", "align ms", "unchanged", "result");
+
+    for (size_t s = 0; ok && s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        Scope *frames_a = calloc(n, sizeof(Scope));
+        Scope *frames_b = calloc(n, sizeof(Scope));
+        ScopeAlignment *x = malloc(2 * n * sizeof(*x));
+        ScopeAlignment *y = malloc(2 * n * sizeof(*y));
+        Timeline ta, tb;
+
+        if (!frames_a || !frames_b || !x || !y) {
+            fprintf(stderr, "scope_align_bench: out of memory\n");
+            return 1;
+        }
+
+        make_timeline(&ta, frames_a, n, (size_t)-1);
+        make_timeline(&tb, frames_b, n, ta.count / 2);
+
+        double t0 = now_ns();
+        ScopeGraph ga = scope_graph_extract(&ta);
+        ScopeGraph gb = scope_graph_extract(&tb);
+        double t1 = now_ns();
+        size_t ny = scope_align(&ga, &gb, y, 2 * n);
+        double t2 = now_ns();
+
+        size_t unchanged = 0;
+        for (size_t i = 0; i < ny; i++) {
+            unchanged += y[i].kind == SCOPE_UNCHANGED;
+        }
+        ok = ga.count == n && gb.count == n && ny > n &&
+             unchanged > 0 && unchanged < n;
+
+        char old_ext[32] = "-", old_align[32] = "-";
+        const char *result = ok ? "ok" : "WRONG";
+        if (ok && n <= OLD_MAX) {
+            double t3 = now_ns();
+            ScopeGraph oa = extract_old(&ta, n);
+            ScopeGraph ob = extract_old(&tb, n);
+            double t4 = now_ns();
+            size_t nx = align_old(&oa, &ob, x, 2 * n);
+            double t5 = now_ns();
+            snprintf(old_ext, sizeof(old_ext), "%.2f", (t4 - t3) / 1e6);
+            snprintf(old_align, sizeof(old_align), "%.2f", (t5 - t4) / 1e6);
+
+            ok = same_graph(&oa, &ga) && same_graph(&ob, &gb) && nx == ny;
+            for (size_t i = 0; ok && i < nx; i++) {
+                ok = x[i].old_sig == y[i].old_sig &&
+                     x[i].new_sig == y[i].new_sig && x[i].kind == y[i].kind;
+            }
+            result = ok ? "identical" : "DIFFER";
+
+            scope_graph_free(&oa);
+            scope_graph_free(&ob);
+        }
+
+        printf("%-8zu %12s %12s %12.2f %12.2f %9zu  %s\n", n, old_ext,
+               old_align, (t1 - t0) / 1e6, (t2 - t1) / 1e6, unchanged, result);
+
+        scope_graph_free(&ga);
+        scope_graph_free(&gb);
+        timeline_free(&ta);
+        timeline_free(&tb);
+        free(frames_a);
+        free(frames_b);
+        free(x);
+        free(y);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "scope_align_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+/*
+ * source_bench
+ *
+ * Cost of getting a translation unit in front of the lexer:
+ *
+ *   copied — read_entire_file followed by the strdup the AST used
+ *            to make (two heap copies)
+ *   mapped — source_buffer_open (mmap, no copies)
+ *
+ * Each variant is timed through one full front-to-back pass over
+ * the bytes, which is what the lexer does. Heap bytes are the
+ * private copies held while the AST is alive.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/common.h"
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static size_t scan(const char *s, size_t len)
+{
+    size_t semis = 0;
+    for (size_t i = 0; i < len; i++) {
+        semis += s[i] == ';';
+    }
+    return semis;
+}
+
+static int bench(const char *path, size_t mib)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+    size_t target = mib * 1024 * 1024;
+    size_t written = 0;
+    fputs("int main() {\n", f);
+    while (written < target) {
+        written += (size_t)fprintf(f, "{ int v%zu; v%zu; }\n",
+                                   written % 997, written % 997);
+    }
+    fputs("return 0;\n}\n", f);
+    fclose(f);
+
+    volatile size_t sink = 0;
+
+    /* copied */
+    double t0 = now_ns();
+    char *buf = NULL;
+    size_t len = 0;
+    if (!read_entire_file(path, &buf, &len)) {
+        return 0;
+    }
+    char *copy = strdup(buf);
+    if (!copy) {
+        free(buf);
+        return 0;
+    }
+    sink += scan(copy, len);
+    double t1 = now_ns();
+    size_t copied_heap = 2 * (len + 1);
+    free(copy);
+    free(buf);
+
+    /* mapped */
+    double t2 = now_ns();
+    SourceBuffer sb;
+    if (!source_buffer_open(&sb, path)) {
+        return 0;
+    }
+    sink += scan(sb.data, sb.len);
+    double t3 = now_ns();
+    size_t mapped_heap = sb.heap ? sb.len : 0;
+    source_buffer_close(&sb);
+
+    printf("%4zu MiB  copied %8.2f ms heap=%6zuK   "
+           "mapped %8.2f ms heap=%6zuK\n",
+           mib, (t1 - t0) / 1e6, copied_heap / 1024,
+           (t3 - t2) / 1e6, mapped_heap / 1024);
+
+    (void)sink;
+    return 1;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/liminal_source_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    fclose(fdopen(fd, "w"));
+
+    printf("== source: load + one pass ==\n");
+
+    int ok = 1;
+    size_t sizes[] = { 1, 16, 64 };
+    for (size_t i = 0; ok && i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        ok = bench(path, sizes[i]);
+    }
+
+    remove(path);
+    return ok ? 0 : 1;
+}
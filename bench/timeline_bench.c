@@ -0,0 +1,158 @@
+/*
+ * timeline_bench
+ *
+ * Footprint and scan cost of the execution history:
+ *
+ *   legacy   — one cloned World (time, 4 state pointers, prev/next)
+ *              plus one Step per step, linked through `next`
+ *   columnar — src/executor/timeline (kind/origin/info/scope columns)
+ *
+ * The scan runs SCAN_PASSES full passes per build, roughly what the
+ * analyzer does per input, each counting USE steps with an
+ * unresolved storage id.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+
+#define SCAN_PASSES 6
+
+/* ------------------------------------------------------------
+ * Legacy World chain (model of the old executor layout)
+ * ------------------------------------------------------------ */
+
+typedef struct LegacyStep {
+    StepKind kind;
+    void    *origin;
+    uint64_t info;
+} LegacyStep;
+
+typedef struct LegacyWorld {
+    uint64_t time;
+    void *active_scope;
+    void *call_stack;
+    void *memory;
+    LegacyStep *step;
+    struct LegacyWorld *prev;
+    struct LegacyWorld *next;
+} LegacyWorld;
+
+/* ------------------------------------------------------------
+ * Harness
+ * ------------------------------------------------------------ */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static StepKind kind_at(size_t i)
+{
+    static const StepKind mix[] = {
+        STEP_DECLARE, STEP_USE, STEP_USE, STEP_ENTER_SCOPE,
+        STEP_USE, STEP_DECLARE, STEP_EXIT_SCOPE, STEP_USE
+    };
+    return mix[i % (sizeof(mix) / sizeof(mix[0]))];
+}
+
+static uint64_t info_at(size_t i)
+{
+    return (i % 13 == 0) ? UINT64_MAX : i;
+}
+
+static void bench(size_t n)
+{
+    volatile size_t sink = 0;
+
+    /* legacy: interleaved World/Step allocations, as before */
+    Arena wa, sa;
+    ArenaStats ws, ss;
+    arena_init(&wa, 64 * 1024);
+    arena_init(&sa, 64 * 1024);
+
+    LegacyWorld *head = NULL, *tail = NULL;
+    for (size_t i = 0; i < n; i++) {
+        LegacyWorld *w = arena_alloc(&wa, sizeof(LegacyWorld));
+        LegacyStep *s = arena_alloc(&sa, sizeof(LegacyStep));
+        s->kind = kind_at(i);
+        s->origin = (void *)&sink;
+        s->info = info_at(i);
+        w->time = i;
+        w->step = s;
+        w->prev = tail;
+        if (tail) {
+            tail->next = w;
+        } else {
+            head = w;
+        }
+        tail = w;
+    }
+    arena_stats(&wa, &ws);
+    arena_stats(&sa, &ss);
+    size_t lbytes = ws.used + ss.used;
+
+    double t0 = now_ns();
+    for (int p = 0; p < SCAN_PASSES; p++) {
+        size_t hits = 0;
+        for (const LegacyWorld *w = head; w; w = w->next) {
+            if (w->step->kind == STEP_USE && w->step->info == UINT64_MAX) {
+                hits++;
+            }
+        }
+        sink += hits;
+    }
+    double t1 = now_ns();
+
+    /* columnar */
+    Timeline tl;
+    timeline_init(&tl);
+    for (size_t i = 0; i < n; i++) {
+        timeline_append(&tl, kind_at(i), (void *)&sink, info_at(i), NULL);
+    }
+    size_t cbytes = tl.count * (sizeof(*tl.kind) + sizeof(*tl.origin) +
+                                sizeof(*tl.info) + sizeof(*tl.scope));
+
+    double t2 = now_ns();
+    for (int p = 0; p < SCAN_PASSES; p++) {
+        size_t hits = 0;
+        for (size_t i = 0; i < tl.count; i++) {
+            if (timeline_kind(&tl, i) == STEP_USE &&
+                timeline_info(&tl, i) == UINT64_MAX) {
+                hits++;
+            }
+        }
+        sink += hits;
+    }
+    double t3 = now_ns();
+
+    double scans = (double)n * SCAN_PASSES;
+
+    printf("%-8zu %-9s %6.1f B/step %7.2f ns/step/pass\n",
+           n, "legacy", (double)lbytes / n, (t1 - t0) / scans);
+    printf("%-8zu %-9s %6.1f B/step %7.2f ns/step/pass\n",
+           n, "columnar", (double)cbytes / n, (t3 - t2) / scans);
+
+    timeline_free(&tl);
+    arena_destroy(&wa);
+    arena_destroy(&sa);
+}
+
+int main(void)
+{
+    printf("== timeline: footprint and %d-pass scan ==\n", SCAN_PASSES);
+
+    size_t sizes[] = { 1000, 100000, 1000000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench(sizes[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * timeline_bin_bench
+ *
+ * timeline.ndjson against timeline.bin for a large timeline:
+ *
+ *   ndjson  — timeline_emit_ndjson; read back line by line
+ *   fixed   — timeline_emit_binary; timeline_binary_open (mmap)
+ *   varint  — timeline_emit_binary(TIMELINE_BIN_VARINT); open decodes
+ *
+ * "read" ends with one scan over the step and ast columns, so
+ * every format pays for touching the data.
+ *
+ * The bench fails unless both binary forms reproduce the timeline,
+ * a flipped payload byte is reported as a checksum mismatch, and
+ * timeline_columns_first_divergence agrees with
+ * timeline_diff_first_line on the NDJSON files.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "common/common.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+#include "consumers/consumers.h"
+
+#define STEPS 2000000
+#define NODES 65536
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static StepKind kind_at(size_t i)
+{
+    static const StepKind mix[] = {
+        STEP_ENTER_SCOPE, STEP_DECLARE, STEP_USE, STEP_DECLARE,
+        STEP_USE, STEP_USE, STEP_EXIT_SCOPE, STEP_RETURN
+    };
+    return mix[i % (sizeof(mix) / sizeof(mix[0]))];
+}
+
+/* Node ids move forward in small steps, as in a real run */
+static void build(Timeline *tl, ASTNode *nodes, size_t changed_at)
+{
+    timeline_reset(tl);
+    timeline_append(tl, STEP_UNKNOWN, NULL, 0, NULL);
+
+    for (size_t i = 1; i < STEPS; i++) {
+        size_t id = 1 + (i / 3 + (i % 5)) % (NODES - 1);
+        uint64_t info = (i % 13 == 0) ? UINT64_MAX : i / 4;
+        StepKind k = kind_at(i);
+
+        if (i == changed_at) {
+            k = STEP_USE;
+            id = NODES - 1;
+        }
+        timeline_append(tl, k, &nodes[id], info, NULL);
+    }
+}
+
+static long file_size(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+static int write_file(const char *path, const Timeline *tl, int bin,
+                      unsigned flags)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return 0;
+    int ok = 1;
+    if (bin) {
+        ok = timeline_emit_binary(tl, f, flags);
+    } else {
+        timeline_emit_ndjson(tl, f);
+    }
+    return fclose(f) == 0 && ok;
+}
+
+static size_t scan_columns(const TimelineColumns *c)
+{
+    size_t hits = 0;
+    for (size_t t = 0; t < c->count; t++) {
+        hits += c->step[t] == STEP_USE && c->ast[t] > NODES / 2;
+    }
+    return hits;
+}
+
+static size_t read_ndjson(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+
+    char line[256], step[64];
+    unsigned long long t;
+    unsigned ast;
+    size_t hits = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "{\"v\":1,\"t\":%llu,\"step\":\"%63[^\"]\","
+                         "\"ast\":%u}", &t, step, &ast) == 3) {
+            hits += strcmp(step, "use") == 0 && ast > NODES / 2;
+        }
+    }
+    fclose(f);
+    return hits;
+}
+
+static int same_columns(const TimelineColumns *c, const Timeline *tl)
+{
+    if (c->count != tl->count) return 0;
+    for (size_t t = 0; t < tl->count; t++) {
+        const ASTNode *n = timeline_origin(tl, t);
+        if (c->step[t] != tl->kind[t] ||
+            c->ast[t] != (n ? n->id : 0) ||
+            c->info[t] != timeline_info(tl, t)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    const char *dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char nd[512], fx[512], vi[512], nd2[512], fx2[512];
+    snprintf(nd, sizeof(nd), "%s/tlbench.%ld.ndjson", dir, (long)getpid());
+    snprintf(fx, sizeof(fx), "%s/tlbench.%ld.bin", dir, (long)getpid());
+    snprintf(vi, sizeof(vi), "%s/tlbench.%ld.vbin", dir, (long)getpid());
+    snprintf(nd2, sizeof(nd2), "%s/tlbench.%ld.2.ndjson", dir,
+             (long)getpid());
+    snprintf(fx2, sizeof(fx2), "%s/tlbench.%ld.2.bin", dir, (long)getpid());
+
+    ASTNode *nodes = calloc(NODES, sizeof(ASTNode));
+    Timeline tl;
+    timeline_init(&tl);
+    if (!nodes) return 1;
+    for (uint32_t i = 0; i < NODES; i++) {
+        nodes[i].id = i;
+    }
+    build(&tl, nodes, 0);
+
+    const char *names[] = { "ndjson", "fixed", "varint" };
+    const char *paths[] = { nd, fx, vi };
+    int ok = 1;
+    size_t expect = 0;
+
+    printf("== timeline artifacts: %d steps ==\n", STEPS);
+    printf("%-8s %10s %9s %10s %10s\n",
+           "format", "bytes", "B/step", "write ms", "read ms");
+
+    for (int f = 0; f < 3; f++) {
+        double t0 = now_ns();
+        ok = ok && write_file(paths[f], &tl, f > 0,
+                              f == 2 ? TIMELINE_BIN_VARINT : 0);
+        double t1 = now_ns();
+
+        size_t hits;
+        TimelineColumns c = {0};
+        if (f == 0) {
+            hits = read_ndjson(paths[f]);
+            expect = hits;
+        } else {
+            ok = ok && timeline_binary_open(paths[f], &c) == TIMELINE_BIN_OK;
+            hits = ok ? scan_columns(&c) : 0;
+        }
+        double t2 = now_ns();
+
+        if (f > 0) {
+            ok = ok && hits == expect && same_columns(&c, &tl);
+            timeline_binary_close(&c);
+        }
+
+        long size = file_size(paths[f]);
+        printf("%-8s %10ld %9.2f %10.1f %10.1f\n", names[f], size,
+               (double)size / STEPS, (t1 - t0) / 1e6, (t2 - t1) / 1e6);
+    }
+
+    /* ---- CHECKSUM ---- */
+    {
+        FILE *f = fopen(vi, "r+b");
+        int c;
+        ok = ok && f && fseek(f, 100, SEEK_SET) == 0 &&
+             (c = fgetc(f)) != EOF && fseek(f, 100, SEEK_SET) == 0 &&
+             fputc(c ^ 0x01, f) != EOF;
+        if (f) fclose(f);
+
+        TimelineColumns cc;
+        ok = ok && timeline_binary_open(vi, &cc) == TIMELINE_BIN_CHECKSUM;
+    }
+
+    /* ---- DIVERGENCE ---- */
+    {
+        build(&tl, nodes, STEPS / 3);
+        ok = ok && write_file(nd2, &tl, 0, 0) && write_file(fx2, &tl, 1, 0);
+
+        FILE *a = fopen(nd, "r"), *b = fopen(nd2, "r");
+        size_t by_line = a && b ? timeline_diff_first_line(a, b) : 0;
+        if (a) fclose(a);
+        if (b) fclose(b);
+
+        TimelineColumns ca, cb;
+        int opened = (timeline_binary_open(fx, &ca) == TIMELINE_BIN_OK) &
+                     (timeline_binary_open(fx2, &cb) == TIMELINE_BIN_OK);
+        size_t by_column = opened ? timeline_columns_first_divergence(&ca, &cb)
+                                  : 0;
+        timeline_binary_close(&ca);
+        timeline_binary_close(&cb);
+
+        printf("first divergence: line %zu, column %zu\n", by_line, by_column);
+        ok = ok && opened && by_line == STEPS / 3 && by_column == by_line;
+    }
+
+    remove(nd);
+    remove(fx);
+    remove(vi);
+    remove(nd2);
+    remove(fx2);
+    timeline_free(&tl);
+    free(nodes);
+
+    if (!ok) {
+        fprintf(stderr, "timeline_bin_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,464 @@
+/*
+ * timeline_diff_bench
+ *
+ * Cross-run timeline comparison on 1M-step timelines:
+ *
+ *   first_line — timeline_diff_first_line on the NDJSON text (the
+ *                previous `liminal diff`): only where they part
+ *   myers      — timeline_diff (traced, linear space past
+ *                TRACE_MAX_D edits)
+ *   linear     — timeline_diff_linear (always linear space)
+ *
+ * Every diff is checked: the steps it leaves out of each side
+ * must be the same sequence, and both Myers variants must find
+ * the same edit distance. Small random pairs are also checked
+ * against an O(nm) LCS table for the shortest one (the 5%
+ * rewrite passes BISECT_MAX_D and may be slightly longer).
+ *
+ * End to end, two programs that differ by one declaration in
+ * their first function are parsed, executed, written as both
+ * timeline artifacts and read back; each diff must be that one
+ * ADDED declare, although every later AST id has shifted ("by
+ * ast" is what keying on AST ids reports instead).
+ *
+ * The bench fails on any mismatch.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/common.h"
+#include "frontends/frontends.h"
+#include "executor/executor.h"
+#include "consumers/consumers.h"
+
+#define STEPS      1000000
+#define FUZZ_CASES 3000
+#define FUZZ_MAX   40
+
+#define SOURCE_FUNCTIONS 50
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rng_state = 0x2545f4914f6cdd1dull;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static TimelineStepView random_step(void)
+{
+    TimelineStepView s = {
+        .step_kind = STEP_ENTER_SCOPE + rng() % 4,
+        .ast_id    = rng() % 65536
+    };
+    return s;
+}
+
+static void renumber(TimelineStepView *s, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        s[i].time = i;
+    }
+}
+
+/* ------------------------------------------------------------
+ * Checking
+ * ------------------------------------------------------------ */
+
+static int same_step(const TimelineStepView *a, const TimelineStepView *b)
+{
+    return a->step_kind == b->step_kind && a->ast_id == b->ast_id;
+}
+
+/*
+ * Valid alignment: with the reported steps removed, both sides
+ * read the same. Times are indices here. Returns the edit
+ * distance, or -1.
+ */
+static long check(const TimelineStepView *a, size_t n,
+                  const TimelineStepView *b, size_t m,
+                  const TimelineDiff *d, size_t count)
+{
+    char *gone_a = calloc(n + 1, 1);
+    char *gone_b = calloc(m + 1, 1);
+    long dist = 0;
+    int ok = gone_a && gone_b;
+
+    for (size_t k = 0; ok && k < count; k++) {
+        if (d[k].kind != TIMELINE_DIFF_ADDED) {
+            ok = d[k].before.time < n && !gone_a[d[k].before.time] &&
+                 same_step(&d[k].before, &a[d[k].before.time]);
+            if (ok) gone_a[d[k].before.time] = 1;
+            dist++;
+        }
+        if (ok && d[k].kind != TIMELINE_DIFF_REMOVED) {
+            ok = d[k].after.time < m && !gone_b[d[k].after.time] &&
+                 same_step(&d[k].after, &b[d[k].after.time]);
+            if (ok) gone_b[d[k].after.time] = 1;
+            dist++;
+        }
+    }
+
+    size_t i = 0, j = 0;
+    while (ok) {
+        while (i < n && gone_a[i]) i++;
+        while (j < m && gone_b[j]) j++;
+        if (i == n || j == m) {
+            ok = i == n && j == m;
+            break;
+        }
+        ok = same_step(&a[i++], &b[j++]);
+    }
+
+    free(gone_a);
+    free(gone_b);
+    return ok ? dist : -1;
+}
+
+static long lcs_distance(const TimelineStepView *a, size_t n,
+                         const TimelineStepView *b, size_t m)
+{
+    static size_t t[FUZZ_MAX + 1][FUZZ_MAX + 1];
+
+    for (size_t i = 0; i <= n; i++) {
+        for (size_t j = 0; j <= m; j++) {
+            if (!i || !j) {
+                t[i][j] = 0;
+            } else if (same_step(&a[i - 1], &b[j - 1])) {
+                t[i][j] = t[i - 1][j - 1] + 1;
+            } else {
+                t[i][j] = t[i - 1][j] > t[i][j - 1] ? t[i - 1][j]
+                                                    : t[i][j - 1];
+            }
+        }
+    }
+    return (long)(n + m - 2 * t[n][m]);
+}
+
+static int fuzz(void)
+{
+    TimelineStepView a[FUZZ_MAX], b[FUZZ_MAX];
+    TimelineDiff d[2 * FUZZ_MAX];
+
+    for (int c = 0; c < FUZZ_CASES; c++) {
+        size_t n = rng() % (FUZZ_MAX + 1);
+        size_t m = rng() % (FUZZ_MAX + 1);
+        uint32_t alphabet = 2 + rng() % 4;
+
+        for (size_t i = 0; i < n; i++) {
+            a[i] = (TimelineStepView){
+                .time = i, .step_kind = STEP_DECLARE,
+                .ast_id = rng() % alphabet
+            };
+        }
+        for (size_t j = 0; j < m; j++) {
+            /* Mostly a mutated copy, so there is something to align */
+            b[j] = j < n && rng() % 3
+                 ? a[j]
+                 : (TimelineStepView){ .step_kind = STEP_DECLARE,
+                                       .ast_id = rng() % alphabet };
+            b[j].time = j;
+        }
+
+        long want = lcs_distance(a, n, b, m);
+        size_t k1 = timeline_diff(a, n, b, m, d, 2 * FUZZ_MAX);
+        long got1 = check(a, n, b, m, d, k1);
+        size_t k2 = timeline_diff_linear(a, n, b, m, d, 2 * FUZZ_MAX);
+        long got2 = check(a, n, b, m, d, k2);
+
+        if (got1 != want || got2 != want) {
+            fprintf(stderr, "fuzz case %d: n=%zu m=%zu want %ld, "
+                    "myers %ld, linear %ld\n", c, n, m, want, got1, got2);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Scenarios
+ * ------------------------------------------------------------ */
+
+static FILE *as_ndjson(const TimelineStepView *s, size_t n, char **buf)
+{
+    size_t len = 0;
+    FILE *f = open_memstream(buf, &len);
+    if (!f) return NULL;
+
+    for (size_t i = 0; i < n; i++) {
+        fprintf(f, "{\"v\":1,\"t\":%llu,\"step\":\"%s\",\"ast\":%u}\n",
+                (unsigned long long)s[i].time,
+                step_kind_name((StepKind)s[i].step_kind),
+                s[i].ast_id);
+    }
+    fclose(f);
+    return fmemopen(*buf, len, "r");
+}
+
+typedef enum {
+    EDIT_INSERT_DECL,     /* one declaration early on */
+    EDIT_SCATTERED,       /* 200 point edits */
+    EDIT_REWRITE          /* a 5% block replaced */
+} EditKind;
+
+static size_t make_new(const TimelineStepView *a, size_t n,
+                       TimelineStepView *b, EditKind kind)
+{
+    size_t m = 0;
+
+    switch (kind) {
+    case EDIT_INSERT_DECL:
+        memcpy(b, a, n / 10 * sizeof(*b));
+        m = n / 10;
+        b[m++] = (TimelineStepView){ .step_kind = STEP_DECLARE,
+                                     .ast_id = 70000 };
+        b[m++] = (TimelineStepView){ .step_kind = STEP_USE,
+                                     .ast_id = 70000 };
+        memcpy(b + m, a + n / 10, (n - n / 10) * sizeof(*b));
+        m += n - n / 10;
+        break;
+
+    case EDIT_SCATTERED:
+        for (size_t i = 0; i < n; i++) {
+            if (i % (n / 200) != 7) {
+                b[m++] = a[i];
+                continue;
+            }
+            switch (i / (n / 200) % 3) {
+            case 0: b[m++] = random_step(); break;            /* changed */
+            case 1: break;                                    /* removed */
+            default: b[m++] = random_step(); b[m++] = a[i];   /* added */
+            }
+        }
+        break;
+
+    case EDIT_REWRITE:
+        for (size_t i = 0; i < n; i++) {
+            b[m++] = i >= n / 2 && i < n / 2 + n / 20 ? random_step() : a[i];
+        }
+        break;
+    }
+
+    renumber(b, m);
+    return m;
+}
+
+/* ------------------------------------------------------------
+ * Source edit
+ * ------------------------------------------------------------ */
+
+static char *write_source(int edited, size_t *len)
+{
+    char *buf = NULL;
+    FILE *f = open_memstream(&buf, len);
+    if (!f) return NULL;
+
+    for (int i = 0; i < SOURCE_FUNCTIONS; i++) {
+        fprintf(f, "int f%d() {\n", i);
+        if (edited && i == 0) {
+            fputs("    int added;\n", f);
+        }
+        fputs("    int a;\n    {\n        int b;\n        a;\n"
+              "        b;\n    }\n    a;\n    return 0;\n}\n\n", f);
+    }
+    fclose(f);
+    return buf;
+}
+
+typedef struct Events {
+    TimelineStepView *at;
+    size_t count;
+    size_t cap;
+} Events;
+
+static int collect(const TimelineEvent *e, void *ctx)
+{
+    Events *ev = ctx;
+    if (ev->count == ev->cap) {
+        size_t cap = ev->cap ? ev->cap * 2 : 256;
+        TimelineStepView *at = realloc(ev->at, cap * sizeof(*at));
+        if (!at) return 0;
+        ev->at = at;
+        ev->cap = cap;
+    }
+    ev->at[ev->count++] = *e;
+    return 1;
+}
+
+/* Both artifacts of `tl`, read back as `liminal diff` reads them */
+static int round_trip(const Timeline *tl, Events *ev, TimelineColumns *cols)
+{
+    char *text = NULL;
+    size_t len = 0;
+    FILE *f = open_memstream(&text, &len);
+    if (!f) return 0;
+    timeline_emit_ndjson(tl, f);
+    fclose(f);
+
+    f = fmemopen(text, len, "r");
+    int ok = f && timeline_read_ndjson(f, collect, ev, NULL) == 0 &&
+             ev->count == tl->count;
+    if (f) fclose(f);
+    free(text);
+
+    char path[] = "/tmp/liminal_timeline_diff_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (!ok || fd < 0) {
+        return 0;
+    }
+    f = fdopen(fd, "w+");
+    ok = f && timeline_emit_binary(tl, f, 0);
+    if (f) fclose(f);
+    ok = ok && timeline_binary_open(path, cols) == TIMELINE_BIN_OK;
+    remove(path);
+    return ok;
+}
+
+/* Exactly one entry: the inserted declaration */
+static int one_declare(const TimelineDiff *d, size_t total)
+{
+    return total == 1 && d[0].kind == TIMELINE_DIFF_ADDED &&
+           d[0].after.step_kind == STEP_DECLARE;
+}
+
+static int source_edit(void)
+{
+    ASTProgram *ast[2] = { NULL, NULL };
+    Universe *u[2] = { NULL, NULL };
+    char *src[2] = { NULL, NULL };
+    Events ev[2] = { {0}, {0} };
+    TimelineColumns cols[2] = { {0}, {0} };
+    TimelineDiff d[64];
+    int ok = 1;
+
+    for (int i = 0; ok && i < 2; i++) {
+        size_t len = 0;
+        src[i] = write_source(i, &len);
+        ast[i] = src[i] ? c_parse_source_recycle("edit.c", src[i], len,
+                                                 NULL)
+                        : NULL;
+        u[i] = universe_create();
+        ok = ast[i] && u[i] && executor_run(u[i], ast[i]) &&
+             round_trip(&u[i]->timeline, &ev[i], &cols[i]);
+    }
+
+    size_t nd = 0, bin = 0, by_ast = 0;
+    if (ok) {
+        nd = timeline_diff(ev[0].at, ev[0].count, ev[1].at, ev[1].count,
+                           d, 64);
+        ok = one_declare(d, nd);
+
+        bin = timeline_diff_columns(&cols[0], &cols[1], d, 64);
+        ok = ok && one_declare(d, bin);
+
+        /* As the artifacts were before they carried names */
+        for (int i = 0; i < 2; i++) {
+            for (size_t t = 0; t < ev[i].count; t++) {
+                ev[i].at[t].name = 0;
+            }
+        }
+        by_ast = timeline_diff(ev[0].at, ev[0].count, ev[1].at, ev[1].count,
+                               d, 64);
+    }
+
+    printf("source edit: %d functions, %zu steps: ndjson %zu, binary %zu, "
+           "by ast %zu entries: %s\n", SOURCE_FUNCTIONS, ev[0].count, nd,
+           bin, by_ast, ok ? "ok" : "WRONG");
+
+    for (int i = 0; i < 2; i++) {
+        timeline_binary_close(&cols[i]);
+        free(ev[i].at);
+        universe_destroy(u[i]);
+        ast_program_free(ast[i]);
+        free(src[i]);
+    }
+    return ok;
+}
+
+int main(void)
+{
+    static const char *names[] = { "insert decl", "200 edits", "5% rewrite" };
+    int ok = fuzz();
+
+    printf("== timeline diff ==\n");
+    printf("fuzz: %d random pairs vs LCS table: %s\n",
+           FUZZ_CASES, ok ? "ok" : "WRONG");
+    ok = ok && source_edit();
+
+    TimelineStepView *a = malloc(STEPS * sizeof(*a));
+    TimelineStepView *b = malloc((STEPS + STEPS / 100 + 2) * sizeof(*b));
+    size_t cap = 2 * STEPS + STEPS / 50 + 4;
+    TimelineDiff *d = malloc(cap * sizeof(*d));
+    if (!a || !b || !d) {
+        fprintf(stderr, "timeline_diff_bench: out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < STEPS; i++) {
+        a[i] = random_step();
+    }
+    renumber(a, STEPS);
+
+    printf("%-12s %12s %10s %10s %10s %8s  %s\n", "edit", "first_line",
+           "ms", "myers ms", "linear ms", "entries", "result");
+
+    for (int e = 0; ok && e < 3; e++) {
+        size_t m = make_new(a, STEPS, b, (EditKind)e);
+
+        char *ta = NULL, *tb = NULL;
+        FILE *fa = as_ndjson(a, STEPS, &ta);
+        FILE *fb = as_ndjson(b, m, &tb);
+        ok = fa && fb;
+        if (!ok) break;
+
+        /* Untimed pass first: page in the inputs and the heap */
+        timeline_diff(a, STEPS, b, m, d, cap);
+
+        double t0 = now_ns();
+        size_t line = timeline_diff_first_line(fa, fb);
+        double t1 = now_ns();
+        size_t k1 = timeline_diff(a, STEPS, b, m, d, cap);
+        double t2 = now_ns();
+        long d1 = check(a, STEPS, b, m, d, k1);
+        double t3 = now_ns();
+        size_t k2 = timeline_diff_linear(a, STEPS, b, m, d, cap);
+        double t4 = now_ns();
+        long d2 = check(a, STEPS, b, m, d, k2);
+
+        ok = k1 != TIMELINE_DIFF_NOMEM && k2 != TIMELINE_DIFF_NOMEM &&
+             d1 > 0 && d1 == d2;
+
+        char at[32];
+        snprintf(at, sizeof(at), "line %zu", line);
+        printf("%-12s %12s %10.2f %10.2f %10.2f %8zu  %s (distance %ld)\n",
+               names[e], at, (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+               (t4 - t3) / 1e6, k1, ok ? "ok" : "WRONG", d1);
+
+        fclose(fa);
+        fclose(fb);
+        free(ta);
+        free(tb);
+    }
+
+    free(a);
+    free(b);
+    free(d);
+
+    if (!ok) {
+        fprintf(stderr, "timeline_diff_bench: FAILED\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -3,7 +3,10 @@
 
 #include "./constraint/constraint.h"
 #include "./diagnostic/diagnostic.h"
+#include "./incremental/incremental.h"
 #include "./lifetime/lifetime.h"
+#include "./pass/pass.h"
+#include "./pipeline/pipeline.h"
 #include "./trace/trace.h"
 #include "./use/use.h"
 #include "./validate/validate.h"
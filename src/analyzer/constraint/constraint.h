@@ -4,10 +4,12 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "common/intern/intern.h"
+
 /* Stage 5.1 forward declaration */
 struct SourceAnchor;
 struct Diagnostic;
-struct World; 
+struct Timeline;
 
 /*
  * ConstraintKind
@@ -33,6 +35,13 @@ typedef struct Constraint {
     uint64_t time;
     uint64_t scope_id;
     uint64_t storage_id;
+    Symbol   name;                /* identifier involved, if any */
+    uint32_t node_id;             /* AST node it arose at, 0 if none */
+
+    /* Position-independent site: spelling hashes (intern_hash64)
+     * of the name and of the enclosing function, 0 if none */
+    uint64_t spelling;
+    uint64_t function;
 
     struct SourceAnchor *anchor;  /* may be NULL */
 } Constraint;
@@ -47,7 +56,23 @@ typedef struct ConstraintArtifact {
     size_t count;
 } ConstraintArtifact;
 
-ConstraintArtifact analyze_constraints(struct World *head);
+/*
+ * ConstraintCollector
+ *
+ * Fixed-cap sink a constraint pass writes into.
+ * Constraints past `cap` are dropped.
+ */
+
+/* Capacity of each rule's collector in a run */
+#define CONSTRAINT_RULE_CAP 64
+
+typedef struct ConstraintCollector {
+    Constraint *items;
+    size_t count;
+    size_t cap;
+} ConstraintCollector;
+
+ConstraintArtifact analyze_constraints(const struct Timeline *tl);
 
 size_t constraint_to_diagnostic(
     const ConstraintArtifact *constraints,
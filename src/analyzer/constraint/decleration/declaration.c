@@ -1,80 +1,104 @@
 //@source src/analyzer/constraint_declaration.c
 #include "analyzer/analyzer.h"
+#include "analyzer/constraint/decleration/declaration.h"
+#include "analyzer/constraint/engine/engine.h"
 #include "executor/executor.h"
 #include "common/common.h"
 #include "frontends/frontends.h"   /* for ASTNode */
 #include <stdlib.h>
 #include <stdint.h>
 
-ConstraintArtifact analyze_declaration_constraints(struct World *head)
+static void on_step(void *state, const PassStep *s)
 {
-    size_t cap = 64;
-    Constraint *buf = calloc(cap, sizeof(Constraint));
-    size_t count = 0;
+    ConstraintCollector *c = state;
 
-    if (!buf || !head) {
-        return (ConstraintArtifact){ .items = NULL, .count = 0 };
-    }
-
-    Trace t = trace_begin(head);
+    /* Scope the declaration was made into */
+    Scope *cur = s->prev_scope;
+    if (!cur)
+        return;
 
-    while (trace_is_valid(&t)) {
-        World *w = trace_current(&t);
-        Step  *s = w ? w->step : NULL;
-
-        if (!s || s->kind != STEP_DECLARE) {
-            trace_next(&t);
-            continue;
-        }
+    Symbol name = SYMBOL_NONE;
+    uint32_t node_id = 0;
 
-        World *prev = w->prev;
-        if (!prev || !prev->active_scope)
-            goto next;
+    /* Extract name from AST origin (safe for now) */
+    if (s->origin) {
+        ASTNode *n = (ASTNode *)s->origin;
+        name = n->as.vdecl.name;
+        node_id = n->id;
+    }
 
-        Scope *cur = prev->active_scope;
-        const char *name = NULL;
+    if (name == SYMBOL_NONE)
+        return;
 
-        /* Extract name from AST origin (safe for now) */
-        if (s->origin) {
-            ASTNode *n = (ASTNode *)s->origin;
-            name = n->as.vdecl.name;
-        }
+    uint64_t spelling = intern_hash64(s->tl->symbols, name);
+    uint64_t function = constraint_function_spelling(s);
 
-        if (!name)
-            goto next;
+    /* 1. Redeclaration in same scope */
+    if (scope_has_name(cur, name) && c->count < c->cap) {
+        c->items[c->count++] = (Constraint){
+            .kind       = CONSTRAINT_REDECLARATION,
+            .time       = s->time,
+            .scope_id   = cur->id,
+            .storage_id = s->info,
+            .name       = name,
+            .node_id    = node_id,
+            .spelling   = spelling,
+            .function   = function,
+            .anchor     = anchor_from_origin(s->origin)
+        };
+        return;
+    }
 
-        /* 1. Redeclaration in same scope */
-        if (scope_has_name(cur, name) && count < cap) {
-            buf[count++] = (Constraint){
-                .kind       = CONSTRAINT_REDECLARATION,
-                .time       = w->time,
+    /* 2. Shadowing parent scope (older frames of `cur` hold no more) */
+    for (Scope *p = scope_next_distinct(cur); p; p = scope_next_distinct(p)) {
+        if (scope_has_name(p, name) && c->count < c->cap) {
+            c->items[c->count++] = (Constraint){
+                .kind       = CONSTRAINT_SHADOWING,
+                .time       = s->time,
                 .scope_id   = cur->id,
                 .storage_id = s->info,
+                .name       = name,
+                .node_id    = node_id,
+                .spelling   = spelling,
+                .function   = function,
                 .anchor     = anchor_from_origin(s->origin)
             };
-            goto next;
+            break;
         }
+    }
+}
 
-        /* 2. Shadowing parent scope */
-        for (Scope *p = cur->parent; p; p = p->parent) {
-            if (scope_has_name(p, name) && count < cap) {
-                buf[count++] = (Constraint){
-                    .kind       = CONSTRAINT_SHADOWING,
-                    .time       = w->time,
-                    .scope_id   = cur->id,
-                    .storage_id = s->info,
-                    .anchor     = anchor_from_origin(s->origin)
-                };
-                break;
-            }
-        }
+AnalyzerPass declaration_constraint_pass(ConstraintCollector *c)
+{
+    return (AnalyzerPass){
+        .name    = "declaration-constraints",
+        .state   = c,
+        .kinds   = PASS_KIND(STEP_DECLARE),
+        .on_step = on_step
+    };
+}
 
-    next:
-        trace_next(&t);
+ConstraintArtifact analyze_declaration_constraints(const struct Timeline *tl)
+{
+    ConstraintCollector c = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .count = 0,
+        .cap   = CONSTRAINT_RULE_CAP
+    };
+
+    if (!c.items || !tl) {
+        free(c.items);
+        return (ConstraintArtifact){ .items = NULL, .count = 0 };
     }
 
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, declaration_constraint_pass(&c));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
+
     return (ConstraintArtifact){
-        .items = buf,
-        .count = count
+        .items = c.items,
+        .count = c.count
     };
 }
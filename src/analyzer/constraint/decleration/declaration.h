@@ -2,8 +2,10 @@
 #ifndef LIMINAL_CONSTRAINT_DECLARATION_H
 #define LIMINAL_CONSTRAINT_DECLARATION_H
 
+#include "../constraint.h"
+#include "../../pass/pass.h"
 
-struct World;
+struct Timeline;
 struct ASTNode;
 /*
  * Declaration-related constraint extraction.
@@ -12,6 +14,9 @@ struct ASTNode;
  *   - CONSTRAINT_REDECLARATION
  *   - CONSTRAINT_SHADOWING
  */
-ConstraintArtifact analyze_declaration_constraints(struct World *head);
+ConstraintArtifact analyze_declaration_constraints(const struct Timeline *tl);
+
+/* Same rule as a pass; writes into `c` */
+AnalyzerPass declaration_constraint_pass(ConstraintCollector *c);
 
 #endif /* LIMINAL_CONSTRAINT_DECLARATION_H */
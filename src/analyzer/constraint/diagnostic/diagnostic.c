@@ -1,5 +1,19 @@
 #include "analyzer/analyzer.h"
 
+/* Earlier constraints of the same kind, name and function */
+static uint32_t ordinal_of(const ConstraintArtifact *a, size_t i)
+{
+    const Constraint *c = &a->items[i];
+    uint32_t n = 0;
+
+    for (size_t j = 0; j < i; j++) {
+        const Constraint *o = &a->items[j];
+        n += o->kind == c->kind && o->spelling == c->spelling &&
+             o->function == c->function;
+    }
+    return n;
+}
+
 size_t constraint_to_diagnostic(
     const ConstraintArtifact *constraints,
     Diagnostic *out,
@@ -15,7 +29,7 @@ size_t constraint_to_diagnostic(
         Diagnostic *d = &out[count];
 
         /* Stable identity derived from constraint */
-        d->id = diagnostic_id_from_constraint(c);
+        d->id = diagnostic_id_from_constraint(c, ordinal_of(constraints, i));
 
         d->time      = c->time;
         d->scope_id  = c->scope_id;
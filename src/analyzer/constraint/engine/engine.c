@@ -1,29 +1,70 @@
 #include "analyzer/constraint/engine/engine.h"
 #include "analyzer/constraint/variable/variable.h"
 #include "analyzer/constraint/decleration/declaration.h"
+#include "analyzer/pass/pass.h"
+#include "frontends/frontends.h"   /* for ASTNode */
 #include <stdlib.h>
 #include <string.h>
 
-ConstraintArtifact analyze_constraints(struct World *head)
+uint64_t constraint_function_spelling(const PassStep *s)
 {
-    ConstraintArtifact a = analyze_variable_constraints(head);
-    ConstraintArtifact b = analyze_declaration_constraints(head);
+    const ASTNode *fn = s->function;
+    return fn ? intern_hash64(s->tl->symbols, fn->as.fn.name) : 0;
+}
 
+ConstraintArtifact constraint_merge(
+    ConstraintCollector *first,
+    ConstraintCollector *second
+)
+{
     /* Temporary merge (Stage 4 discipline) */
-    size_t total = a.count + b.count;
+    size_t total = first->count + second->count;
     Constraint *buf = calloc(total, sizeof(Constraint));
 
-    if (!buf)
-        return a;
+    if (!buf) {
+        free(second->items);
+        return (ConstraintArtifact){
+            .items = first->items,
+            .count = first->count
+        };
+    }
 
-    memcpy(buf, a.items, a.count * sizeof(Constraint));
-    memcpy(buf + a.count, b.items, b.count * sizeof(Constraint));
+    memcpy(buf, first->items, first->count * sizeof(Constraint));
+    memcpy(buf + first->count, second->items,
+           second->count * sizeof(Constraint));
 
-    free(a.items);
-    free(b.items);
+    free(first->items);
+    free(second->items);
 
     return (ConstraintArtifact){
         .items = buf,
         .count = total
     };
 }
+
+ConstraintArtifact analyze_constraints(const struct Timeline *tl)
+{
+    ConstraintCollector var = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .cap   = CONSTRAINT_RULE_CAP
+    };
+    ConstraintCollector decl = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .cap   = CONSTRAINT_RULE_CAP
+    };
+
+    if (!tl || !var.items || !decl.items) {
+        free(var.items);
+        free(decl.items);
+        return (ConstraintArtifact){ .items = NULL, .count = 0 };
+    }
+
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, variable_constraint_pass(&var));
+    pass_manager_add(&pm, declaration_constraint_pass(&decl));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
+
+    return constraint_merge(&var, &decl);
+}
@@ -3,11 +3,29 @@
 
 #include "analyzer/constraint/constraint.h"
 
+struct PassStep;
+
 /*
  * Constraint engine entry point.
  *
- * Consumes a World timeline and produces semantic constraints.
+ * Consumes the Timeline and produces semantic constraints.
+ * Variable and declaration rules share one traversal.
+ */
+ConstraintArtifact analyze_constraints(const struct Timeline *tl);
+
+/*
+ * Concatenate two collectors (variable rules first, by convention)
+ * into one artifact. Takes ownership of both item buffers.
+ */
+ConstraintArtifact constraint_merge(
+    ConstraintCollector *first,
+    ConstraintCollector *second
+);
+
+/*
+ * Spelling hash of the function step `s` happened in, for
+ * Constraint.function; 0 outside functions.
  */
-ConstraintArtifact analyze_constraints(struct World *head);
+uint64_t constraint_function_spelling(const struct PassStep *s);
 
 #endif /* LIMINAL_CONSTRAINT_ENGINE_H */
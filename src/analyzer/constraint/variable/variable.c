@@ -1,13 +1,47 @@
 #include "analyzer/analyzer.h"
 #include "executor/executor.h"
+#include "analyzer/constraint/variable/variable.h"
+#include "analyzer/constraint/engine/engine.h"
+#include "frontends/frontends.h"   /* for ASTNode */
 
 #include <stdlib.h>
 #include <stdint.h>
 
-ConstraintArtifact analyze_variable_constraints(struct World *head)
+static void on_step(void *state, const PassStep *s)
+{
+    ConstraintCollector *c = state;
+
+    /* Unresolved variable use → constraint */
+    if (s->info == UINT64_MAX && c->count < c->cap) {
+        const ASTNode *n = s->origin;
+        Symbol name = n ? n->as.vuse.name : SYMBOL_NONE;
+        c->items[c->count++] = (Constraint){
+            .kind       = CONSTRAINT_USE_REQUIRES_DECLARATION,
+            .time       = s->time,
+            .scope_id   = 0,           /* scope not required yet */
+            .storage_id = UINT64_MAX,
+            .name       = name,
+            .node_id    = n ? n->id : 0,
+            .spelling   = intern_hash64(s->tl->symbols, name),
+            .function   = constraint_function_spelling(s)
+        };
+    }
+}
+
+AnalyzerPass variable_constraint_pass(ConstraintCollector *c)
+{
+    return (AnalyzerPass){
+        .name    = "variable-constraints",
+        .state   = c,
+        .kinds   = PASS_KIND(STEP_USE),
+        .on_step = on_step
+    };
+}
+
+ConstraintArtifact analyze_variable_constraints(const struct Timeline *tl)
 {
     /* Empty artifact for degenerate cases */
-    if (!head) {
+    if (!tl) {
         return (ConstraintArtifact){
             .items = NULL,
             .count = 0
@@ -15,39 +49,27 @@ ConstraintArtifact analyze_variable_constraints(struct World *head)
     }
 
     /* Fixed-cap temporary buffer (Stage 4.x discipline) */
-    size_t cap = 64;
-    Constraint *buf = calloc(cap, sizeof(Constraint));
-    size_t count = 0;
+    ConstraintCollector c = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .count = 0,
+        .cap   = CONSTRAINT_RULE_CAP
+    };
 
-    if (!buf) {
+    if (!c.items) {
         return (ConstraintArtifact){
             .items = NULL,
             .count = 0
         };
     }
 
-    Trace t = trace_begin(head);
-    while (trace_is_valid(&t)) {
-        World *w = trace_current(&t);
-        Step  *s = w ? w->step : NULL;
-
-        if (s && s->kind == STEP_USE) {
-            /* Unresolved variable use → constraint */
-            if (s->info == UINT64_MAX && count < cap) {
-                buf[count++] = (Constraint){
-                    .kind       = CONSTRAINT_USE_REQUIRES_DECLARATION,
-                    .time       = w->time,
-                    .scope_id   = 0,           /* scope not required yet */
-                    .storage_id = UINT64_MAX
-                };
-            }
-        }
-
-        trace_next(&t);
-    }
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, variable_constraint_pass(&c));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
 
     return (ConstraintArtifact){
-        .items = buf,
-        .count = count
+        .items = c.items,
+        .count = c.count
     };
 }
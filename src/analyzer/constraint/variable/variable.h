@@ -1,14 +1,19 @@
 #ifndef LIMINAL_CONSTRAINT_VARIABLE_H
 #define LIMINAL_CONSTRAINT_VARIABLE_H
 
+#include "../constraint.h"
+#include "../../pass/pass.h"
 
-struct World;
+struct Timeline;
 /*
  * Variable-related constraint extraction.
  *
  * Emits:
- *   - CONSTRAINT_REDECLARATION
+ *   - CONSTRAINT_USE_REQUIRES_DECLARATION
  */
-ConstraintArtifact analyze_variable_constraints(struct World *head);
+ConstraintArtifact analyze_variable_constraints(const struct Timeline *tl);
+
+/* Same rule as a pass; writes into `c` */
+AnalyzerPass variable_constraint_pass(ConstraintCollector *c);
 
 #endif
@@ -12,21 +12,24 @@ static void emit_meta(const ArtifactContext *ctx, const char *dir)
     char path[512];
     snprintf(path, sizeof(path), "%s/meta.json", dir);
 
-    char buf[1024];
-    snprintf(
-        buf, sizeof(buf),
-        "{\n"
-        "  \"liminal_version\": \"0.5.3\",\n"
-        "  \"run_id\": \"%s\",\n"
-        "  \"started_at\": %lu,\n"
-        "  \"input\": \"%s\"\n"
-        "}\n",
-        ctx->run_id,
-        ctx->started_at,
-        ctx->input_path
-    );
-
-    fs_write_file(path, buf, strlen(buf));
+    FILE *out = fs_open_file(path);
+    if (!out)
+        return;
+
+    JsonWriter w;
+    json_writer_init(&w, out);
+
+    json_write_lit(&w, "{\n  \"liminal_version\": \"" LIMINAL_VERSION "\",\n"
+                       "  \"run_id\": ");
+    json_write_string(&w, ctx->run_id);
+    json_write_lit(&w, ",\n  \"started_at\": ");
+    json_write_u64(&w, ctx->started_at);
+    json_write_lit(&w, ",\n  \"input\": ");
+    json_write_string(&w, ctx->input_path);
+    json_write_lit(&w, "\n}\n");
+
+    json_writer_flush(&w);
+    fclose(out);
 }
 
 static void emit_diagnostics(
@@ -45,29 +48,58 @@ static void emit_diagnostics(
     fclose(out);
 }
 
-void artifact_emit_all(
+static void emit_timelines(const ArtifactContext *ctx, const char *dir)
+{
+    unsigned formats = ctx->timeline_formats ? ctx->timeline_formats
+                                             : ARTIFACT_TIMELINE_NDJSON;
+    char path[600];
+
+    if (formats & ARTIFACT_TIMELINE_NDJSON) {
+        snprintf(path, sizeof(path), "%s/timeline.ndjson", dir);
+        FILE *out = fs_open_file(path);
+        if (out) {
+            timeline_emit_ndjson(ctx->timeline, out);
+            fclose(out);
+        }
+    }
+
+    if (formats & (ARTIFACT_TIMELINE_BINARY | ARTIFACT_TIMELINE_VARINT)) {
+        snprintf(path, sizeof(path), "%s/timeline.bin", dir);
+        FILE *out = fs_open_file(path);
+        if (out) {
+            timeline_emit_binary(
+                ctx->timeline, out,
+                (formats & ARTIFACT_TIMELINE_VARINT) ? TIMELINE_BIN_VARINT
+                                                     : 0);
+            fclose(out);
+        }
+    }
+}
+
+void artifact_emit_meta(
     const ArtifactContext *ctx,
-    const DiagnosticArtifact *diagnostics
+    char *run_dir,
+    size_t cap
 )
 {
-    char run_dir[512];
-
     fs_mkdir_if_missing(ctx->root);
-    snprintf(run_dir, sizeof(run_dir), "%s/%s", ctx->root, ctx->run_id);
+    snprintf(run_dir, cap, "%s/%s", ctx->root, ctx->run_id);
     fs_mkdir_if_missing(run_dir);
 
     emit_meta(ctx, run_dir);
+}
+
+void artifact_emit_all(
+    const ArtifactContext *ctx,
+    const DiagnosticArtifact *diagnostics
+)
+{
+    char run_dir[512];
+
+    artifact_emit_meta(ctx, run_dir, sizeof(run_dir));
     emit_diagnostics(diagnostics, run_dir);
 
     /* Timeline emission (first-class artifact) */
-    {
-        char path[512];
-        snprintf(path, sizeof(path), "%s/timeline.ndjson", run_dir);
-        FILE *out = fs_open_file(path);
-        if (out) {
-            timeline_emit_ndjson(ctx->world_head, out);
-            fclose(out);
-        }
-    }
+    emit_timelines(ctx, run_dir);
 }
 
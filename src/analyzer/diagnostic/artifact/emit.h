@@ -2,7 +2,7 @@
 #define LIMINAL_ARTIFACT_EMIT_H
 
 
-struct World;
+struct Timeline;
 struct Diagnostic;
 
 typedef struct DiagnosticArtifact {
@@ -10,17 +10,39 @@ typedef struct DiagnosticArtifact {
     size_t count;
 } DiagnosticArtifact;
 
+/* Timeline artifacts to write (ArtifactContext.timeline_formats) */
+#define ARTIFACT_TIMELINE_NDJSON 0x1u   /* timeline.ndjson */
+#define ARTIFACT_TIMELINE_BINARY 0x2u   /* timeline.bin */
+#define ARTIFACT_TIMELINE_VARINT 0x4u   /* timeline.bin delta+varint */
+
 typedef struct {
     const char   *root;
     const char   *run_id;
     const char   *input_path;
     unsigned long started_at;
 
-    const struct World *world_head;
+    const struct Timeline *timeline;
+
+    /* ARTIFACT_TIMELINE_* bits; 0 means NDJSON only */
+    unsigned timeline_formats;
 } ArtifactContext;
 
-DiagnosticArtifact analyze_diagnostics(struct World *head);
+/* `items` is NULL if analysis failed (out of memory) */
+DiagnosticArtifact analyze_diagnostics(const struct Timeline *tl);
+
+/* Release the items and their anchors */
+void diagnostic_artifact_free(DiagnosticArtifact *a);
 
+/*
+ * Create <root>/<run_id>/ and write meta.json only; `run_dir`
+ * receives the directory path. Used when the other artifacts
+ * come from the result cache.
+ */
+void artifact_emit_meta(
+    const ArtifactContext *ctx,
+    char *run_dir,
+    size_t cap
+);
 
 void artifact_emit_all(
     const ArtifactContext *ctx,
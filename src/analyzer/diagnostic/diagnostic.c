@@ -1,21 +1,26 @@
 #include "analyzer/analyzer.h"
 #include <stdlib.h>
 
-DiagnosticArtifact analyze_diagnostics(struct World *head)
+DiagnosticArtifact analyze_diagnostics(const struct Timeline *tl)
 {
-    Diagnostic *buf = calloc(256, sizeof(Diagnostic));
+    Diagnostic *buf = calloc(DIAGNOSTIC_CAP, sizeof(Diagnostic));
     size_t count = 0;
 
-    /* --- Canonical semantic path --- */
-    ConstraintArtifact constraints = analyze_constraints(head);
+    /* --- Canonical semantic path (single fused traversal) --- */
+    AnalysisResult analysis;
+    if (!buf || !analyze_timeline(tl, &analysis)) {
+        free(buf);
+        return (DiagnosticArtifact){ .items = NULL, .count = 0 };
+    }
     count += constraint_to_diagnostic(
-        &constraints,
+        &analysis.constraints,
         buf + count,
-        256 - count
+        DIAGNOSTIC_CAP - count
     );
+    analysis_result_free(&analysis);
 
     /* --- Temporary legacy path (shadowing only) --- */
-    // count += analyze_shadowing(head, buf + count, 256 - count);
+    // count += analyze_shadowing(head, buf + count, DIAGNOSTIC_CAP - count);
 
     return (DiagnosticArtifact){
         .items = buf,
@@ -23,6 +28,19 @@ DiagnosticArtifact analyze_diagnostics(struct World *head)
     };
 }
 
+void diagnostic_artifact_free(DiagnosticArtifact *a)
+{
+    if (!a) return;
+
+    for (size_t i = 0; i < a->count; i++) {
+        free(a->items[i].anchor);
+    }
+    free(a->items);
+
+    a->items = NULL;
+    a->count = 0;
+}
+
 const char *diagnostic_kind_name(DiagnosticKind k)
 {
     switch (k) {
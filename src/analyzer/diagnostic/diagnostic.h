@@ -30,6 +30,9 @@ typedef struct Diagnostic {
     struct SourceAnchor *anchor;
 } Diagnostic;
 
+/* Most diagnostics one run reports; the rest are dropped */
+#define DIAGNOSTIC_CAP 256
+
 
 const char *diagnostic_kind_name(DiagnosticKind k);
 
@@ -2,23 +2,53 @@
 #include <inttypes.h>
 
 #include "analyzer/analyzer.h"
+#include "common/common.h"
+
+/*
+ * Seed of the id hash. Bump it whenever the encoding below
+ * changes, so ids of different layouts never compare equal.
+ */
+#define DIAGNOSTIC_ID_SEED 0x4c494d4944000002ull   /* "LIMID", v2 */
+
+/* Little-endian, so the encoding is the same on every host */
+static uint8_t *put_le(uint8_t *p, uint64_t v, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+    return p + bytes;
+}
 
 /*
  * diagnostic_id_from_constraint
  *
- * Stable semantic identity for a diagnostic.
+ * Stable semantic identity for a diagnostic: hash64 over the
+ * canonical encoding
+ *
+ *   kind:4 spelling:8 function:8 ordinal:4
+ *
+ * Nothing positional goes in: no time, node, scope or storage id,
+ * all of which shift when code is added elsewhere, and no symbol,
+ * which depends on interning order. Code that does not involve
+ * this name in this function leaves the id alone.
  */
-DiagnosticId diagnostic_id_from_constraint(const Constraint *c)
+DiagnosticId diagnostic_id_from_constraint(const Constraint *c,
+                                           uint32_t ordinal)
 {
     DiagnosticId id = {0};
 
     if (!c)
         return id;
 
-    /* Simple structural hash — stable across runs */
-    id.value ^= (uint64_t)c->kind;
-    id.value ^= (uint64_t)c->time << 16;
-    id.value ^= (uint64_t)c->scope_id << 32;
+    uint8_t buf[24];
+    uint8_t *p = buf;
+
+    p = put_le(p, (uint64_t)c->kind, 4);
+    p = put_le(p, c->spelling, 8);
+    p = put_le(p, c->function, 8);
+    p = put_le(p, ordinal, 4);
+
+    id.value = hash64(buf, (size_t)(p - buf), DIAGNOSTIC_ID_SEED);
 
     return id;
 }
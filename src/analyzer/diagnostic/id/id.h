@@ -16,8 +16,13 @@ typedef struct DiagnosticId {
 
 /*
  * Derive a stable diagnostic identity from a constraint.
+ *
+ * A 64-bit hash of the kind, the spelling of the name, the
+ * spelling of the enclosing function and `ordinal`: how many
+ * earlier constraints of the run share those three.
  */
-DiagnosticId diagnostic_id_from_constraint(const Constraint *c);
+DiagnosticId diagnostic_id_from_constraint(const Constraint *c,
+                                           uint32_t ordinal);
 
 /*
  * Render a diagnostic id (human-readable, stable).
@@ -1,42 +1,46 @@
 #include "analyzer/diagnostic/diagnostic.h"
+#include "common/common.h"
 
+/*
+ * One record per diagnostic:
+ *
+ * {"id":"<hex16>","time":N,"kind":"<name>","scope":N,"prev_scope":N
+ *  [,"anchor":{"node":N,"line":N,"col":N}]}
+ */
 void diagnostic_project_ndjson(
     const DiagnosticArtifact *a,
     FILE *out
 )
 {
+    JsonWriter w;
+    json_writer_init(&w, out);
+
     for (size_t i = 0; i < a->count; i++) {
         const Diagnostic *d = &a->items[i];
 
-        fprintf(
-            out,
-            "{"
-            "\"id\":\"%016llx\","
-            "\"time\":%llu,"
-            "\"kind\":\"%s\","
-            "\"scope\":%llu,"
-            "\"prev_scope\":%llu",
-            (unsigned long long)d->id.value,
-            (unsigned long long)d->time,
-            diagnostic_kind_name(d->kind),
-            (unsigned long long)d->scope_id,
-            (unsigned long long)d->prev_scope
-        );
+        json_write_lit(&w, "{\"id\":\"");
+        json_write_hex64(&w, d->id.value);
+        json_write_lit(&w, "\",\"time\":");
+        json_write_u64(&w, d->time);
+        json_write_lit(&w, ",\"kind\":\"");
+        json_write_cstr(&w, diagnostic_kind_name(d->kind));
+        json_write_lit(&w, "\",\"scope\":");
+        json_write_u64(&w, d->scope_id);
+        json_write_lit(&w, ",\"prev_scope\":");
+        json_write_u64(&w, d->prev_scope);
 
         if (d->anchor) {
-            fprintf(
-                out,
-                ",\"anchor\":{"
-                "\"node\":%u,"
-                "\"line\":%u,"
-                "\"col\":%u"
-                "}",
-                d->anchor->node_id,
-                d->anchor->line,
-                d->anchor->col
-            );
+            json_write_lit(&w, ",\"anchor\":{\"node\":");
+            json_write_u64(&w, d->anchor->node_id);
+            json_write_lit(&w, ",\"line\":");
+            json_write_u64(&w, d->anchor->line);
+            json_write_lit(&w, ",\"col\":");
+            json_write_u64(&w, d->anchor->col);
+            json_write_lit(&w, "}");
         }
 
-        fprintf(out, "}\n");
+        json_write_lit(&w, "}\n");
     }
+
+    json_writer_flush(&w);
 }
@@ -1,47 +1,174 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "analyzer/diagnostic/diagnostic.h"
 #include "analyzer/diagnostic/serialize/serialize.h"
+#include "common/common.h"
 
-int diagnostic_deserialize_line(FILE *in, Diagnostic *out)
+/* Longest line diagnostic_deserialize_line accepts */
+#define DIAG_LINE_MAX 1024
+
+static int read_kind(JsonReader *r, DiagnosticKind *out)
 {
-    unsigned long long id;
-    unsigned kind;
-    unsigned long long time;
-    unsigned long long scope;
-    unsigned long long prev_scope;
-
-    int n = fscanf(
-        in,
-        "{"
-        "\"id\":\"%llx\","
-        "\"kind\":%u,"
-        "\"time\":%llu,"
-        "\"scope\":%llu,"
-        "\"prev_scope\":%llu"
-        "}",
-        &id,
-        &kind,
-        &time,
-        &scope,
-        &prev_scope
-    );
-
-    if (n != 5)
+    if (json_peek(r) == '"') {
+        JsonStr s;
+        if (!json_read_string(r, &s)) {
+            return 0;
+        }
+        for (int k = 0; k < DIAG_KIND_MAX; k++) {
+            if (json_str_eq(s, diagnostic_kind_name((DiagnosticKind)k))) {
+                *out = (DiagnosticKind)k;
+                return 1;
+            }
+        }
         return 0;
+    }
 
-    /* consume remainder of line */
-    int c;
-    while ((c = fgetc(in)) != '\n' && c != EOF) {}
-
-    out->id.value     = (uint64_t)id;
-    out->kind         = (DiagnosticKind)kind;
-    out->time         = (uint64_t)time;
-    out->scope_id     = (uint64_t)scope;
-    out->prev_scope   = (uint64_t)prev_scope;
-    out->anchor       = NULL; /* reconstructed later */
+    uint64_t v;
+    if (!json_read_u64(r, &v) || v >= DIAG_KIND_MAX) {
+        return 0;
+    }
+    *out = (DiagnosticKind)v;
+    return 1;
+}
 
+static int read_u32(JsonReader *r, uint32_t *out)
+{
+    uint64_t v;
+    if (!json_read_u64(r, &v) || v > UINT32_MAX) {
+        return 0;
+    }
+    *out = (uint32_t)v;
     return 1;
 }
+
+static int read_anchor(JsonReader *r, SourceAnchor *a)
+{
+    JsonStr key;
+
+    memset(a, 0, sizeof(*a));
+    if (!json_object_begin(r)) {
+        return 0;
+    }
+    while (json_object_next(r, &key)) {
+        int ok;
+        if (json_str_eq(key, "node"))      ok = read_u32(r, &a->node_id);
+        else if (json_str_eq(key, "line")) ok = read_u32(r, &a->line);
+        else if (json_str_eq(key, "col"))  ok = read_u32(r, &a->col);
+        else                               ok = json_skip(r);
+        if (!ok) {
+            return 0;
+        }
+    }
+    return !r->error;
+}
+
+int diagnostic_parse_json(
+    const char *line,
+    size_t len,
+    Diagnostic *out,
+    SourceAnchor *anchor
+)
+{
+    enum { HAVE_ID = 1, HAVE_KIND = 2, HAVE_TIME = 4 };
+    unsigned have = 0;
+    JsonReader r;
+    JsonStr key;
+
+    memset(out, 0, sizeof(*out));
+
+    json_reader_init(&r, line, len);
+    if (!json_object_begin(&r)) {
+        return 0;
+    }
+
+    while (json_object_next(&r, &key)) {
+        int ok;
+        if (json_str_eq(key, "id")) {
+            ok = json_read_hex64(&r, &out->id.value);
+            have |= HAVE_ID;
+        } else if (json_str_eq(key, "kind")) {
+            ok = read_kind(&r, &out->kind);
+            have |= HAVE_KIND;
+        } else if (json_str_eq(key, "time")) {
+            ok = json_read_u64(&r, &out->time);
+            have |= HAVE_TIME;
+        } else if (json_str_eq(key, "scope")) {
+            ok = json_read_u64(&r, &out->scope_id);
+        } else if (json_str_eq(key, "prev_scope")) {
+            ok = json_read_u64(&r, &out->prev_scope);
+        } else if (json_str_eq(key, "anchor") && anchor) {
+            ok = read_anchor(&r, anchor);
+            out->anchor = anchor;
+        } else {
+            ok = json_skip(&r);
+        }
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    return !r.error && json_at_end(&r) &&
+           have == (HAVE_ID | HAVE_KIND | HAVE_TIME);
+}
+
+int diagnostic_deserialize_line(FILE *in, Diagnostic *out)
+{
+    char line[DIAG_LINE_MAX];
+
+    for (;;) {
+        if (!fgets(line, sizeof(line), in)) {
+            return 0;
+        }
+
+        size_t len = strlen(line);
+        if (len == sizeof(line) - 1 && line[len - 1] != '\n') {
+            return 0; /* longer than any record */
+        }
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+            len--;
+        }
+        if (len > 0) {
+            return diagnostic_parse_json(line, len, out, NULL);
+        }
+    }
+}
+
+int diagnostic_read_ndjson(
+    FILE *in,
+    DiagnosticSink fn,
+    void *ctx,
+    size_t *line_no
+)
+{
+    NdjsonReader r;
+    const char *line;
+    size_t len;
+    int rc = 0;
+
+    ndjson_reader_init(&r, in);
+
+    while (ndjson_next_line(&r, &line, &len)) {
+        Diagnostic d;
+        SourceAnchor anchor;
+
+        if (!diagnostic_parse_json(line, len, &d, &anchor)) {
+            rc = 1;
+            break;
+        }
+        if (!fn(&d, ctx)) {
+            break;
+        }
+    }
+
+    if (rc == 0 && r.error) {
+        rc = 2;
+    }
+    if (line_no) {
+        *line_no = r.line_no;
+    }
+    ndjson_reader_free(&r);
+    return rc;
+}
@@ -1,10 +1,12 @@
 #ifndef LIMINAL_DIAGNOSTIC_SERIALIZE_H
 #define LIMINAL_DIAGNOSTIC_SERIALIZE_H
 
+#include <stddef.h>
 #include <stdio.h>
 
 struct DiagnosticArtifact;
 struct Diagnostic;
+struct SourceAnchor;
 
 
 /*
@@ -15,9 +17,30 @@ void diagnostic_serialize_ndjson(
     const DiagnosticArtifact *a
 );
 
+/*
+ * Parse one diagnostics.ndjson record (diagnostic_project_ndjson
+ * output). Members may come in any order and unknown ones are
+ * skipped. "id", "kind" and "time" are required; "kind" may be a
+ * name or its number. When the record has an "anchor", it is
+ * written to `anchor` and out->anchor points there; otherwise
+ * out->anchor is NULL.
+ *
+ * Returns 1 on success, 0 on a malformed record.
+ * Does NOT allocate.
+ */
+int diagnostic_parse_json(
+    const char *line,
+    size_t len,
+    struct Diagnostic *out,
+    struct SourceAnchor *anchor
+);
+
 /*
  * Deserialize a single diagnostic from an NDJSON stream.
  *
+ * Reads one line (blank lines are skipped). The anchor, if any, is
+ * dropped.
+ *
  * Returns:
  *   1 on success
  *   0 on EOF or parse failure
@@ -29,4 +52,22 @@ int diagnostic_deserialize_line(
     struct Diagnostic *out
 );
 
+/*
+ * Stream every record of `in` to `fn` in constant memory. The
+ * Diagnostic and its anchor are only valid during the call; `fn`
+ * returns 0 to stop early.
+ *
+ * Returns 0 when the input was read (or `fn` stopped), 1 on a
+ * malformed record, 2 on a read or allocation failure. `line`, if
+ * not NULL, receives the number of the offending line.
+ */
+typedef int (*DiagnosticSink)(const struct Diagnostic *d, void *ctx);
+
+int diagnostic_read_ndjson(
+    FILE *in,
+    DiagnosticSink fn,
+    void *ctx,
+    size_t *line
+);
+
 #endif /* LIMINAL_DIAGNOSTIC_SERIALIZE_H */
@@ -0,0 +1,685 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "analyzer/analyzer.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"
+#include "common/common.h"
+
+#define INC_NO_NODE UINT32_MAX
+
+/* First arena chunk of a function Universe; one is kept per function */
+#define INC_ARENA_SIZE 512
+
+struct IncrementalFunction {
+    /* Identity, independent of position */
+    uint64_t fingerprint;
+    uint32_t nodes;             /* program node excluded */
+
+    /* Position in the current program */
+    uint32_t fn_id;
+    uint32_t lo;                /* first node id */
+
+    /* Own history; steps 1..count-1 are the function's */
+    Universe *universe;
+    uint32_t *origin;           /* relative node of step t at [t - 1] */
+    size_t    origin_cap;
+
+    uint64_t scopes;            /* ids 1..scopes were used */
+    uint64_t storages;
+
+    /* Offsets into the program run; also what the function's own
+     * frames and storages have been rebased by */
+    uint64_t time_shift;
+    uint64_t scope_shift;
+    uint64_t storage_shift;
+
+    /* Storage of each DECLARE step, and the symbol its frames bind
+     * it to; `keys` holds the maps of frames re-keyed since (on
+     * the heap: maps keep its address, and `f` is moved) */
+    Storage **decl;
+    Symbol   *key;
+    size_t    decl_count;
+    Arena    *keys;
+
+    /* Relative ids; origin nodes kept as relative nodes */
+    Constraint *constraints;
+    uint32_t   *node;
+    size_t      constraint_count;
+};
+
+/* Per-run scratch, indexed by Symbol */
+typedef struct IncrementalScratch {
+    uint64_t *spell;
+    size_t    spell_cap;
+} IncrementalScratch;
+
+/* ------------------------------------------------------------
+ * Node layout
+ *
+ * A function's nodes are contiguous, from its first statement to
+ * its body block; only the first function also holds the program
+ * node. Relative ids skip it, so they do not depend on position.
+ * ------------------------------------------------------------ */
+
+static uint32_t node_rel(uint32_t lo, uint32_t prog, uint32_t id)
+{
+    return id - lo - (prog >= lo && prog < id);
+}
+
+static uint32_t node_abs(uint32_t lo, uint32_t prog, uint32_t rel)
+{
+    uint32_t id = lo + rel;
+    return id + (prog >= lo && prog <= id);
+}
+
+static void *origin_at(const ASTProgram *p, const IncrementalFunction *f,
+                       uint32_t rel)
+{
+    if (rel == INC_NO_NODE) {
+        return NULL;
+    }
+    return ast_node_get(p, node_abs(f->lo, p->root_id, rel));
+}
+
+/* ------------------------------------------------------------
+ * Fingerprints
+ * ------------------------------------------------------------ */
+
+static int spell_hashes(IncrementalScratch *s, const ASTProgram *p)
+{
+    const InternTable *t = &p->symbols;
+
+    if (t->count > s->spell_cap) {
+        uint64_t *np = realloc(s->spell, t->count * sizeof(*np));
+        if (!np) return 0;
+        s->spell = np;
+        s->spell_cap = t->count;
+    }
+
+    for (size_t sym = 1; sym < t->count; sym++) {
+        s->spell[sym] = intern_hash64(t, (Symbol)sym);
+    }
+    return 1;
+}
+
+/*
+ * Nodes are laid out in post order (a block after its statements),
+ * so kinds plus block sizes pin down the tree.
+ */
+static void fingerprint(const IncrementalScratch *s, const ASTProgram *p,
+                        IncrementalFunction *f, uint32_t body)
+{
+    uint64_t h = 0;
+    uint32_t n = 0;
+
+    for (uint32_t id = f->lo; id <= body; id++) {
+        if (id == p->root_id) {
+            continue;
+        }
+
+        const ASTNode *x = ast_node_get(p, id);
+        uint64_t v = 0;
+
+        switch (x->kind) {
+        case AST_VAR_DECL: v = s->spell[x->as.vdecl.name]; break;
+        case AST_VAR_USE:  v = s->spell[x->as.vuse.name];  break;
+        case AST_BLOCK:    v = x->as.block.stmt_count;     break;
+        case AST_RETURN:   v = (uint64_t)x->as.ret.value;  break;
+        default:           break;
+        }
+
+        h = hash64_mix(hash64_mix(h, (uint64_t)x->kind), v);
+        n++;
+    }
+
+    f->fingerprint = h;
+    f->nodes = n;
+}
+
+/* ------------------------------------------------------------
+ * Functions
+ * ------------------------------------------------------------ */
+
+static void fn_release(IncrementalFunction *f)
+{
+    universe_destroy(f->universe);
+    if (f->keys) {
+        arena_destroy(f->keys);
+        free(f->keys);
+    }
+    free(f->decl);
+    free(f->key);
+    free(f->origin);
+    free(f->constraints);
+    free(f->node);
+    memset(f, 0, sizeof(*f));
+}
+
+/* Bytes `f` holds between runs */
+static size_t fn_bytes(const IncrementalFunction *f)
+{
+    size_t bytes = f->origin_cap * sizeof(*f->origin) +
+                   f->constraint_count * (sizeof(Constraint) +
+                                          sizeof(*f->node)) +
+                   f->decl_count * (sizeof(*f->decl) + sizeof(*f->key)) +
+                   (f->keys ? sizeof(Arena) + f->keys->reserved : 0);
+    if (f->universe) {
+        const Universe *u = f->universe;
+        bytes += sizeof(*u) + u->scope_arena.reserved +
+                 u->var_arena.reserved + u->storage_arena.reserved +
+                 u->timeline.capacity * (sizeof(*u->timeline.kind) +
+                                         sizeof(*u->timeline.origin) +
+                                         sizeof(*u->timeline.info) +
+                                         sizeof(*u->timeline.scope));
+    }
+    return bytes;
+}
+
+/* Execute and analyze `f` alone */
+static int fn_execute(IncrementalFunction *f, const ASTProgram *p)
+{
+    if (!f->universe &&
+        !(f->universe = universe_create_sized(INC_ARENA_SIZE))) {
+        return 0;
+    }
+
+    Universe *u = f->universe;
+    if (!universe_reset(u) || !executor_run_function(u, p, f->fn_id)) {
+        return 0;
+    }
+
+    /* Kept until the function changes: drop the growth slack */
+    timeline_fit(&u->timeline);
+
+    /* Origins as relative nodes: the program is not kept */
+    const Timeline *tl = &u->timeline;
+    size_t steps = tl->count - 1;
+
+    if (steps > f->origin_cap) {
+        uint32_t *np = realloc(f->origin, steps * sizeof(*np));
+        if (!np) return 0;
+        f->origin = np;
+        f->origin_cap = steps;
+    }
+    for (size_t t = 1; t < tl->count; t++) {
+        const ASTNode *n = timeline_origin(tl, t);
+        f->origin[t - 1] = n ? node_rel(f->lo, p->root_id, n->id)
+                             : INC_NO_NODE;
+    }
+
+    f->scopes        = u->next_scope_id - 1;
+    f->storages      = u->next_storage_id - 1;
+    f->time_shift    = 0;
+    f->scope_shift   = 0;
+    f->storage_shift = 0;
+
+    /* ---- DECLARATIONS (to re-key and rebase the frames) ---- */
+    size_t decls = 0;
+    for (size_t t = 1; t < tl->count; t++) {
+        decls += timeline_kind(tl, t) == STEP_DECLARE;
+    }
+
+    free(f->decl);
+    free(f->key);
+    f->decl = malloc((decls ? decls : 1) * sizeof(*f->decl));
+    f->key  = malloc((decls ? decls : 1) * sizeof(*f->key));
+    f->decl_count = 0;
+    if (!f->decl || !f->key) return 0;
+
+    for (size_t t = 1; t < tl->count; t++) {
+        if (timeline_kind(tl, t) != STEP_DECLARE) {
+            continue;
+        }
+        const ASTNode *n = timeline_origin(tl, t);
+        Symbol name = n->as.vdecl.name;
+
+        f->key[f->decl_count]    = name;
+        f->decl[f->decl_count++] =
+            hashmap_get(timeline_scope(tl, t)->bindings, name);
+    }
+
+    /* ---- ANALYSIS (ids relative to the function) ---- */
+    AnalysisResult a;
+    if (!analyze_timeline(tl, &a)) {
+        return 0;
+    }
+
+    free(f->constraints);
+    free(f->node);
+    f->constraints      = a.constraints.items;
+    f->constraint_count = a.constraints.count;
+    f->node             = NULL;
+    a.constraints.items = NULL;
+    a.constraints.count = 0;
+    analysis_result_free(&a);
+
+    if (f->constraint_count) {
+        f->node = malloc(f->constraint_count * sizeof(*f->node));
+        if (!f->node) return 0;
+    }
+    for (size_t i = 0; i < f->constraint_count; i++) {
+        Constraint *c = &f->constraints[i];
+        f->node[i] = c->node_id ? node_rel(f->lo, p->root_id, c->node_id)
+                                : INC_NO_NODE;
+        free(c->anchor);
+        c->anchor = NULL;
+    }
+
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Matching
+ * ------------------------------------------------------------ */
+
+/*
+ * Claim an unclaimed previous function with `f`'s fingerprint;
+ * duplicates are handed out in program order. `slots` holds
+ * index + 1 of every previous function, open addressing.
+ */
+static IncrementalFunction *claim(IncrementalFunction *old,
+                                  const uint32_t *slots, size_t mask,
+                                  const IncrementalFunction *f)
+{
+    for (size_t i = f->fingerprint & mask; slots[i]; i = (i + 1) & mask) {
+        IncrementalFunction *o = &old[slots[i] - 1];
+        if (o->universe && o->fingerprint == f->fingerprint &&
+            o->nodes == f->nodes) {
+            return o;
+        }
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------
+ * Splicing
+ * ------------------------------------------------------------ */
+
+/*
+ * Move the function's storages to this position: ids by
+ * `storages`, declaration times by `time`.
+ */
+static void rebase_storages(IncrementalFunction *f, uint64_t time,
+                            uint64_t storages)
+{
+    uint64_t dt = time - f->time_shift;
+    uint64_t ds = storages - f->storage_shift;
+
+    if (dt == 0 && ds == 0) {
+        return;
+    }
+    for (size_t i = 0; i < f->decl_count; i++) {
+        f->decl[i]->id          += ds;
+        f->decl[i]->declared_at += dt;
+    }
+}
+
+/*
+ * Bind the frames to `p`'s symbols. Every parse renumbers them, so
+ * a reused function's maps may be keyed by another program's. They
+ * are rebuilt as the executor built them, one put per declaration
+ * onto the frame it extends, into `keys` (the executor's copies
+ * stay in the Universe arena, unused).
+ */
+static int rekey(IncrementalFunction *f, const ASTProgram *p)
+{
+    const Timeline *ft = &f->universe->timeline;
+    size_t i = 0;
+    int same = 1;
+
+    for (size_t t = 1; same && t < ft->count; t++) {
+        if (timeline_kind(ft, t) == STEP_DECLARE) {
+            const ASTNode *n = origin_at(p, f, f->origin[t - 1]);
+            same = n->as.vdecl.name == f->key[i++];
+        }
+    }
+    if (same) {
+        return 1;
+    }
+
+    if (!f->keys) {
+        if (!(f->keys = malloc(sizeof(Arena)))) return 0;
+        /* The executor's maps fit in its arena: one chunk will do */
+        arena_init(f->keys, f->universe->scope_arena.used);
+    }
+    arena_reset(f->keys);
+
+    i = 0;
+    for (size_t t = 1; t < ft->count; t++) {
+        if (timeline_kind(ft, t) != STEP_DECLARE) {
+            continue;
+        }
+        const ASTNode *n = origin_at(p, f, f->origin[t - 1]);
+        Scope *sc = timeline_scope(ft, t);
+        const HashMap *base = sc->parent->bindings
+                            ? sc->parent->bindings
+                            : hashmap_create(f->keys);
+
+        f->key[i] = n->as.vdecl.name;
+        sc->bindings = base ? hashmap_put(base, f->key[i], f->decl[i])
+                            : NULL;
+        if (!sc->bindings) {
+            return 0;
+        }
+        i++;
+    }
+    return 1;
+}
+
+static int splice(Incremental *inc, const ASTProgram *p)
+{
+    Universe *u = inc->universe;
+    ASTNode *prog = ast_node_get(p, p->root_id);
+
+    if (!universe_reset(u) || !universe_step(u, STEP_ENTER_PROGRAM, prog)) {
+        return 0;
+    }
+    u->timeline.symbols = &p->symbols;
+
+    uint64_t scopes = 0;
+    uint64_t storages = 0;
+
+    for (size_t i = 0; i < inc->fn_count; i++) {
+        IncrementalFunction *f = &inc->fns[i];
+        const Timeline *ft = &f->universe->timeline;
+
+        /* Frames carry their id: move them to this position */
+        if (f->scope_shift != scopes) {
+            uint64_t d = scopes - f->scope_shift;
+            for (size_t t = 1; t < ft->count; t++) {
+                StepKind k = timeline_kind(ft, t);
+                if (k == STEP_ENTER_SCOPE || k == STEP_DECLARE) {
+                    timeline_scope(ft, t)->id += d;
+                }
+            }
+        }
+
+        rebase_storages(f, u->timeline.count - 1, storages);
+        if (!rekey(f, p)) {
+            return 0;
+        }
+
+        f->time_shift    = u->timeline.count - 1;
+        f->scope_shift   = scopes;
+        f->storage_shift = storages;
+
+        for (size_t t = 1; t < ft->count; t++) {
+            StepKind k = timeline_kind(ft, t);
+            uint64_t info = timeline_info(ft, t);
+
+            switch (k) {
+            case STEP_ENTER_SCOPE:
+            case STEP_EXIT_SCOPE:
+                info += scopes;
+                break;
+            case STEP_DECLARE:
+                info += storages;
+                break;
+            case STEP_USE:
+                if (info != UINT64_MAX) info += storages;
+                break;
+            default:
+                break;
+            }
+
+            if (!timeline_append(&u->timeline, k,
+                                 origin_at(p, f, f->origin[t - 1]),
+                                 info, timeline_scope(ft, t))) {
+                return 0;
+            }
+        }
+
+        scopes   += f->scopes;
+        storages += f->storages;
+    }
+
+    if (!universe_step(u, STEP_EXIT_PROGRAM, prog)) {
+        return 0;
+    }
+
+    u->next_scope_id   = scopes + 1;
+    u->next_storage_id = storages + 1;
+    return 1;
+}
+
+static int is_use_constraint(const Constraint *c)
+{
+    return c->kind == CONSTRAINT_USE_REQUIRES_DECLARATION;
+}
+
+/*
+ * Rebase the function constraints in program order, variable ones
+ * first, under the same caps as a whole-program analysis.
+ */
+static int merge_diagnostics(Incremental *inc, const ASTProgram *p)
+{
+    Constraint merged[2 * CONSTRAINT_RULE_CAP];
+    size_t n = 0;
+
+    for (int uses = 1; uses >= 0; uses--) {
+        size_t taken = 0;
+
+        for (size_t i = 0; i < inc->fn_count; i++) {
+            const IncrementalFunction *f = &inc->fns[i];
+            const ASTNode *fn = ast_node_get(p, f->fn_id);
+
+            for (size_t j = 0; j < f->constraint_count; j++) {
+                const Constraint *c = &f->constraints[j];
+                if (is_use_constraint(c) != uses ||
+                    taken == CONSTRAINT_RULE_CAP) {
+                    continue;
+                }
+
+                Constraint m = *c;
+                m.time += f->time_shift;
+                if (m.scope_id) m.scope_id += f->scope_shift;
+                if (m.storage_id != UINT64_MAX) {
+                    m.storage_id += f->storage_shift;
+                }
+
+                /* Symbols are the program's; re-read the name too, and
+                 * the function's (matching ignores function names) */
+                const ASTNode *o = origin_at(p, f, f->node[j]);
+                m.node_id = o ? o->id : 0;
+                if (o) {
+                    m.name = is_use_constraint(c) ? o->as.vuse.name
+                                                  : o->as.vdecl.name;
+                }
+                m.spelling = intern_hash64(&p->symbols, m.name);
+                m.function = intern_hash64(&p->symbols, fn->as.fn.name);
+                m.anchor = is_use_constraint(c)
+                         ? NULL : anchor_from_origin((void *)o);
+
+                merged[n++] = m;
+                taken++;
+            }
+        }
+    }
+
+    Diagnostic *buf = calloc(DIAGNOSTIC_CAP, sizeof(Diagnostic));
+    if (!buf) {
+        for (size_t i = 0; i < n; i++) {
+            free(merged[i].anchor);
+        }
+        return 0;
+    }
+
+    ConstraintArtifact all = { .items = merged, .count = n };
+    inc->diagnostics = (DiagnosticArtifact){
+        .items = buf,
+        .count = constraint_to_diagnostic(&all, buf, DIAGNOSTIC_CAP)
+    };
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Session
+ * ------------------------------------------------------------ */
+
+Incremental *incremental_create(void)
+{
+    Incremental *inc = calloc(1, sizeof(Incremental));
+    if (!inc) {
+        return NULL;
+    }
+
+    inc->universe = universe_create();
+    if (!inc->universe) {
+        free(inc);
+        return NULL;
+    }
+    return inc;
+}
+
+static void incremental_clear(Incremental *inc)
+{
+    for (size_t i = 0; i < inc->fn_count; i++) {
+        fn_release(&inc->fns[i]);
+    }
+    free(inc->fns);
+    inc->fns = NULL;
+    inc->fn_count = 0;
+
+    diagnostic_artifact_free(&inc->diagnostics);
+    universe_reset(inc->universe);
+}
+
+void incremental_destroy(Incremental *inc)
+{
+    if (!inc) {
+        return;
+    }
+    incremental_clear(inc);
+    universe_destroy(inc->universe);
+    free(inc);
+}
+
+int incremental_run(Incremental *inc, const ASTProgram *p)
+{
+    if (!inc || !p || p->root_id == 0) {
+        return 0;
+    }
+
+    IncrementalScratch s = {0};
+    IncrementalFunction *fns = NULL;
+    uint32_t *slots = NULL;
+    size_t n = 0;
+
+    diagnostic_artifact_free(&inc->diagnostics);
+    inc->functions = 0;
+    inc->reanalyzed = 0;
+    inc->retained = 0;
+
+    /* ---- FUNCTIONS OF THE NEW PROGRAM ---- */
+    for (uint32_t id = 1; id <= p->count; id++) {
+        n += ast_node_get(p, id)->kind == AST_FUNCTION;
+    }
+
+    fns = calloc(n ? n : 1, sizeof(*fns));
+    if (!fns || !spell_hashes(&s, p)) {
+        goto fail;
+    }
+
+    uint32_t lo = 1;
+    size_t k = 0;
+    for (uint32_t id = 1; id <= p->count; id++) {
+        const ASTNode *x = ast_node_get(p, id);
+        if (x->kind != AST_FUNCTION) {
+            continue;
+        }
+
+        IncrementalFunction *f = &fns[k++];
+        f->fn_id = id;
+        f->lo    = lo;
+        fingerprint(&s, p, f, x->as.fn.body_id);
+        lo = x->as.fn.body_id + 1;
+    }
+
+    /* ---- MATCH AGAINST THE PREVIOUS RUN ---- */
+    size_t cap = 16;
+    while (cap < inc->fn_count * 2) cap *= 2;
+
+    slots = calloc(cap, sizeof(*slots));
+    if (!slots) {
+        goto fail;
+    }
+    for (size_t i = 0; i < inc->fn_count; i++) {
+        size_t j = inc->fns[i].fingerprint & (cap - 1);
+        while (slots[j]) j = (j + 1) & (cap - 1);
+        slots[j] = (uint32_t)(i + 1);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        IncrementalFunction *o = claim(inc->fns, slots, cap - 1, &fns[i]);
+        if (!o) {
+            continue;
+        }
+
+        /* Keep the new position, take the results */
+        uint32_t fn_id = fns[i].fn_id, at = fns[i].lo;
+        fns[i] = *o;
+        fns[i].fn_id = fn_id;
+        fns[i].lo = at;
+        memset(o, 0, sizeof(*o));
+    }
+
+    /* ---- EXECUTE THE REST (reusing unclaimed buffers) ---- */
+    size_t spare = 0;
+    for (size_t i = 0; i < n; i++) {
+        IncrementalFunction *f = &fns[i];
+        if (f->universe) {
+            continue;
+        }
+
+        while (spare < inc->fn_count && !inc->fns[spare].universe) spare++;
+        if (spare < inc->fn_count) {
+            IncrementalFunction *o = &inc->fns[spare++];
+            f->universe   = o->universe;
+            f->origin     = o->origin;
+            f->origin_cap = o->origin_cap;
+            o->universe   = NULL;
+            o->origin     = NULL;
+            fn_release(o);
+        }
+
+        if (!fn_execute(f, p)) {
+            fn_release(f);
+            goto fail;
+        }
+        inc->reanalyzed++;
+    }
+
+    for (size_t i = 0; i < inc->fn_count; i++) {
+        fn_release(&inc->fns[i]);
+    }
+    free(inc->fns);
+    inc->fns = fns;
+    inc->fn_count = n;
+    fns = NULL;
+
+    /* ---- SPLICE ---- */
+    if (!splice(inc, p) || !merge_diagnostics(inc, p)) {
+        goto fail;
+    }
+
+    inc->functions = n;
+    for (size_t i = 0; i < n; i++) {
+        inc->retained += fn_bytes(&inc->fns[i]);
+    }
+    free(slots);
+    free(s.spell);
+    return 1;
+
+fail:
+    if (fns) {
+        for (size_t i = 0; i < n; i++) {
+            fn_release(&fns[i]);
+        }
+        free(fns);
+    }
+    free(slots);
+    free(s.spell);
+    incremental_clear(inc);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#ifndef LIMINAL_ANALYZER_INCREMENTAL_H
+#define LIMINAL_ANALYZER_INCREMENTAL_H
+
+#include <stddef.h>
+
+#include "../diagnostic/diagnostic.h"
+
+struct Universe;
+struct ASTProgram;
+
+/*
+ * Incremental analysis
+ *
+ * Re-analyzes a program after an edit by executing and analyzing
+ * only the functions that changed.
+ *
+ * Functions share nothing at run time (each starts with no active
+ * scope), so a function's steps and constraints depend only on its
+ * own body, up to where time, scope ids and storage ids start.
+ * Each function is therefore executed into its own Universe and
+ * analyzed there, with ids relative to the function. A run:
+ *
+ *   1. fingerprints every function of the new program: node kinds,
+ *      block sizes and identifier spellings, not positions or names;
+ *   2. reuses the previous result of a function with the same
+ *      fingerprint, executing and analyzing only the others;
+ *   3. splices the function timelines into the program timeline
+ *      and merges their constraints, rebasing time, node, scope and
+ *      storage ids. Reused scope frames are rebased too, and their
+ *      bindings re-keyed when the new parse numbered the symbols
+ *      differently.
+ *
+ * The history (steps, infos, scope frames and what they bind) and
+ * diagnostics are identical to executor_run plus
+ * analyze_diagnostics over the whole program, so diagnostic ids do
+ * not depend on which functions were reused. Ids carry no position
+ * either, so an unchanged function keeps its diagnostics' ids when
+ * others are edited, added or moved.
+ *
+ * Matching is structural, so one session may be fed any sequence
+ * of programs (an editor saving different files, say); there is
+ * simply less to reuse.
+ */
+
+typedef struct IncrementalFunction IncrementalFunction;
+
+typedef struct Incremental {
+    /*
+     * Program history of the last run. The scope column points at
+     * frames owned by the function Universes, keyed by the symbols
+     * of the program passed to incremental_run; origins and symbols
+     * point into that program, which must outlive any use of it.
+     * The next run may rebase and re-key the frames in place.
+     */
+    struct Universe *universe;
+
+    /* Diagnostics of the last run (owned by the session) */
+    DiagnosticArtifact diagnostics;
+
+    /* Functions of the last run, in program order */
+    IncrementalFunction *fns;
+    size_t               fn_count;
+
+    /* Last run: functions in the program, and how many were redone */
+    size_t functions;
+    size_t reanalyzed;
+
+    /* Bytes the function results hold until the next run */
+    size_t retained;
+} Incremental;
+
+Incremental *incremental_create(void);
+void         incremental_destroy(Incremental *inc);
+
+/*
+ * Analyze `ast`, reusing whatever the previous run computed for
+ * unchanged functions. Returns 0 if the program has no root or on
+ * allocation failure; the next run then starts from scratch.
+ */
+int incremental_run(Incremental *inc, const struct ASTProgram *ast);
+
+#endif /* LIMINAL_ANALYZER_INCREMENTAL_H */
@@ -1,64 +1,142 @@
 #include <stdint.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "analyzer/analyzer.h"
 
 #include "executor/executor.h"
 
+/* Scope ids beyond this are not from the executor's counter */
+#define SCOPE_INDEX_MAX_ID ((uint64_t)1 << 32)
+
+int scope_index_put(ScopeIndex *ix, uint64_t scope_id, size_t slot)
+{
+    if (scope_id >= SCOPE_INDEX_MAX_ID) {
+        return 0;
+    }
+
+    if (scope_id >= ix->cap) {
+        size_t cap = ix->cap ? ix->cap : 64;
+        while (cap <= scope_id) {
+            cap *= 2;
+        }
+
+        size_t *slots = realloc(ix->slots, cap * sizeof(*slots));
+        if (!slots) {
+            return 0;
+        }
+
+        memset(slots + ix->cap, 0, (cap - ix->cap) * sizeof(*slots));
+        ix->slots = slots;
+        ix->cap = cap;
+    }
+
+    ix->slots[scope_id] = slot + 1;
+    return 1;
+}
+
+size_t scope_index_get(const ScopeIndex *ix, uint64_t scope_id)
+{
+    if (!ix || scope_id >= ix->cap || ix->slots[scope_id] == 0) {
+        return SCOPE_INDEX_NONE;
+    }
+
+    return ix->slots[scope_id] - 1;
+}
+
+void scope_index_clear(ScopeIndex *ix, uint64_t scope_id)
+{
+    if (scope_id < ix->cap) {
+        ix->slots[scope_id] = 0;
+    }
+}
+
+void scope_index_free(ScopeIndex *ix)
+{
+    free(ix->slots);
+    ix->slots = NULL;
+    ix->cap = 0;
+}
+
 /*
  * We derive scope lifetimes purely from Steps:
  *  - STEP_ENTER_SCOPE: open lifetime
  *  - STEP_EXIT_SCOPE : close lifetime
  *
  * Step->info carries the scope id for both enter and exit.
+ * Every ENTER hands out a fresh id, so each id owns at most one
+ * lifetime and the index finds it directly.
  */
-size_t lifetime_collect_scopes(struct World *head,
-                               ScopeLifetime *out,
-                               size_t cap)
+static void on_step(void *state, const PassStep *s)
 {
-    if (!head || !out || cap == 0) {
-        return 0;
+    ScopeLifetimeCollector *c = state;
+
+    if (c->truncated) {
+        return;
     }
 
-    size_t n = 0;
+    if (s->kind == STEP_ENTER_SCOPE) {
+        if (c->count >= c->cap) {
+            c->truncated = 1; /* truncate for now */
+            return;
+        }
+
+        size_t i = c->count++;
+        ScopeLifetime *lt = &c->out[i];
+        lt->scope_id      = s->info;
+        lt->enter_time    = s->time;
+        lt->exit_time     = UINT64_MAX;
+        lt->enter_origin  = s->origin;
+        lt->exit_origin   = NULL;
 
-    Trace t = trace_begin(head);
-    while (trace_is_valid(&t)) {
-        World *w = trace_current(&t);
-        if (!w || !w->step) {
-            trace_next(&t);
-            continue;
+        scope_index_put(&c->index, s->info, i);
+    } else {
+        /* close the open lifetime with matching scope_id */
+        size_t i = scope_index_get(&c->index, s->info);
+        if (i == SCOPE_INDEX_NONE) {
+            return;
         }
 
-        Step *s = w->step;
-
-        if (s->kind == STEP_ENTER_SCOPE) {
-            if (n >= cap) {
-                return n; /* truncate for now */
-            }
-
-            out[n].scope_id      = s->info;
-            out[n].enter_time    = w->time;
-            out[n].exit_time     = UINT64_MAX;
-            out[n].enter_origin  = s->origin;
-            out[n].exit_origin   = NULL;
-            n++;
-        } else if (s->kind == STEP_EXIT_SCOPE) {
-            /* close the most recent open lifetime with matching scope_id */
-            uint64_t sid = s->info;
-
-            for (size_t i = n; i > 0; i--) {
-                ScopeLifetime *lt = &out[i - 1];
-                if (lt->scope_id == sid && lt->exit_time == UINT64_MAX) {
-                    lt->exit_time   = w->time;
-                    lt->exit_origin = s->origin;
-                    break;
-                }
-            }
+        ScopeLifetime *lt = &c->out[i];
+        if (lt->exit_time == UINT64_MAX) {
+            lt->exit_time   = s->time;
+            lt->exit_origin = s->origin;
         }
+    }
+}
+
+AnalyzerPass scope_lifetime_pass(ScopeLifetimeCollector *c)
+{
+    return (AnalyzerPass){
+        .name    = "scope-lifetimes",
+        .state   = c,
+        .kinds   = PASS_KIND(STEP_ENTER_SCOPE) | PASS_KIND(STEP_EXIT_SCOPE),
+        .on_step = on_step
+    };
+}
+
+void scope_lifetime_collector_free(ScopeLifetimeCollector *c)
+{
+    scope_index_free(&c->index);
+}
 
-        trace_next(&t);
+size_t lifetime_collect_scopes(const struct Timeline *tl,
+                               ScopeLifetime *out,
+                               size_t cap)
+{
+    if (!tl || !out || cap == 0) {
+        return 0;
     }
 
-    return n;
+    ScopeLifetimeCollector c = { .out = out, .cap = cap };
+
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, scope_lifetime_pass(&c));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
+
+    scope_lifetime_collector_free(&c);
+    return c.count;
 }
@@ -4,7 +4,9 @@
 #include <stdint.h>
 #include <stddef.h>
 
-struct World;
+#include "../pass/pass.h"
+
+struct Timeline;
 
 typedef struct ScopeLifetime {
     uint64_t scope_id;
@@ -14,14 +16,61 @@ typedef struct ScopeLifetime {
     void    *exit_origin;
 } ScopeLifetime;
 
+/*
+ * ScopeIndex
+ *
+ * Dense map from scope id to a slot number.
+ * The executor hands out scope ids sequentially from 1,
+ * so a plain array indexed by id stays compact.
+ */
+typedef struct ScopeIndex {
+    size_t *slots;   /* slot + 1; 0 = empty */
+    size_t cap;
+} ScopeIndex;
+
+#define SCOPE_INDEX_NONE SIZE_MAX
+
+/* Returns 0 on allocation failure or an implausibly large id */
+int scope_index_put(ScopeIndex *ix, uint64_t scope_id, size_t slot);
+
+/* SCOPE_INDEX_NONE when absent */
+size_t scope_index_get(const ScopeIndex *ix, uint64_t scope_id);
+
+void scope_index_clear(ScopeIndex *ix, uint64_t scope_id);
+void scope_index_free(ScopeIndex *ix);
+
+/*
+ * ScopeLifetimeCollector
+ *
+ * Caller-provided sink for the scope lifetime pass.
+ * `count` grows as scopes are entered; entries are closed in place.
+ * Once `cap` is hit the pass stops and sets `truncated`.
+ *
+ * `index` maps scope id -> entry in `out`; it is built by the pass
+ * and released with scope_lifetime_collector_free().
+ */
+typedef struct ScopeLifetimeCollector {
+    ScopeLifetime *out;
+    size_t cap;
+    size_t count;
+    int truncated;
+
+    ScopeIndex index;
+} ScopeLifetimeCollector;
+
 /*
  * Collect scope lifetimes into `out`.
  *
  * Returns number of lifetimes written (<= cap).
  * If cap is too small, it truncates (for now).
  */
-size_t lifetime_collect_scopes(struct World *head,
+size_t lifetime_collect_scopes(const struct Timeline *tl,
                                ScopeLifetime *out,
                                size_t cap);
 
+AnalyzerPass scope_lifetime_pass(ScopeLifetimeCollector *c);
+
+/* Releases the index only; `out` belongs to the caller */
+void scope_lifetime_collector_free(ScopeLifetimeCollector *c);
+
 #endif /* LIMINAL_LIFETIME_H */
@@ -0,0 +1,122 @@
+#include <stdlib.h>
+
+#include "analyzer/analyzer.h"
+#include "executor/executor.h"
+
+void pass_manager_init(PassManager *pm)
+{
+    pm->count = 0;
+    pm->stack = NULL;
+    pm->depth = 0;
+    pm->stack_cap = 0;
+    pm->traversals = 0;
+}
+
+void pass_manager_free(PassManager *pm)
+{
+    free(pm->stack);
+    pm->stack = NULL;
+    pm->depth = 0;
+    pm->stack_cap = 0;
+}
+
+int pass_manager_add(PassManager *pm, AnalyzerPass pass)
+{
+    if (pm->count >= PASS_MAX) {
+        return 0;
+    }
+
+    pm->passes[pm->count++] = pass;
+    return 1;
+}
+
+static int stack_push(PassManager *pm, uint64_t id)
+{
+    if (pm->depth == pm->stack_cap) {
+        size_t cap = pm->stack_cap ? pm->stack_cap * 2 : 32;
+        uint64_t *s = realloc(pm->stack, cap * sizeof(*s));
+        if (!s) {
+            return 0;
+        }
+        pm->stack = s;
+        pm->stack_cap = cap;
+    }
+
+    pm->stack[pm->depth++] = id;
+    return 1;
+}
+
+/*
+ * Walk the timeline once, fanning each step out to every
+ * interested pass, then update the shared scope stack and
+ * enclosing function.
+ */
+int pass_manager_run(PassManager *pm, const Timeline *tl)
+{
+    if (!pm || !tl) {
+        return 0;
+    }
+
+    pm->depth = 0;
+    pm->traversals++;
+
+    PassStep s = {
+        .tl = tl,
+        .prev_scope = NULL,
+        .function = NULL
+    };
+
+    for (size_t t = 0; t < tl->count; t++) {
+        s.time   = t;
+        s.kind   = timeline_kind(tl, t);
+        s.origin = timeline_origin(tl, t);
+        s.info   = timeline_info(tl, t);
+        s.scope  = timeline_scope(tl, t);
+
+        s.scope_stack = pm->stack;
+        s.scope_depth = pm->depth;
+
+        uint32_t bit = PASS_KIND(s.kind);
+
+        for (size_t i = 0; i < pm->count; i++) {
+            const AnalyzerPass *p = &pm->passes[i];
+            if (!p->kinds || (p->kinds & bit)) {
+                p->on_step(p->state, &s);
+            }
+        }
+
+        if (s.kind == STEP_ENTER_SCOPE) {
+            if (!stack_push(pm, s.info)) {
+                return 0;
+            }
+        } else if (s.kind == STEP_EXIT_SCOPE) {
+            if (pm->depth && pm->stack[pm->depth - 1] == s.info) {
+                pm->depth--;
+            }
+        } else if (s.kind == STEP_ENTER_FUNCTION) {
+            s.function = s.origin;
+        } else if (s.kind == STEP_EXIT_FUNCTION) {
+            s.function = NULL;
+        }
+
+        s.prev_scope = s.scope;
+    }
+
+    /* End of time */
+    s.time   = tl->count;
+    s.kind   = STEP_UNKNOWN;
+    s.origin = NULL;
+    s.info   = 0;
+    s.scope  = s.prev_scope;
+    s.scope_stack = pm->stack;
+    s.scope_depth = pm->depth;
+
+    for (size_t i = 0; i < pm->count; i++) {
+        const AnalyzerPass *p = &pm->passes[i];
+        if (p->on_end) {
+            p->on_end(p->state, &s);
+        }
+    }
+
+    return 1;
+}
@@ -0,0 +1,91 @@
+#ifndef LIMINAL_ANALYZER_PASS_H
+#define LIMINAL_ANALYZER_PASS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../../executor/timeline/timeline.h"
+
+struct Scope;
+
+/*
+ * PassStep
+ *
+ * What every pass sees for one timeline entry.
+ *
+ * The scope stack is shared by all passes and reflects the state
+ * BEFORE this step: ids of scopes entered and not yet exited,
+ * innermost last. An EXIT only pops when it matches the top.
+ * `function` likewise is the origin of the ENTER_FUNCTION not yet
+ * exited (functions do not nest), NULL outside any function.
+ *
+ * After the last entry, `on_end` receives a PassStep with
+ * time == timeline count, kind STEP_UNKNOWN and the final stack.
+ */
+typedef struct PassStep {
+    const Timeline *tl;
+
+    uint64_t time;
+    StepKind kind;
+    void    *origin;
+    uint64_t info;
+
+    struct Scope *scope;        /* active after the step */
+    struct Scope *prev_scope;   /* active before the step */
+
+    const uint64_t *scope_stack;
+    size_t scope_depth;
+
+    void *function;
+} PassStep;
+
+/*
+ * AnalyzerPass
+ *
+ * A rule expressed as callbacks over the timeline.
+ * `state` is owned by the caller and passed back verbatim.
+ *
+ * `kinds` filters which steps reach `on_step`
+ * (PASS_KIND mask; 0 means every step).
+ */
+typedef struct AnalyzerPass {
+    const char *name;
+    void *state;
+    uint32_t kinds;
+
+    void (*on_step)(void *state, const PassStep *s);
+    void (*on_end)(void *state, const PassStep *s);   /* optional */
+} AnalyzerPass;
+
+#define PASS_KIND(k) (1u << (k))
+#define PASS_MAX     16
+
+/*
+ * PassManager
+ *
+ * Drives every registered pass in ONE traversal.
+ * Passes run in registration order on each step.
+ */
+typedef struct PassManager {
+    AnalyzerPass passes[PASS_MAX];
+    size_t count;
+
+    /* Shared scope stack */
+    uint64_t *stack;
+    size_t depth;
+    size_t stack_cap;
+
+    /* Full timeline walks performed (for benchmarking) */
+    size_t traversals;
+} PassManager;
+
+void pass_manager_init(PassManager *pm);
+void pass_manager_free(PassManager *pm);
+
+/* Returns 0 when PASS_MAX is exceeded */
+int pass_manager_add(PassManager *pm, AnalyzerPass pass);
+
+/* Returns 0 on allocation failure (results are then partial) */
+int pass_manager_run(PassManager *pm, const Timeline *tl);
+
+#endif /* LIMINAL_ANALYZER_PASS_H */
@@ -0,0 +1,113 @@
+#include <stdlib.h>
+
+#include "analyzer/analyzer.h"
+#include "analyzer/constraint/engine/engine.h"
+#include "analyzer/constraint/variable/variable.h"
+#include "analyzer/constraint/decleration/declaration.h"
+#include "executor/executor.h"
+
+int analyze_timeline(const struct Timeline *tl, AnalysisResult *out)
+{
+    AnalysisResult r = {0};
+
+    *out = r;
+    if (!tl) {
+        return 0;
+    }
+
+    /* At most one record per step for every per-step sink */
+    size_t n = tl->count ? tl->count : 1;
+
+    ConstraintCollector var = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .cap   = CONSTRAINT_RULE_CAP
+    };
+    ConstraintCollector decl = {
+        .items = calloc(CONSTRAINT_RULE_CAP, sizeof(Constraint)),
+        .cap   = CONSTRAINT_RULE_CAP
+    };
+
+    ScopeLifetimeCollector scopes = {
+        .out = malloc(n * sizeof(ScopeLifetime)),
+        .cap = n
+    };
+    VariableLifetimeCollector vars = {
+        .out = malloc(n * sizeof(VariableLifetime)),
+        .cap = n
+    };
+    UseCollector uses = {
+        .lifetimes = scopes.out,
+        .index     = &scopes.index,
+        .out       = malloc(n * sizeof(UseReport)),
+        .cap       = n
+    };
+    ScopeValidator validator = {
+        .out = malloc(n * sizeof(ScopeViolation)),
+        .cap = n
+    };
+
+    if (!var.items || !decl.items || !scopes.out || !vars.out ||
+        !uses.out || !validator.out) {
+        free(var.items);
+        free(decl.items);
+        free(scopes.out);
+        free(vars.out);
+        free(uses.out);
+        free(validator.out);
+        return 0;
+    }
+
+    /* Registration order = per-step execution order */
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, variable_constraint_pass(&var));
+    pass_manager_add(&pm, declaration_constraint_pass(&decl));
+    pass_manager_add(&pm, scope_lifetime_pass(&scopes));
+    pass_manager_add(&pm, variable_lifetime_pass(&vars));
+    pass_manager_add(&pm, use_pass(&uses));
+    pass_manager_add(&pm, scope_validate_pass(&validator));
+    int ok = pass_manager_run(&pm, tl);
+
+    r.traversals = pm.traversals;
+    pass_manager_free(&pm);
+    scope_lifetime_collector_free(&scopes);
+    variable_lifetime_collector_free(&vars);
+
+    if (!ok) {
+        free(var.items);
+        free(decl.items);
+        free(scopes.out);
+        free(vars.out);
+        free(uses.out);
+        free(validator.out);
+        return 0;
+    }
+
+    r.constraints     = constraint_merge(&var, &decl);
+    r.scopes          = scopes.out;
+    r.scope_count     = scopes.count;
+    r.variables       = vars.out;
+    r.variable_count  = vars.count;
+    r.uses            = uses.out;
+    r.use_count       = uses.count;
+    r.violations      = validator.out;
+    r.violation_count = validator.count;
+
+    *out = r;
+    return 1;
+}
+
+void analysis_result_free(AnalysisResult *r)
+{
+    if (!r) {
+        return;
+    }
+
+    free(r->constraints.items);
+    free(r->scopes);
+    free(r->variables);
+    free(r->uses);
+    free(r->violations);
+
+    *r = (AnalysisResult){0};
+}
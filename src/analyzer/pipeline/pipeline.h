@@ -0,0 +1,54 @@
+#ifndef LIMINAL_ANALYZER_PIPELINE_H
+#define LIMINAL_ANALYZER_PIPELINE_H
+
+#include <stddef.h>
+
+#include "../constraint/constraint.h"
+#include "../lifetime/lifetime.h"
+#include "../use/use.h"
+#include "../validate/validate.h"
+#include "../variable_lifetime/variable_lifetime.h"
+
+struct Timeline;
+
+/*
+ * AnalysisResult
+ *
+ * Everything the analyzer derives from one timeline.
+ * Owns its buffers; release with analysis_result_free().
+ */
+typedef struct AnalysisResult {
+    /* Variable rules first, then declaration rules */
+    ConstraintArtifact constraints;
+
+    ScopeLifetime *scopes;
+    size_t scope_count;
+
+    VariableLifetime *variables;
+    size_t variable_count;
+
+    UseReport *uses;
+    size_t use_count;
+
+    ScopeViolation *violations;
+    size_t violation_count;
+
+    /* Timeline walks it took (always 1; for benchmarking) */
+    size_t traversals;
+} AnalysisResult;
+
+/*
+ * Run every analyzer rule in a single traversal.
+ *
+ * Results are identical to calling each rule's entry point
+ * separately. Lifetime, use and violation buffers are sized to
+ * the timeline, so they never truncate.
+ *
+ * Returns 0 on allocation failure; `out` is then left empty
+ * rather than holding partial results.
+ */
+int analyze_timeline(const struct Timeline *tl, AnalysisResult *out);
+
+void analysis_result_free(AnalysisResult *r);
+
+#endif /* LIMINAL_ANALYZER_PIPELINE_H */
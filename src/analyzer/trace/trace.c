@@ -5,64 +5,57 @@
 /*
  * Create a Trace starting at the beginning of time.
  */
-Trace trace_begin(struct World *head)
+Trace trace_begin(const Timeline *tl)
 {
     Trace t;
-    t.current = head;
+    t.tl = tl;
+    t.index = 0;
     return t;
 }
 
 /*
  * Create a Trace starting at the end of time.
+ * An empty timeline yields an invalid Trace.
  */
-Trace trace_end(struct World *tail)
+Trace trace_end(const Timeline *tl)
 {
     Trace t;
-    t.current = tail;
+    t.tl = tl;
+    t.index = (tl && tl->count) ? tl->count - 1 : SIZE_MAX;
     return t;
 }
 
-/*
- * Get the current World.
- */
-struct World *trace_current(Trace *t)
-{
-    if (!t) {
-        return NULL;
-    }
-    return t->current;
-}
-
 /*
  * Advance the Trace forward in time.
  */
-struct World *trace_next(Trace *t)
+int trace_next(Trace *t)
 {
-    if (!t || !t->current) {
-        return NULL;
+    if (!trace_is_valid(t)) {
+        return 0;
     }
 
-    t->current = t->current->next;
-    return t->current;
+    t->index++;
+    return trace_is_valid(t);
 }
 
 /*
  * Move the Trace backward in time.
+ * Stepping back from time 0 invalidates the Trace.
  */
-struct World *trace_prev(Trace *t)
+int trace_prev(Trace *t)
 {
-    if (!t || !t->current) {
-        return NULL;
+    if (!trace_is_valid(t)) {
+        return 0;
     }
 
-    t->current = t->current->prev;
-    return t->current;
+    t->index = t->index ? t->index - 1 : SIZE_MAX;
+    return trace_is_valid(t);
 }
 
 /*
- * Check whether the Trace points to a valid World.
+ * Check whether the Trace points at a timeline entry.
  */
 int trace_is_valid(const Trace *t)
 {
-    return t && t->current;
+    return t && t->tl && t->index < t->tl->count;
 }
@@ -2,31 +2,69 @@
 #define LIMINAL_TRACE_H
 
 #include <stdint.h>
+#include <stddef.h>
 
-struct World;
+#include "../../executor/timeline/timeline.h"
 
 /*
  * Trace
  *
- * A read-only cursor over a sequence of Worlds.
+ * A read-only cursor over the Timeline.
  *
- * The Trace never mutates Worlds.
+ * The Trace never mutates the Timeline.
  * It may move forward and backward in time.
+ * The cursor position IS the time.
  */
 typedef struct Trace {
-    struct World *current;
+    const Timeline *tl;
+    size_t index;
 } Trace;
 
 /* Construction */
-Trace trace_begin(struct World *head);
-Trace trace_end(struct World *tail);
+Trace trace_begin(const Timeline *tl);
+Trace trace_end(const Timeline *tl);
 
-/* Navigation */
-struct World *trace_current(Trace *t);
-struct World *trace_next(Trace *t);
-struct World *trace_prev(Trace *t);
+/* Navigation (return trace_is_valid after the move) */
+int trace_next(Trace *t);
+int trace_prev(Trace *t);
 
 /* Utility */
 int trace_is_valid(const Trace *t);
 
+/*
+ * Accessors for the current entry.
+ * Only meaningful while trace_is_valid().
+ */
+static inline uint64_t trace_time(const Trace *t)
+{
+    return t->index;
+}
+
+static inline StepKind trace_kind(const Trace *t)
+{
+    return timeline_kind(t->tl, t->index);
+}
+
+static inline void *trace_origin(const Trace *t)
+{
+    return timeline_origin(t->tl, t->index);
+}
+
+static inline uint64_t trace_info(const Trace *t)
+{
+    return timeline_info(t->tl, t->index);
+}
+
+/* Active scope after the current step */
+static inline struct Scope *trace_scope(const Trace *t)
+{
+    return timeline_scope(t->tl, t->index);
+}
+
+/* Active scope before the current step (NULL at time 0) */
+static inline struct Scope *trace_prev_scope(const Trace *t)
+{
+    return t->index ? timeline_scope(t->tl, t->index - 1) : NULL;
+}
+
 #endif /* LIMINAL_TRACE_H */
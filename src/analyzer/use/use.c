@@ -1,55 +1,82 @@
 #include "analyzer/analyzer.h"
 #include "executor/executor.h"
 
+static void on_step(void *state, const PassStep *s)
+{
+    UseCollector *c = state;
+
+    if (c->truncated) {
+        return;
+    }
+
+    if (c->count >= c->cap) {
+        c->truncated = 1;
+        return;
+    }
+
+    UseReport r = {
+        .time = s->time,
+        .scope_id = s->scope ? s->scope->id : 0,
+        .storage_id = s->info,
+        .kind = USE_OK
+    };
+
+    /* Rule 1: use before declaration */
+    if (s->info == UINT64_MAX) {
+        r.kind = USE_BEFORE_DECLARE;
+        c->out[c->count++] = r;
+        return;
+    }
+
+    /* Rule 2: use after scope exit (one lifetime per scope id) */
+    size_t i = scope_index_get(c->index, r.scope_id);
+    if (i == SCOPE_INDEX_NONE) {
+        return;
+    }
+
+    const ScopeLifetime *lt = &c->lifetimes[i];
+    if (lt->exit_time != UINT64_MAX && r.time > lt->exit_time) {
+        r.kind = USE_AFTER_SCOPE;
+        c->out[c->count++] = r;
+    }
+}
+
+AnalyzerPass use_pass(UseCollector *c)
+{
+    return (AnalyzerPass){
+        .name    = "use",
+        .state   = c,
+        .kinds   = PASS_KIND(STEP_USE),
+        .on_step = on_step
+    };
+}
+
 size_t analyze_step_use(
-    const struct World *worlds,
+    const struct Timeline *tl,
     const struct ScopeLifetime *lifetimes,
     size_t lifetime_count,
     UseReport *out,
     size_t cap
 ) {
-    size_t count = 0;
-
-    Trace t = trace_begin((struct World *)worlds);
-    while (trace_is_valid(&t)) {
-        const World *w = trace_current(&t);
-        const Step *s = w->step;
-
-        if (!s || s->kind != STEP_USE)
-            goto next;
-
-        if (count >= cap)
-            break;
-
-        UseReport r = {
-            .time = w->time,
-            .scope_id = w->active_scope ? w->active_scope->id : 0,
-            .storage_id = s->info,
-            .kind = USE_OK
-        };
-
-        /* Rule 1: use before declaration */
-        if (s->info == UINT64_MAX) {
-            r.kind = USE_BEFORE_DECLARE;
-            out[count++] = r;
-            goto next;
-        }
-
-        /* Rule 2: use after scope exit */
-        for (size_t i = 0; i < lifetime_count; i++) {
-            const ScopeLifetime *lt = &lifetimes[i];
-            if (lt->scope_id == r.scope_id &&
-                lt->exit_time != UINT64_MAX &&
-                r.time > lt->exit_time) {
-                r.kind = USE_AFTER_SCOPE;
-                out[count++] = r;
-                goto next;
-            }
-        }
-
-    next:
-        trace_next(&t);
+    /* Index the caller's lifetimes; first one wins per scope id */
+    ScopeIndex index = {0};
+    for (size_t i = lifetime_count; i > 0; i--) {
+        scope_index_put(&index, lifetimes[i - 1].scope_id, i - 1);
     }
 
-    return count;
+    UseCollector c = {
+        .lifetimes = lifetimes,
+        .index     = &index,
+        .out       = out,
+        .cap       = cap
+    };
+
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, use_pass(&c));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
+
+    scope_index_free(&index);
+    return c.count;
 }
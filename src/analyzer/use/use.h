@@ -5,8 +5,11 @@
 #include <stddef.h>
 // #include "analyzer/use/use_report.h"
 
-struct World;
+#include "../pass/pass.h"
+
+struct Timeline;
 struct ScopeLifetime;
+struct ScopeIndex;
 
 /*
  * Classification of a variable use
@@ -28,9 +31,9 @@ typedef struct UseReport {
 } UseReport;
 
 /*
- * Analyze STEP_USE events in a World timeline.
+ * Analyze STEP_USE events in the Timeline.
  *
- * - worlds: head of world list
+ * - tl: timeline
  * - lifetimes: collected scope lifetimes
  * - lifetime_count: number of lifetimes
  * - out: output array
@@ -39,11 +42,31 @@ typedef struct UseReport {
  * Returns number of reports written.
  */
 size_t analyze_step_use(
-    const struct World *worlds,
+    const struct Timeline *tl,
     const struct ScopeLifetime *lifetimes,
     size_t lifetime_count,
     UseReport *out,
     size_t cap
 );
 
+/*
+ * Sink for the use pass.
+ *
+ * `lifetimes` / `index` may be live: when the scope lifetime pass
+ * runs earlier in the same traversal, every lifetime that can close
+ * before a use has already been recorded.
+ * Once `cap` is hit the pass stops and sets `truncated`.
+ */
+typedef struct UseCollector {
+    const struct ScopeLifetime *lifetimes;
+    const struct ScopeIndex *index;   /* scope id -> lifetimes[] */
+
+    UseReport *out;
+    size_t cap;
+    size_t count;
+    int truncated;
+} UseCollector;
+
+AnalyzerPass use_pass(UseCollector *c);
+
 #endif /* LIMINAL_ANALYZER_USE_H */
@@ -1,68 +1,70 @@
 #include "analyzer/analyzer.h"
 #include "executor/executor.h"
 
-#define MAX_SCOPE_DEPTH 128
+static void record(ScopeValidator *v, ScopeViolationKind kind,
+                   uint64_t time, uint64_t scope_id)
+{
+    if (v->count < v->cap) {
+        v->out[v->count++] = (ScopeViolation){
+            .kind = kind,
+            .time = time,
+            .scope_id = scope_id
+        };
+    }
+}
 
-size_t validate_scope_invariants(
-    struct World *head,
-    ScopeViolation *out,
-    size_t cap
-) {
-    uint64_t stack[MAX_SCOPE_DEPTH];
-    size_t depth = 0;
-    size_t count = 0;
+/*
+ * ENTER needs no check: the shared stack records it.
+ * EXIT must match the innermost open scope.
+ */
+static void on_step(void *state, const PassStep *s)
+{
+    ScopeValidator *v = state;
 
-    Trace t = trace_begin(head);
-    while (trace_is_valid(&t)) {
-        World *w = trace_current(&t);
-        if (!w || !w->step) {
-            trace_next(&t);
-            continue;
-        }
+    if (s->kind != STEP_EXIT_SCOPE) {
+        return;
+    }
 
-        Step *s = w->step;
+    if (s->scope_depth == 0) {
+        record(v, SCOPE_EXIT_WITHOUT_ENTER, s->time, s->info);
+    } else if (s->scope_stack[s->scope_depth - 1] != s->info) {
+        record(v, SCOPE_NON_LIFO_EXIT, s->time, s->info);
+    }
+}
 
-        if (s->kind == STEP_ENTER_SCOPE) {
-            if (depth < MAX_SCOPE_DEPTH) {
-                stack[depth++] = s->info;
-            }
-        }
-        else if (s->kind == STEP_EXIT_SCOPE) {
-            if (depth == 0) {
-                if (count < cap) {
-                    out[count++] = (ScopeViolation){
-                        .kind = SCOPE_EXIT_WITHOUT_ENTER,
-                        .time = w->time,
-                        .scope_id = s->info
-                    };
-                }
-            } else {
-                uint64_t expected = stack[depth - 1];
-                if (expected != s->info) {
-                    if (count < cap) {
-                        out[count++] = (ScopeViolation){
-                            .kind = SCOPE_NON_LIFO_EXIT,
-                            .time = w->time,
-                            .scope_id = s->info
-                        };
-                    }
-                } else {
-                    depth--;
-                }
-            }
-        }
+/* Unclosed scopes */
+static void on_end(void *state, const PassStep *s)
+{
+    ScopeValidator *v = state;
 
-        trace_next(&t);
+    for (size_t i = 0; i < s->scope_depth; i++) {
+        record(v, SCOPE_ENTER_WITHOUT_EXIT, UINT64_MAX, s->scope_stack[i]);
     }
+}
 
-    /* Unclosed scopes */
-    for (size_t i = 0; i < depth && count < cap; i++) {
-        out[count++] = (ScopeViolation){
-            .kind = SCOPE_ENTER_WITHOUT_EXIT,
-            .time = UINT64_MAX,
-            .scope_id = stack[i]
-        };
-    }
+AnalyzerPass scope_validate_pass(ScopeValidator *v)
+{
+    return (AnalyzerPass){
+        .name    = "scope-validate",
+        .state   = v,
+        .kinds   = PASS_KIND(STEP_EXIT_SCOPE),
+        .on_step = on_step,
+        .on_end  = on_end
+    };
+}
+
+size_t validate_scope_invariants(
+    const struct Timeline *tl,
+    ScopeViolation *out,
+    size_t cap
+) {
+    ScopeValidator v = { .out = out, .cap = cap };
+
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, scope_validate_pass(&v));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
 
-    return count;
+    return v.count;
 }
@@ -4,11 +4,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "../pass/pass.h"
+
 /*
- * This file defines *structural validators* over the World timeline.
+ * This file defines *structural validators* over the Timeline.
  *
  * Validators:
- *  - NEVER mutate Worlds
+ *  - NEVER mutate the Timeline
  *  - NEVER execute semantics
  *  - ONLY read derived structure from the trace
  *
@@ -20,7 +22,7 @@
  *   "This program is wrong."
  */
 
-struct World;
+struct Timeline;
 
 /*
  * ScopeViolationKind
@@ -57,7 +59,7 @@ typedef enum ScopeViolationKind {
     SCOPE_NON_LIFO_EXIT,
 
     /*
-     * The active_scope pointer stored in the World
+     * The active scope recorded in the Timeline
      * does not match what the step-derived scope stack
      * says it *should* be.
      *
@@ -81,7 +83,7 @@ typedef enum ScopeViolationKind {
 typedef struct ScopeViolation {
     ScopeViolationKind kind;
 
-    /* World time at which violation was observed */
+    /* Time at which violation was observed */
     uint64_t time;
 
     /* Scope id involved in the violation */
@@ -91,12 +93,12 @@ typedef struct ScopeViolation {
 /*
  * validate_scope_invariants
  *
- * Walks the World timeline from beginning to end
+ * Walks the Timeline from beginning to end
  * and validates that scope ENTER / EXIT events form
  * a well-structured, properly nested tree.
  *
  * Inputs:
- *   - head : first World in timeline
+ *   - tl   : timeline
  *   - out  : caller-provided array for violations
  *   - cap  : capacity of `out`
  *
@@ -105,12 +107,28 @@ typedef struct ScopeViolation {
  *
  * Notes:
  *   - Validation is PURE.
- *   - No allocation.
+ *   - No allocation beyond the shared scope stack.
  *   - No mutation.
  *   - If cap is exceeded, results are truncated.
  */
-size_t validate_scope_invariants(struct World *head,
+size_t validate_scope_invariants(const struct Timeline *tl,
                                  ScopeViolation *out,
                                  size_t cap);
 
+/*
+ * Sink for the scope validation pass.
+ * Violations past `cap` are dropped.
+ */
+typedef struct ScopeValidator {
+    ScopeViolation *out;
+    size_t cap;
+    size_t count;
+} ScopeValidator;
+
+/*
+ * Same checks as a pass, driven by the PassManager's
+ * shared scope stack.
+ */
+AnalyzerPass scope_validate_pass(ScopeValidator *v);
+
 #endif /* LIMINAL_VALIDATE_H */
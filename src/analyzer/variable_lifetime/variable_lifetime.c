@@ -1,42 +1,101 @@
+#include <stdlib.h>
+
 #include "analyzer/analyzer.h"
 #include "executor/executor.h"
 
+static int link_next(VariableLifetimeCollector *c, size_t i, size_t next)
+{
+    if (i >= c->next_cap) {
+        size_t cap = c->next_cap ? c->next_cap * 2 : 64;
+        while (cap <= i) {
+            cap *= 2;
+        }
 
-size_t lifetime_collect_variables(
-    struct World *head,
-    VariableLifetime *out,
-    size_t cap
-) {
-    size_t n = 0;
-    Trace t = trace_begin(head);
-
-    while (trace_is_valid(&t)) {
-        World *w = trace_current(&t);
-        Step *s = w->step;
-
-        if (s && s->kind == STEP_DECLARE) {
-            if (n >= cap) break;
-
-            out[n++] = (VariableLifetime){
-                .var_id        = s->info,
-                .scope_id      = w->active_scope ? w->active_scope->id : 0,
-                .declare_time  = w->time,
-                .end_time      = UINT64_MAX
-            };
+        size_t *n = realloc(c->next, cap * sizeof(*n));
+        if (!n) {
+            return 0;
         }
+        c->next = n;
+        c->next_cap = cap;
+    }
 
-        if (s && s->kind == STEP_EXIT_SCOPE) {
-            uint64_t sid = s->info;
-            for (size_t i = 0; i < n; i++) {
-                if (out[i].scope_id == sid &&
-                    out[i].end_time == UINT64_MAX) {
-                    out[i].end_time = w->time;
-                }
-            }
+    c->next[i] = next;
+    return 1;
+}
+
+static void on_step(void *state, const PassStep *s)
+{
+    VariableLifetimeCollector *c = state;
+
+    if (c->truncated) {
+        return;
+    }
+
+    if (s->kind == STEP_DECLARE) {
+        if (c->count >= c->cap) {
+            c->truncated = 1;
+            return;
         }
 
-        trace_next(&t);
+        size_t i = c->count++;
+        uint64_t sid = s->scope ? s->scope->id : 0;
+
+        c->out[i] = (VariableLifetime){
+            .var_id        = s->info,
+            .scope_id      = sid,
+            .declare_time  = s->time,
+            .end_time      = UINT64_MAX
+        };
+
+        /* Push onto the scope's open list */
+        if (link_next(c, i, scope_index_get(&c->open, sid))) {
+            scope_index_put(&c->open, sid, i);
+        }
+    } else {
+        /* Close everything still open in the exiting scope */
+        uint64_t sid = s->info;
+        size_t i = scope_index_get(&c->open, sid);
+
+        while (i != SCOPE_INDEX_NONE) {
+            c->out[i].end_time = s->time;
+            i = c->next[i];
+        }
+
+        scope_index_clear(&c->open, sid);
     }
+}
+
+AnalyzerPass variable_lifetime_pass(VariableLifetimeCollector *c)
+{
+    return (AnalyzerPass){
+        .name    = "variable-lifetimes",
+        .state   = c,
+        .kinds   = PASS_KIND(STEP_DECLARE) | PASS_KIND(STEP_EXIT_SCOPE),
+        .on_step = on_step
+    };
+}
+
+void variable_lifetime_collector_free(VariableLifetimeCollector *c)
+{
+    scope_index_free(&c->open);
+    free(c->next);
+    c->next = NULL;
+    c->next_cap = 0;
+}
+
+size_t lifetime_collect_variables(
+    const struct Timeline *tl,
+    VariableLifetime *out,
+    size_t cap
+) {
+    VariableLifetimeCollector c = { .out = out, .cap = cap };
+
+    PassManager pm;
+    pass_manager_init(&pm);
+    pass_manager_add(&pm, variable_lifetime_pass(&c));
+    pass_manager_run(&pm, tl);
+    pass_manager_free(&pm);
 
-    return n;
+    variable_lifetime_collector_free(&c);
+    return c.count;
 }
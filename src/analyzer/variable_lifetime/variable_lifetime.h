@@ -4,7 +4,10 @@
 #include <stdint.h>
 #include <stddef.h>
 
-struct World;
+#include "../pass/pass.h"
+#include "../lifetime/lifetime.h"
+
+struct Timeline;
 
 typedef struct VariableLifetime {
     uint64_t var_id;
@@ -13,8 +16,33 @@ typedef struct VariableLifetime {
     uint64_t end_time;   /* scope exit */
 } VariableLifetime;
 
-size_t lifetime_collect_variables(struct World *head,
+/*
+ * Caller-provided sink for the variable lifetime pass.
+ * Once `cap` is hit the pass stops and sets `truncated`.
+ *
+ * Open variables are chained per scope id (`open` heads,
+ * `next` links into `out`), so a scope exit only visits the
+ * variables it actually closes. Release the chains with
+ * variable_lifetime_collector_free().
+ */
+typedef struct VariableLifetimeCollector {
+    VariableLifetime *out;
+    size_t cap;
+    size_t count;
+    int truncated;
+
+    ScopeIndex open;
+    size_t *next;
+    size_t next_cap;
+} VariableLifetimeCollector;
+
+size_t lifetime_collect_variables(const struct Timeline *tl,
                                   VariableLifetime *out,
                                   size_t cap);
 
+AnalyzerPass variable_lifetime_pass(VariableLifetimeCollector *c);
+
+/* Releases the chains only; `out` belongs to the caller */
+void variable_lifetime_collector_free(VariableLifetimeCollector *c);
+
 #endif
@@ -6,7 +6,6 @@
 #include "analyzer/analyzer.h"
 #include "consumers/consumers.h"
 #include "consumers/root/chain/build.h"
-#include "consumers/root/chain/role.h"
 #include "consumers/convergence/build/build.h"
 #include "consumers/convergence/render/render.h"
 #include "consumers/fix_surface/fix_surface_render.h"
@@ -25,17 +24,22 @@
  * NO persistence
  * NO cross-stage storage
  */
-int cmd_analyze(const struct World *world)
+int cmd_analyze(const struct Timeline *tl)
 {
-    if (!world) {
-        fprintf(stderr, "analyze: no world provided\n");
+    if (!tl) {
+        fprintf(stderr, "analyze: no timeline provided\n");
         return 1;
     }
 
     /* --- Diagnostics --- */
 
     struct DiagnosticArtifact diags =
-        analyze_diagnostics((struct World *)world);
+        analyze_diagnostics(tl);
+
+    if (!diags.items) {
+        fprintf(stderr, "analyze: failed to analyze timeline\n");
+        return 1;
+    }
 
     if (diags.count == 0) {
         printf("No diagnostics.\n");
@@ -47,22 +51,24 @@ int cmd_analyze(const struct World *world)
     Arena arena;
     arena_init(&arena, 32 * 1024);
 
-    /* --- Root chains --- */
+    /* --- Root chains (share the index's steps) --- */
 
+    CausalIndex ix;
     struct RootChain *chains =
         arena_alloc(&arena, diags.count * sizeof(struct RootChain));
 
+    if (!chains || causal_index_build(&arena, tl, &ix) != 0) {
+        fprintf(stderr, "analyze: out of memory\n");
+        arena_destroy(&arena);
+        diagnostic_artifact_free(&diags);
+        return 1;
+    }
+
     for (size_t i = 0; i < diags.count; i++) {
         chains[i] = build_root_chain(
-            &arena,
-            world,
+            &ix,
             &diags.items[i]
         );
-
-        assign_root_chain_roles(
-            &chains[i],
-            diags.items[i].kind
-        );
     }
 
     /* --- Convergence --- */
@@ -70,6 +76,7 @@ int cmd_analyze(const struct World *world)
     ConvergenceMap cmap = {0};
 
     build_convergence_map(
+        &arena,
         &diags,
         chains,
         &cmap
@@ -81,7 +88,9 @@ int cmd_analyze(const struct World *world)
 
     FixSurface fs = build_fix_surface(&cmap);
     render_fix_surface(&fs);
+    free(fs.causes);
 
     arena_destroy(&arena);
+    diagnostic_artifact_free(&diags);
     return 0;
 }
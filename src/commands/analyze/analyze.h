@@ -23,6 +23,6 @@
  * NO persistence
  * NO cross-stage storage
  */
-int cmd_analyze(const struct World *world);
+int cmd_analyze(const struct Timeline *tl);
 
 #endif
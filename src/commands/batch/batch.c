@@ -0,0 +1,657 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "./batch.h"
+#include "common/common.h"
+#include "executor/executor.h"
+#include "analyzer/analyzer.h"
+#include "frontends/frontends.h"
+#include "policy/policy.h"
+#include "../cache/cache.h"
+
+/* ------------------------------------------------------------
+ * Inputs
+ * ------------------------------------------------------------ */
+
+typedef struct BatchInputs {
+    char  **paths;
+    size_t  count;
+    size_t  cap;
+
+    /* Bytes of each path to drop when naming its artifacts */
+    size_t  prefix;
+
+    /* Artifact directory name of each path (see inputs_name) */
+    char  **names;
+} BatchInputs;
+
+static int inputs_push(BatchInputs *in, const char *path, size_t len)
+{
+    if (in->count == in->cap) {
+        size_t ncap = in->cap ? in->cap * 2 : 64;
+        char **np = realloc(in->paths, ncap * sizeof(*np));
+        if (!np) return 0;
+        in->paths = np;
+        in->cap = ncap;
+    }
+
+    char *copy = malloc(len + 1);
+    if (!copy) return 0;
+    memcpy(copy, path, len);
+    copy[len] = '\0';
+
+    in->paths[in->count++] = copy;
+    return 1;
+}
+
+static void inputs_free(BatchInputs *in)
+{
+    for (size_t i = 0; i < in->count; i++) {
+        free(in->paths[i]);
+        if (in->names) {
+            free(in->names[i]);
+        }
+    }
+    free(in->paths);
+    free(in->names);
+    memset(in, 0, sizeof(*in));
+}
+
+static int is_c_file(const char *name)
+{
+    size_t n = strlen(name);
+    return n > 2 && strcmp(name + n - 2, ".c") == 0;
+}
+
+/* Every *.c below `dir`; symlinked directories are not followed */
+static int inputs_walk(BatchInputs *in, const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "batch: cannot open directory '%s'\n", dir);
+        return 0;
+    }
+
+    int ok = 1;
+    struct dirent *e;
+    char path[4096];
+
+    while (ok && (e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') {
+            continue;
+        }
+
+        int n = snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (n < 0 || (size_t)n >= sizeof(path)) {
+            fprintf(stderr, "batch: path too long under '%s'\n", dir);
+            continue;
+        }
+
+        struct stat st;
+        if (lstat(path, &st) != 0) {
+            continue;
+        }
+
+        if (S_ISDIR(st.st_mode)) {
+            ok = inputs_walk(in, path);
+        } else if (is_c_file(e->d_name)) {
+            /* Symlinks to regular files count */
+            if (S_ISLNK(st.st_mode) &&
+                (stat(path, &st) != 0 || !S_ISREG(st.st_mode))) {
+                continue;
+            }
+            ok = inputs_push(in, path, (size_t)n);
+        }
+    }
+
+    closedir(d);
+    return ok;
+}
+
+static int path_cmp(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* One path per line; blank lines and '#' comments are skipped */
+static int inputs_read_list(BatchInputs *in, const char *list)
+{
+    FILE *f = strcmp(list, "-") == 0 ? stdin : fopen(list, "r");
+    if (!f) {
+        fprintf(stderr, "batch: cannot open list '%s'\n", list);
+        return 0;
+    }
+
+    int ok = 1;
+    char line[4096];
+
+    while (ok && fgets(line, sizeof(line), f)) {
+        size_t n = strcspn(line, "\r\n");
+        while (n > 0 && (line[n - 1] == ' ' || line[n - 1] == '\t')) {
+            n--;
+        }
+        if (n == 0 || line[0] == '#') {
+            continue;
+        }
+        ok = inputs_push(in, line, n);
+    }
+
+    if (f != stdin) {
+        fclose(f);
+    }
+    return ok;
+}
+
+static int inputs_collect(BatchInputs *in, const char *spec)
+{
+    if (spec[0] == '@') {
+        in->prefix = 0;
+        return inputs_read_list(in, spec + 1);
+    }
+
+    struct stat st;
+    if (stat(spec, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "batch: '%s' is not a directory\n", spec);
+        return 0;
+    }
+
+    if (!inputs_walk(in, spec)) {
+        return 0;
+    }
+
+    /* readdir order is arbitrary; sort so runs are reproducible */
+    qsort(in->paths, in->count, sizeof(*in->paths), path_cmp);
+
+    in->prefix = strlen(spec) + 1;
+    return 1;
+}
+
+/* Longest artifact directory name, hash suffix included */
+#define BATCH_NAME_MAX 200
+
+/*
+ * Artifact directory name for `path`: drop the walk root (or a
+ * leading "./" or "/"), flatten '/' to '_', then append a hash of
+ * the relative path, so "a/b_c.c" and "a_b/c.c" stay apart. Long
+ * paths keep only their tail in the readable part; the hash still
+ * covers all of it. Returns 0 if the name does not fit in `cap`.
+ */
+static int input_name(const char *path, size_t prefix,
+                      char *out, size_t cap)
+{
+    const char *s = path + prefix;
+
+    while (s[0] == '.' && s[1] == '/') s += 2;
+    while (s[0] == '/') s++;
+
+    size_t len = strlen(s);
+    uint64_t h = hash64(s, len, 0);
+
+    /* Readable part: what "-", 16 hex digits and the NUL leave */
+    size_t room = cap < BATCH_NAME_MAX + 1 ? cap : BATCH_NAME_MAX + 1;
+    if (room < 18) {
+        return 0;
+    }
+    size_t keep = room - 18;
+
+    size_t n = 0;
+    for (const char *t = len > keep ? s + len - keep : s; *t; t++) {
+        out[n++] = *t == '/' ? '_' : *t;
+    }
+
+    int w = snprintf(out + n, cap - n, "-%016" PRIx64, h);
+    return w > 0 && (size_t)w < cap - n;
+}
+
+/*
+ * Name every input's artifact directory. Two inputs with the same
+ * name (the same file listed twice, in practice) would have two
+ * workers writing one directory, so that is an error.
+ */
+static int inputs_name(BatchInputs *in)
+{
+    in->names = calloc(in->count ? in->count : 1, sizeof(*in->names));
+    if (!in->names) {
+        fprintf(stderr, "batch: out of memory\n");
+        return 0;
+    }
+
+    for (size_t i = 0; i < in->count; i++) {
+        char name[BATCH_NAME_MAX + 1];
+
+        if (!input_name(in->paths[i], in->prefix, name, sizeof(name))) {
+            fprintf(stderr, "batch: cannot name artifacts for '%s'\n",
+                    in->paths[i]);
+            return 0;
+        }
+
+        size_t len = strlen(name);
+        in->names[i] = malloc(len + 1);
+        if (!in->names[i]) {
+            fprintf(stderr, "batch: out of memory\n");
+            return 0;
+        }
+        memcpy(in->names[i], name, len + 1);
+    }
+
+    char **sorted = malloc((in->count ? in->count : 1) * sizeof(*sorted));
+    if (!sorted) {
+        fprintf(stderr, "batch: out of memory\n");
+        return 0;
+    }
+    memcpy(sorted, in->names, in->count * sizeof(*sorted));
+    qsort(sorted, in->count, sizeof(*sorted), path_cmp);
+
+    int ok = 1;
+    for (size_t i = 1; ok && i < in->count; i++) {
+        if (strcmp(sorted[i - 1], sorted[i]) == 0) {
+            fprintf(stderr,
+                    "batch: two inputs share artifact directory '%s' "
+                    "(is a file listed twice?)\n", sorted[i]);
+            ok = 0;
+        }
+    }
+
+    free(sorted);
+    return ok;
+}
+
+/* ------------------------------------------------------------
+ * Pipeline
+ * ------------------------------------------------------------ */
+
+typedef enum BatchOutcome {
+    BATCH_ALLOWED = 0,
+    BATCH_WARNED,
+    BATCH_DENIED,
+    BATCH_PARSE_FAILED,
+    BATCH_EXEC_FAILED,
+    BATCH_ANALYSIS_FAILED
+} BatchOutcome;
+
+typedef enum BatchCacheUse {
+    BATCH_CACHE_OFF = 0,
+    BATCH_CACHE_HIT,
+    BATCH_CACHE_MISS
+} BatchCacheUse;
+
+/* Per input; written by exactly one worker */
+typedef struct BatchResult {
+    unsigned char outcome;      /* BatchOutcome */
+    unsigned char cache;        /* BatchCacheUse */
+    unsigned char done;
+    size_t diagnostics;
+} BatchResult;
+
+/* Recycled across the inputs one worker runs */
+typedef struct BatchWorker {
+    ASTProgram *ast;
+    Universe   *universe;
+} BatchWorker;
+
+typedef struct Batch {
+    const BatchInputs *inputs;
+    BatchResult       *results;
+    BatchWorker       *workers;
+
+    const char   *root;         /* <artifact-dir>/<run-id> */
+    unsigned long started_at;
+
+    const ResultCache *cache;   /* NULL without --cache */
+
+    /* Inputs are reported in order, whichever worker finishes */
+    pthread_mutex_t report_lock;
+    size_t          reported;
+} Batch;
+
+static BatchOutcome decision_outcome(PolicyDecision d)
+{
+    switch (d) {
+    case POLICY_WARN: return BATCH_WARNED;
+    case POLICY_DENY: return BATCH_DENIED;
+    default:          return BATCH_ALLOWED;
+    }
+}
+
+static BatchOutcome batch_one(const Batch *b, BatchWorker *w,
+                              unsigned worker, size_t item,
+                              BatchResult *r)
+{
+    const char *path = b->inputs->paths[item];
+    const char *name = b->inputs->names[item];
+
+    ArtifactContext ctx = {
+        .root       = b->root,
+        .run_id     = name,
+        .input_path = path,
+        .started_at = b->started_at,
+        .timeline   = &w->universe->timeline
+    };
+
+    SourceBuffer src;
+    if (!source_buffer_open(&src, path)) {
+        return BATCH_PARSE_FAILED;
+    }
+
+    /* ---- RESULT CACHE ---- */
+    CacheKey key = {0};
+    if (b->cache) {
+        CacheEntry hit;
+        char run_dir[512];
+
+        key = cache_key(&LIMINAL_DEFAULT_POLICY, src.data, src.len);
+        if (cache_lookup(b->cache, key, &hit)) {
+            artifact_emit_meta(&ctx, run_dir, sizeof(run_dir));
+            if (cache_restore(b->cache, key, run_dir)) {
+                source_buffer_close(&src);
+                r->cache = BATCH_CACHE_HIT;
+                r->diagnostics = hit.diagnostics;
+                return decision_outcome((PolicyDecision)hit.decision);
+            }
+        }
+        r->cache = BATCH_CACHE_MISS;
+    }
+
+    /* ---- FRONTEND ---- */
+    w->ast = c_parse_buffer_recycle(path, &src, w->ast);
+    if (!w->ast) {
+        return BATCH_PARSE_FAILED;
+    }
+
+    /* ---- EXECUTOR ---- */
+    if (!universe_reset(w->universe) ||
+        !executor_run(w->universe, w->ast)) {
+        return BATCH_EXEC_FAILED;
+    }
+
+    /* ---- ANALYSIS ---- */
+    DiagnosticArtifact diagnostics =
+        analyze_diagnostics(&w->universe->timeline);
+    if (!diagnostics.items) {
+        return BATCH_ANALYSIS_FAILED;
+    }
+    r->diagnostics = diagnostics.count;
+
+    /* ---- POLICY ---- */
+    PolicyDecision d = policy_evaluate(&LIMINAL_DEFAULT_POLICY, &diagnostics);
+
+    /* ---- ARTIFACT EMISSION ---- */
+    artifact_emit_all(&ctx, &diagnostics);
+
+    if (b->cache) {
+        char run_dir[512];
+        CacheEntry entry = {
+            .decision    = (unsigned char)d,
+            .diagnostics = diagnostics.count
+        };
+        snprintf(run_dir, sizeof(run_dir), "%s/%s", b->root, name);
+        cache_store(b->cache, key, &entry, run_dir, worker);
+    }
+
+    diagnostic_artifact_free(&diagnostics);
+    return decision_outcome(d);
+}
+
+/* Print failures for the finished prefix of the input list */
+static void batch_report(Batch *b)
+{
+    while (b->reported < b->inputs->count &&
+           b->results[b->reported].done) {
+        const char *path = b->inputs->paths[b->reported];
+
+        switch (b->results[b->reported].outcome) {
+        case BATCH_PARSE_FAILED:
+            fprintf(stderr, "batch: %s: failed to parse AST\n", path);
+            break;
+        case BATCH_EXEC_FAILED:
+            fprintf(stderr,
+                    "batch: %s: failed to build execution artifact\n",
+                    path);
+            break;
+        case BATCH_ANALYSIS_FAILED:
+            fprintf(stderr, "batch: %s: failed to analyze timeline\n", path);
+            break;
+        default:
+            break;
+        }
+
+        b->reported++;
+    }
+}
+
+static void batch_item(void *ctx, unsigned worker, size_t item)
+{
+    Batch *b = ctx;
+    BatchResult r = {0};
+
+    r.outcome = (unsigned char)batch_one(b, &b->workers[worker], worker,
+                                         item, &r);
+    r.done = 1;
+
+    pthread_mutex_lock(&b->report_lock);
+    b->results[item] = r;
+    batch_report(b);
+    pthread_mutex_unlock(&b->report_lock);
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void batch_free(Batch *b, unsigned workers)
+{
+    if (b->workers) {
+        for (unsigned i = 0; i < workers; i++) {
+            ast_program_free(b->workers[i].ast);
+            universe_destroy(b->workers[i].universe);
+        }
+    }
+    free(b->workers);
+    free(b->results);
+}
+
+int cmd_batch(int argc, char **argv)
+{
+    const char *spec          = NULL;
+    const char *artifact_root = ".liminal";
+    const char *run_id_override = NULL;
+    unsigned    jobs          = 1;
+    int         use_cache     = 0;
+    unsigned long long cache_mib = 512;
+
+    /* ---- ARG PARSING ---- */
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--artifact-dir") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "error: --artifact-dir requires a path\n");
+                return 1;
+            }
+            artifact_root = argv[++i];
+            continue;
+        }
+
+        if (strcmp(argv[i], "--run-id") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "error: --run-id requires value\n");
+                return 1;
+            }
+            run_id_override = argv[++i];
+            continue;
+        }
+
+        if (strcmp(argv[i], "--cache") == 0) {
+            use_cache = 1;
+            continue;
+        }
+
+        if (strcmp(argv[i], "--cache-size") == 0) {
+            char *end = NULL;
+            unsigned long long v = i + 1 < argc
+                ? strtoull(argv[++i], &end, 10) : 0;
+            if (!end || *end != '\0' || v == 0) {
+                fprintf(stderr, "error: --cache-size requires MiB\n");
+                return 1;
+            }
+            cache_mib = v;
+            use_cache = 1;
+            continue;
+        }
+
+        /* -j N or -jN; 0 means one per CPU */
+        if (strncmp(argv[i], "-j", 2) == 0) {
+            const char *n = argv[i][2] ? argv[i] + 2
+                          : i + 1 < argc ? argv[++i] : NULL;
+            char *end = NULL;
+            long v = n ? strtol(n, &end, 10) : -1;
+            if (!n || *end != '\0' || v < 0 || v > 1024) {
+                fprintf(stderr, "error: -j requires a thread count\n");
+                return 1;
+            }
+            jobs = v == 0 ? pool_cpu_count() : (unsigned)v;
+            continue;
+        }
+
+        if (!spec) {
+            spec = argv[i];
+            continue;
+        }
+
+        fprintf(stderr, "error: unexpected argument '%s'\n", argv[i]);
+        return 1;
+    }
+
+    if (!spec) {
+        fprintf(stderr, "error: no input directory or @listfile\n");
+        return 1;
+    }
+
+    BatchInputs inputs = {0};
+    if (!inputs_collect(&inputs, spec) || !inputs_name(&inputs)) {
+        inputs_free(&inputs);
+        return 1;
+    }
+
+    /* ---- ARTIFACT ROOT ---- */
+    time_t now = time(NULL);
+    char run_id[64];
+    char root[512];
+
+    if (run_id_override) {
+        if (strlen(run_id_override) >= sizeof(run_id)) {
+            fprintf(stderr, "batch: run id '%s' is too long\n",
+                    run_id_override);
+            inputs_free(&inputs);
+            return 1;
+        }
+        snprintf(run_id, sizeof(run_id), "%s", run_id_override);
+    } else {
+        snprintf(run_id, sizeof(run_id), "batch-%lu", (unsigned long)now);
+    }
+
+    /* Leave room for "/<input>/<artifact file>" (run_dir is 512 too) */
+    int rn = snprintf(root, sizeof(root), "%s/%s", artifact_root, run_id);
+    if (rn < 0 || (size_t)rn + 1 + BATCH_NAME_MAX + 32 >= sizeof(root)) {
+        fprintf(stderr, "batch: artifact directory '%s/%s' is too long\n",
+                artifact_root, run_id);
+        inputs_free(&inputs);
+        return 1;
+    }
+
+    fs_mkdir_if_missing(artifact_root);
+    if (!fs_mkdir_if_missing(root)) {
+        fprintf(stderr, "batch: cannot create '%s'\n", root);
+        inputs_free(&inputs);
+        return 1;
+    }
+
+    ResultCache cache;
+    if (use_cache &&
+        !cache_open(&cache, artifact_root, cache_mib * 1024 * 1024)) {
+        fprintf(stderr, "batch: cannot create result cache under '%s'\n",
+                artifact_root);
+        use_cache = 0;
+    }
+
+    /* ---- WORKERS ---- */
+    if (jobs > inputs.count) {
+        jobs = inputs.count ? (unsigned)inputs.count : 1;
+    }
+
+    Batch b = {
+        .inputs     = &inputs,
+        .results    = calloc(inputs.count ? inputs.count : 1,
+                             sizeof(BatchResult)),
+        .workers    = calloc(jobs, sizeof(BatchWorker)),
+        .root       = root,
+        .started_at = (unsigned long)now,
+        .cache      = use_cache ? &cache : NULL,
+        .reported   = 0
+    };
+
+    int ok = b.results && b.workers;
+    for (unsigned i = 0; ok && i < jobs; i++) {
+        b.workers[i].universe = universe_create();
+        ok = b.workers[i].universe != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "batch: out of memory\n");
+        batch_free(&b, jobs);
+        inputs_free(&inputs);
+        return 1;
+    }
+
+    pthread_mutex_init(&b.report_lock, NULL);
+
+    /* ---- RUN ---- */
+    double t0 = now_seconds();
+    pool_run(inputs.count, jobs, batch_item, &b);
+    double elapsed = now_seconds() - t0;
+
+    pthread_mutex_destroy(&b.report_lock);
+
+    /* ---- SUMMARY ---- */
+    size_t counts[BATCH_ANALYSIS_FAILED + 1] = {0};
+    size_t cache_use[BATCH_CACHE_MISS + 1] = {0};
+    size_t diagnostics = 0;
+    for (size_t i = 0; i < inputs.count; i++) {
+        counts[b.results[i].outcome]++;
+        cache_use[b.results[i].cache]++;
+        diagnostics += b.results[i].diagnostics;
+    }
+
+    size_t denied = counts[BATCH_DENIED];
+    size_t failed = counts[BATCH_PARSE_FAILED] + counts[BATCH_EXEC_FAILED] +
+                    counts[BATCH_ANALYSIS_FAILED];
+
+    printf("batch: %zu files: %zu allowed, %zu warned, %zu denied, "
+           "%zu failed\n",
+           inputs.count, counts[BATCH_ALLOWED], counts[BATCH_WARNED],
+           denied, failed);
+    printf("batch: %zu diagnostics\n", diagnostics);
+    printf("batch: %.3f s, %.1f files/sec (%u thread%s)\n", elapsed,
+           elapsed > 0 ? (double)inputs.count / elapsed : 0.0,
+           jobs, jobs == 1 ? "" : "s");
+    if (use_cache) {
+        size_t evicted = cache_evict(&cache);
+        printf("batch: cache: %zu hits, %zu misses, %zu evicted\n",
+               cache_use[BATCH_CACHE_HIT], cache_use[BATCH_CACHE_MISS],
+               evicted);
+    }
+    printf("batch: artifacts -> %s\n", root);
+
+    batch_free(&b, jobs);
+    inputs_free(&inputs);
+
+    return denied || failed ? 1 : 0;
+}
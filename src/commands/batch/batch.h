@@ -0,0 +1,43 @@
+#ifndef LIMINAL_CMD_BATCH_H
+#define LIMINAL_CMD_BATCH_H
+
+/*
+ * cmd_batch
+ *
+ *   liminal batch <dir|@listfile> [-j N] [--artifact-dir <path>]
+ *                                 [--run-id <string>]
+ *                                 [--cache] [--cache-size <MiB>]
+ *
+ * Runs the `run` pipeline (parse, execute, analyze, policy) over
+ * many translation units in one process:
+ *   - <dir>       every *.c below it, recursively, in path order
+ *                 (entries starting with '.' are skipped)
+ *   - @listfile   one path per line ('#' comments, "@-" = stdin)
+ *
+ * Inputs are spread over N worker threads (-j 0: one per CPU) by
+ * a work-stealing pool. Each worker recycles its own ASTProgram
+ * and Universe across the inputs it runs, so their arenas are
+ * reset rather than rebuilt for every file; nothing else is
+ * shared. Artifacts, messages (reported in input order) and the
+ * exit code do not depend on N or on scheduling.
+ *
+ * Each input gets its own artifact directory,
+ *   <artifact-dir>/<run-id>/<input>-<hash>/
+ * where <input> is the path (relative to <dir>) with '/' → '_'
+ * (its tail, if very long) and <hash> is 16 hex digits of a hash
+ * of that relative path, so distinct inputs never share one. The
+ * same file listed twice is an error.
+ *
+ * --cache consults the result cache under <artifact-dir>/cache
+ * (see commands/cache): an input whose bytes, Liminal version and
+ * policy match an earlier run gets that run's diagnostics and
+ * timeline linked into its directory without being parsed or
+ * executed. Afterwards the cache is trimmed to --cache-size
+ * (default 512 MiB, implies --cache), least recently used first.
+ *
+ * Prints an aggregate summary (with cache hits and misses). Returns non-zero if any input
+ * failed to parse or was denied by policy.
+ */
+int cmd_batch(int argc, char **argv);
+
+#endif /* LIMINAL_CMD_BATCH_H */
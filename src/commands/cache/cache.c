@@ -0,0 +1,357 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "./cache.h"
+#include "common/common.h"
+
+static const char *const CACHE_FILES[] = {
+    "diagnostics.ndjson",
+    "timeline.ndjson"
+};
+
+#define CACHE_FILE_COUNT (sizeof(CACHE_FILES) / sizeof(CACHE_FILES[0]))
+
+/* ------------------------------------------------------------
+ * Keys
+ * ------------------------------------------------------------ */
+
+static void put_u64(unsigned char *out, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        out[i] = (unsigned char)(v >> (8 * i));
+    }
+}
+
+CacheKey cache_key(const Policy *policy, const char *src, size_t len)
+{
+    /* Policy fields one by one: the struct has padding */
+    unsigned char pol[(DIAG_KIND_MAX * 2 + 1) * 8];
+    size_t n = 0;
+
+    for (int k = 0; k < DIAG_KIND_MAX; k++) {
+        put_u64(pol + n, policy->deny_kind[k]);
+        n += 8;
+        put_u64(pol + n, policy->max_by_kind[k]);
+        n += 8;
+    }
+    put_u64(pol + n, policy->max_total);
+    n += 8;
+
+    uint64_t seed = hash64(LIMINAL_VERSION, strlen(LIMINAL_VERSION), 0);
+    seed = hash64(pol, n, seed);
+
+    CacheKey key = {
+        .hi = hash64(src, len, seed),
+        .lo = hash64(src, len, ~seed)
+    };
+    return key;
+}
+
+/* cache/<k[0..1]>/<k[2..31]> ; `shard` gets cache/<k[0..1]> */
+static void entry_path(const ResultCache *c, CacheKey key,
+                       char *shard, char *out, size_t cap)
+{
+    char hex[33];
+    snprintf(hex, sizeof(hex), "%016llx%016llx",
+             (unsigned long long)key.hi, (unsigned long long)key.lo);
+
+    snprintf(shard, cap, "%s/%.2s", c->dir, hex);
+    snprintf(out, cap, "%s/%.2s/%s", c->dir, hex, hex + 2);
+}
+
+/* ------------------------------------------------------------
+ * Files
+ * ------------------------------------------------------------ */
+
+static int copy_file(const char *from, const char *to)
+{
+    FILE *in = fopen(from, "rb");
+    if (!in) return 0;
+
+    FILE *out = fs_open_file(to);
+    if (!out) {
+        fclose(in);
+        return 0;
+    }
+
+    char buf[65536];
+    size_t n;
+    int ok = 1;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        if (fwrite(buf, 1, n, out) != n) {
+            ok = 0;
+            break;
+        }
+    }
+
+    ok = ok && !ferror(in);
+    fclose(in);
+    ok = fclose(out) == 0 && ok;
+    return ok;
+}
+
+/* Hard link `from` as `to`, or copy where links are not possible */
+static int link_or_copy(const char *from, const char *to)
+{
+    remove(to);
+
+    if (link(from, to) == 0) {
+        return 1;
+    }
+    if (errno == ENOENT) {
+        return 0;
+    }
+    return copy_file(from, to);
+}
+
+/* Remove `dir` and the plain files in it */
+static void remove_entry_dir(const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (d) {
+        struct dirent *e;
+        char path[1024];
+
+        while ((e = readdir(d)) != NULL) {
+            if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) {
+                continue;
+            }
+            snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+            remove(path);
+        }
+        closedir(d);
+    }
+    rmdir(dir);
+}
+
+/* ------------------------------------------------------------
+ * Entries
+ * ------------------------------------------------------------ */
+
+int cache_open(ResultCache *c, const char *artifact_root,
+               unsigned long long max_bytes)
+{
+    int n = snprintf(c->dir, sizeof(c->dir), "%s/cache", artifact_root);
+    if (n < 0 || (size_t)n >= sizeof(c->dir)) {
+        return 0;
+    }
+    c->max_bytes = max_bytes;
+
+    fs_mkdir_if_missing(artifact_root);
+    return fs_mkdir_if_missing(c->dir);
+}
+
+int cache_lookup(const ResultCache *c, CacheKey key, CacheEntry *out)
+{
+    char shard[1024], dir[1024], path[1100];
+    entry_path(c, key, shard, dir, sizeof(dir));
+    snprintf(path, sizeof(path), "%s/entry", dir);
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return 0;
+    }
+
+    unsigned decision = 0;
+    size_t diagnostics = 0;
+    int ok = fscanf(f, "%u %zu", &decision, &diagnostics) == 2 &&
+             decision <= POLICY_DENY;
+    fclose(f);
+
+    if (ok) {
+        out->decision = (unsigned char)decision;
+        out->diagnostics = diagnostics;
+    }
+    return ok;
+}
+
+int cache_restore(const ResultCache *c, CacheKey key, const char *run_dir)
+{
+    char shard[1024], dir[1024];
+    entry_path(c, key, shard, dir, sizeof(dir));
+
+    for (size_t i = 0; i < CACHE_FILE_COUNT; i++) {
+        char from[1100], to[1100];
+        snprintf(from, sizeof(from), "%s/%s", dir, CACHE_FILES[i]);
+        snprintf(to, sizeof(to), "%s/%s", run_dir, CACHE_FILES[i]);
+
+        if (!link_or_copy(from, to)) {
+            return 0;
+        }
+    }
+
+    /* Recency for eviction */
+    utimensat(AT_FDCWD, dir, NULL, 0);
+    return 1;
+}
+
+int cache_store(const ResultCache *c, CacheKey key,
+                const CacheEntry *entry, const char *run_dir,
+                unsigned slot)
+{
+    char shard[1024], dir[1024], tmp[1024];
+    entry_path(c, key, shard, dir, sizeof(dir));
+    snprintf(tmp, sizeof(tmp), "%s/tmp.%ld.%u", c->dir, (long)getpid(), slot);
+
+    /* Left over from a crashed run with the same pid */
+    remove_entry_dir(tmp);
+    if (mkdir(tmp, 0755) != 0) {
+        return 0;
+    }
+
+    int ok = 1;
+    char from[1100], to[1100];
+
+    for (size_t i = 0; ok && i < CACHE_FILE_COUNT; i++) {
+        snprintf(from, sizeof(from), "%s/%s", run_dir, CACHE_FILES[i]);
+        snprintf(to, sizeof(to), "%s/%s", tmp, CACHE_FILES[i]);
+        ok = link_or_copy(from, to);
+    }
+
+    if (ok) {
+        char line[64];
+        int n = snprintf(line, sizeof(line), "%u %zu\n",
+                         (unsigned)entry->decision, entry->diagnostics);
+        snprintf(to, sizeof(to), "%s/entry", tmp);
+        ok = fs_write_file(to, line, (size_t)n);
+    }
+
+    /* Publish; losing a race to another writer of the key is fine */
+    if (ok) {
+        fs_mkdir_if_missing(shard);
+        ok = rename(tmp, dir) == 0;
+    }
+    if (!ok) {
+        remove_entry_dir(tmp);
+    }
+    return ok;
+}
+
+/* ------------------------------------------------------------
+ * Eviction
+ * ------------------------------------------------------------ */
+
+typedef struct CacheUsage {
+    char              *dir;
+    struct timespec    used;
+    unsigned long long bytes;
+} CacheUsage;
+
+typedef struct CacheScan {
+    CacheUsage *items;
+    size_t      count;
+    size_t      cap;
+    unsigned long long bytes;
+} CacheScan;
+
+static int scan_entry(CacheScan *s, const char *dir)
+{
+    struct stat st;
+    if (stat(dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return 1;
+    }
+
+    CacheUsage u = { .used = st.st_mtim, .bytes = 0 };
+
+    DIR *d = opendir(dir);
+    if (!d) {
+        return 1;
+    }
+    struct dirent *e;
+    char path[1024];
+    while ((e = readdir(d)) != NULL) {
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (e->d_name[0] != '.' && stat(path, &st) == 0) {
+            u.bytes += (unsigned long long)st.st_size;
+        }
+    }
+    closedir(d);
+
+    if (s->count == s->cap) {
+        size_t ncap = s->cap ? s->cap * 2 : 256;
+        CacheUsage *np = realloc(s->items, ncap * sizeof(*np));
+        if (!np) return 0;
+        s->items = np;
+        s->cap = ncap;
+    }
+
+    u.dir = malloc(strlen(dir) + 1);
+    if (!u.dir) return 0;
+    strcpy(u.dir, dir);
+
+    s->items[s->count++] = u;
+    s->bytes += u.bytes;
+    return 1;
+}
+
+static int usage_cmp(const void *a, const void *b)
+{
+    const CacheUsage *x = a, *y = b;
+    if (x->used.tv_sec != y->used.tv_sec)
+        return x->used.tv_sec < y->used.tv_sec ? -1 : 1;
+    if (x->used.tv_nsec != y->used.tv_nsec)
+        return x->used.tv_nsec < y->used.tv_nsec ? -1 : 1;
+    return strcmp(x->dir, y->dir);
+}
+
+size_t cache_evict(const ResultCache *c)
+{
+    CacheScan s = {0};
+
+    DIR *d = opendir(c->dir);
+    if (!d) {
+        return 0;
+    }
+
+    int ok = 1;
+    struct dirent *e;
+    char shard[1024], dir[1024];
+
+    /* Shards are the two-character directories; skip tmp.* */
+    while (ok && (e = readdir(d)) != NULL) {
+        if (strlen(e->d_name) != 2 || e->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(shard, sizeof(shard), "%s/%s", c->dir, e->d_name);
+
+        DIR *sd = opendir(shard);
+        if (!sd) continue;
+
+        struct dirent *se;
+        while (ok && (se = readdir(sd)) != NULL) {
+            int n = snprintf(dir, sizeof(dir), "%s/%s", shard, se->d_name);
+            if (se->d_name[0] == '.' || n < 0 || (size_t)n >= sizeof(dir)) {
+                continue;
+            }
+            ok = scan_entry(&s, dir);
+        }
+        closedir(sd);
+    }
+    closedir(d);
+
+    size_t removed = 0;
+    if (ok && s.bytes > c->max_bytes) {
+        qsort(s.items, s.count, sizeof(*s.items), usage_cmp);
+
+        for (size_t i = 0; i < s.count && s.bytes > c->max_bytes; i++) {
+            remove_entry_dir(s.items[i].dir);
+            s.bytes -= s.items[i].bytes;
+            removed++;
+        }
+    }
+
+    for (size_t i = 0; i < s.count; i++) {
+        free(s.items[i].dir);
+    }
+    free(s.items);
+    return removed;
+}
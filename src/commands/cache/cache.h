@@ -0,0 +1,73 @@
+#ifndef LIMINAL_CMD_CACHE_H
+#define LIMINAL_CMD_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../policy/policy.h"
+
+/*
+ * Result cache
+ *
+ * Content-addressed store of analysis results under
+ * <artifact-root>/cache. An entry is keyed by a 128-bit hash of
+ * the source bytes, LIMINAL_VERSION and the Policy, and holds:
+ *
+ *   diagnostics.ndjson
+ *   timeline.ndjson
+ *   entry                  "<decision> <diagnostics>\n"
+ *
+ * Entries live at cache/<k[0..1]>/<k[2..31]>/. They are built in a
+ * private directory and renamed into place, so readers never see a
+ * partial entry and concurrent writers of one key are harmless.
+ * Restoring hard-links the files into the run directory (copying
+ * across filesystems) and bumps the entry's mtime; eviction removes
+ * the least recently used entries until the cache fits its size
+ * bound.
+ */
+
+typedef struct CacheKey {
+    uint64_t hi;
+    uint64_t lo;
+} CacheKey;
+
+typedef struct CacheEntry {
+    unsigned char decision;     /* PolicyDecision */
+    size_t        diagnostics;
+} CacheEntry;
+
+typedef struct ResultCache {
+    char               dir[512];
+    unsigned long long max_bytes;
+} ResultCache;
+
+/* Create <artifact_root>/cache; 0 if it cannot be created */
+int cache_open(ResultCache *c, const char *artifact_root,
+               unsigned long long max_bytes);
+
+CacheKey cache_key(const Policy *policy, const char *src, size_t len);
+
+/* 1 and *out filled if `key` is cached */
+int cache_lookup(const ResultCache *c, CacheKey key, CacheEntry *out);
+
+/*
+ * Link the cached artifacts into `run_dir` and mark the entry as
+ * used. 0 if the entry vanished (evicted concurrently); the caller
+ * should then analyze the input itself.
+ */
+int cache_restore(const ResultCache *c, CacheKey key, const char *run_dir);
+
+/*
+ * Add the artifacts just written to `run_dir` under `key`.
+ * `slot` must be unique among concurrent callers in this process
+ * (the worker index).
+ */
+int cache_store(const ResultCache *c, CacheKey key,
+                const CacheEntry *entry, const char *run_dir,
+                unsigned slot);
+
+/* Evict least recently used entries down to max_bytes; returns the
+ * number removed */
+size_t cache_evict(const ResultCache *c);
+
+#endif /* LIMINAL_CMD_CACHE_H */
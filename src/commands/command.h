@@ -2,8 +2,10 @@
 #define LIMINAL_COMMAND_H
 
 #include "./analyze/analyze.h"
+#include "./batch/batch.h"
 #include "./diff/diff.h"
 #include "./policy/policy.h"
+#include "./serve/serve.h"
 
 typedef int (*command_fn)(int argc, char **argv);
 
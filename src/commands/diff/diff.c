@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "consumers/consumers.h"
@@ -8,57 +9,143 @@ void semantic_diff_render(
     const SemanticDiff *, size_t, FILE *
 );
 
+/* Timeline entries printed before "... N more" */
+#define TIMELINE_DIFF_SHOWN 1000
+
+/* Artifact paths of one run directory (<artifact-dir>/<run-id>) */
+typedef struct DiffRunPaths {
+    char meta[1024];
+    char diagnostics[1024];
+    char timeline[1024];
+    char timeline_bin[1024];
+} DiffRunPaths;
+
+static RunDescriptor describe_run(const char *dir, DiffRunPaths *p)
+{
+    snprintf(p->meta, sizeof(p->meta), "%s/meta.json", dir);
+    snprintf(p->diagnostics, sizeof(p->diagnostics),
+             "%s/diagnostics.ndjson", dir);
+    snprintf(p->timeline, sizeof(p->timeline), "%s/timeline.ndjson", dir);
+    snprintf(p->timeline_bin, sizeof(p->timeline_bin),
+             "%s/timeline.bin", dir);
+
+    RunDescriptor rd = {
+        .root_dir = dir,
+        .run_id = dir,
+        .meta_path = p->meta,
+        .diagnostics_path = p->diagnostics,
+        .timeline_path = p->timeline,
+        .timeline_bin_path = p->timeline_bin
+    };
+    return rd;
+}
+
+static void run_release(RunArtifact *r)
+{
+    diagnostic_artifact_free(&r->diagnostics);
+    free(r->timeline);
+    timeline_binary_close(&r->timeline_columns);
+}
+
+static void load_ndjson(const RunDescriptor *rd, RunArtifact *r)
+{
+    if (!r->timeline && rd->timeline_path) {
+        load_timeline(rd->timeline_path, &r->timeline, &r->timeline_count);
+    }
+}
+
 int cmd_diff(int argc, char **argv)
 {
     if (argc != 2) {
         fprintf(stderr,
-            "usage: liminal diff <run-A> <run-B>\n");
+            "usage: liminal diff <run-dir-A> <run-dir-B>\n");
         return 1;
     }
 
-    RunDescriptor a = {
-        .root_dir = argv[0],
-        .run_id = argv[0],
-        .meta_path = ".liminal/meta.json",
-        .diagnostics_path = ".liminal/diagnostics.ndjson",
-        .timeline_path = ".liminal/timeline.ndjson"
-    };
-
-    RunDescriptor b = {
-        .root_dir = argv[1],
-        .run_id = argv[1],
-        .meta_path = ".liminal/meta.json",
-        .diagnostics_path = ".liminal/diagnostics.ndjson",
-        .timeline_path = ".liminal/timeline.ndjson"
-    };
+    DiffRunPaths pa, pb;
+    RunDescriptor a = describe_run(argv[0], &pa);
+    RunDescriptor b = describe_run(argv[1], &pb);
 
     RunArtifact ra = {0};
     RunArtifact rb = {0};
 
     if (load_run(&a, &ra) != 0 ||
         load_run(&b, &rb) != 0) {
+        if (ra.timeline_bin_status != TIMELINE_BIN_OK) {
+            fprintf(stderr, "%s: %s\n", pa.timeline_bin,
+                    timeline_binary_status_name(ra.timeline_bin_status));
+        }
+        if (rb.timeline_bin_status != TIMELINE_BIN_OK) {
+            fprintf(stderr, "%s: %s\n", pb.timeline_bin,
+                    timeline_binary_status_name(rb.timeline_bin_status));
+        }
         fprintf(stderr, "failed to load runs\n");
+        run_release(&ra);
+        run_release(&rb);
+        return 1;
+    }
+
+    /* Every diagnostic of either run yields at most one entry */
+    size_t cap = ra.diagnostics.count + rb.diagnostics.count;
+    SemanticDiff *diffs = malloc((cap ? cap : 1) * sizeof(*diffs));
+    if (!diffs) {
+        fprintf(stderr, "out of memory\n");
+        run_release(&ra);
+        run_release(&rb);
         return 1;
     }
 
-    SemanticDiff diffs[256];
     size_t n = semantic_diff(
         &ra.diagnostics,
         &rb.diagnostics,
         diffs,
-        256
+        cap
     );
 
     semantic_diff_render(diffs, n, stdout);
+    free(diffs);
+
+    /*
+     * Aligned timelines; mapped columns when both runs have
+     * timeline.bin. Otherwise NDJSON, which load_run skipped for a
+     * run with columns.
+     */
+    if (!ra.timeline_columns.step || !rb.timeline_columns.step) {
+        load_ndjson(&a, &ra);
+        load_ndjson(&b, &rb);
+    }
 
-    FILE *ta = fopen(a.timeline_path, "r");
-    FILE *tb = fopen(b.timeline_path, "r");
+    TimelineDiff *steps = malloc(TIMELINE_DIFF_SHOWN * sizeof(*steps));
+    size_t total = 0;
+    int have = 1;
 
-    if (ta && tb) {
-        size_t d = timeline_diff_first_line(ta, tb);
-        if (d != (size_t)-1) {
-            printf("TIMELINE DIVERGENCE at line %zu\n", d);
-        }
+    if (!steps) {
+        total = TIMELINE_DIFF_NOMEM;
+    } else if (ra.timeline_columns.step && rb.timeline_columns.step) {
+        total = timeline_diff_columns(&ra.timeline_columns,
+                                      &rb.timeline_columns,
+                                      steps, TIMELINE_DIFF_SHOWN);
+    } else if (ra.timeline && rb.timeline) {
+        total = timeline_diff(ra.timeline, ra.timeline_count,
+                              rb.timeline, rb.timeline_count,
+                              steps, TIMELINE_DIFF_SHOWN);
+    } else {
+        have = 0;
     }
-    return 0;
+
+    int rc = 0;
+    if (total == TIMELINE_DIFF_NOMEM) {
+        fprintf(stderr, "out of memory\n");
+        rc = 1;
+    } else if (have && total > 0) {
+        timeline_diff_render(steps,
+                             total < TIMELINE_DIFF_SHOWN ? total
+                                                         : TIMELINE_DIFF_SHOWN,
+                             total, stdout);
+    }
+    free(steps);
+
+    run_release(&ra);
+    run_release(&rb);
+    return rc;
 }
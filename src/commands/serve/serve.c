@@ -0,0 +1,648 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "./serve.h"
+#include "common/common.h"
+#include "executor/executor.h"
+#include "analyzer/analyzer.h"
+#include "frontends/frontends.h"
+#include "policy/policy.h"
+
+/* Set from the signal handler; polled by the accept loop */
+static volatile sig_atomic_t serve_stop = 0;
+
+static void serve_on_signal(int sig)
+{
+    (void)sig;
+    serve_stop = 1;
+}
+
+/* ------------------------------------------------------------
+ * Requests
+ * ------------------------------------------------------------ */
+
+typedef struct ServeRequest {
+    char   *path;
+    char   *source;
+    size_t  source_len;
+    char   *name;
+    Policy  policy;
+    int     incremental;
+} ServeRequest;
+
+static void request_free(ServeRequest *req)
+{
+    free(req->path);
+    free(req->source);
+    free(req->name);
+    memset(req, 0, sizeof(*req));
+}
+
+/* Decoded, NUL-terminated copy of the next string value */
+static char *read_string(JsonReader *r, size_t *len)
+{
+    JsonStr s;
+    if (!json_read_string(r, &s)) {
+        return NULL;
+    }
+
+    char *out = malloc(s.len + 1);
+    if (!out) {
+        return NULL;
+    }
+
+    size_t n = json_str_decode(s, out);
+    if (n == (size_t)-1) {
+        free(out);
+        r->error = 1;
+        return NULL;
+    }
+
+    if (len) {
+        *len = n;
+    }
+    return out;
+}
+
+static int kind_from_name(JsonStr s, DiagnosticKind *out)
+{
+    for (int k = 0; k < DIAG_KIND_MAX; k++) {
+        if (json_str_eq(s, diagnostic_kind_name((DiagnosticKind)k))) {
+            *out = (DiagnosticKind)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static const char *read_policy(JsonReader *r, Policy *p)
+{
+    JsonStr key, s;
+    DiagnosticKind k;
+
+    memset(p, 0, sizeof(*p));
+
+    if (!json_object_begin(r)) {
+        return "policy must be an object";
+    }
+
+    while (json_object_next(r, &key)) {
+        if (json_str_eq(key, "deny")) {
+            if (!json_array_begin(r)) {
+                return "policy.deny must be an array";
+            }
+            while (json_array_next(r)) {
+                if (!json_read_string(r, &s)) {
+                    return "policy.deny must hold kind names";
+                }
+                if (!kind_from_name(s, &k)) {
+                    return "unknown diagnostic kind";
+                }
+                p->deny_kind[k] = 1;
+            }
+        } else if (json_str_eq(key, "max")) {
+            if (!json_object_begin(r)) {
+                return "policy.max must be an object";
+            }
+            while (json_object_next(r, &s)) {
+                uint64_t v;
+                if (!kind_from_name(s, &k)) {
+                    return "unknown diagnostic kind";
+                }
+                if (!json_read_u64(r, &v)) {
+                    return "policy.max values must be integers";
+                }
+                p->max_by_kind[k] = (size_t)v;
+            }
+        } else if (json_str_eq(key, "max_total")) {
+            uint64_t v;
+            if (!json_read_u64(r, &v)) {
+                return "policy.max_total must be an integer";
+            }
+            p->max_total = (size_t)v;
+        } else if (!json_skip(r)) {
+            break;
+        }
+    }
+
+    return r->error ? "malformed policy" : NULL;
+}
+
+/* NULL on success, otherwise the reason the request was rejected */
+static const char *read_request(const char *line, size_t len,
+                                ServeRequest *req)
+{
+    JsonReader r;
+    JsonStr key;
+
+    memset(req, 0, sizeof(*req));
+    req->policy = LIMINAL_DEFAULT_POLICY;
+
+    json_reader_init(&r, line, len);
+    if (!json_object_begin(&r)) {
+        return "request must be a JSON object";
+    }
+
+    while (json_object_next(&r, &key)) {
+        if (json_str_eq(key, "path") && !req->path) {
+            if (!(req->path = read_string(&r, NULL))) {
+                return "path must be a string";
+            }
+        } else if (json_str_eq(key, "source") && !req->source) {
+            if (!(req->source = read_string(&r, &req->source_len))) {
+                return "source must be a string";
+            }
+        } else if (json_str_eq(key, "name") && !req->name) {
+            if (!(req->name = read_string(&r, NULL))) {
+                return "name must be a string";
+            }
+        } else if (json_str_eq(key, "policy")) {
+            const char *err = read_policy(&r, &req->policy);
+            if (err) {
+                return err;
+            }
+        } else if (json_str_eq(key, "incremental")) {
+            if (!json_read_bool(&r, &req->incremental)) {
+                return "incremental must be a boolean";
+            }
+        } else if (!json_skip(&r)) {
+            break;
+        }
+    }
+
+    if (r.error || !json_at_end(&r)) {
+        return "malformed JSON";
+    }
+    if (!req->path == !req->source) {
+        return "exactly one of path or source is required";
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------
+ * Workers
+ * ------------------------------------------------------------ */
+
+struct Server;
+
+typedef struct ServeWorker {
+    struct Server *server;
+    pthread_t      thread;
+    int            started;
+
+    /* Recycled between requests */
+    ASTProgram *ast;
+    Universe   *universe;
+
+    /* Connection being served, -1 when idle (under server lock) */
+    int active_fd;
+} ServeWorker;
+
+typedef struct Server {
+    /* Accepted connections waiting for a worker (ring) */
+    int    *queue;
+    size_t  queue_cap;
+    size_t  queue_head;
+    size_t  queue_count;
+    int     closing;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+
+    ServeWorker *workers;
+    unsigned     worker_count;
+} Server;
+
+static const char *decision_name(PolicyDecision d)
+{
+    switch (d) {
+    case POLICY_ALLOW: return "allow";
+    case POLICY_WARN:  return "warn";
+    case POLICY_DENY:  return "deny";
+    }
+    return "allow";
+}
+
+static void reply_error(FILE *out, const char *reason)
+{
+    fprintf(out, "{\"status\":\"error\",\"error\":\"%s\"}\n", reason);
+}
+
+/*
+ * Analyze `w->ast`: the whole program, or through the connection's
+ * incremental session (created on first use). NULL on failure.
+ */
+static const DiagnosticArtifact *serve_analyze(ServeWorker *w,
+                                               Incremental **inc,
+                                               int incremental,
+                                               DiagnosticArtifact *whole)
+{
+    if (incremental) {
+        if (!*inc && !(*inc = incremental_create())) {
+            return NULL;
+        }
+        return incremental_run(*inc, w->ast) ? &(*inc)->diagnostics : NULL;
+    }
+
+    if (!universe_reset(w->universe) ||
+        !executor_run(w->universe, w->ast)) {
+        return NULL;
+    }
+    *whole = analyze_diagnostics(&w->universe->timeline);
+    return whole->items ? whole : NULL;
+}
+
+static void serve_request(ServeWorker *w, Incremental **inc,
+                          const char *line, size_t len, FILE *out)
+{
+    ServeRequest req;
+    const char *err = read_request(line, len, &req);
+    if (err) {
+        reply_error(out, err);
+        request_free(&req);
+        return;
+    }
+
+    /* ---- FRONTEND ---- */
+    w->ast = req.path
+        ? c_parse_file_recycle(req.path, w->ast)
+        : c_parse_source_recycle(req.name ? req.name : "<source>",
+                                 req.source, req.source_len, w->ast);
+    if (!w->ast) {
+        reply_error(out, "failed to parse AST");
+        request_free(&req);
+        return;
+    }
+
+    /* ---- EXECUTOR + ANALYSIS ---- */
+    DiagnosticArtifact whole = {0};
+    const DiagnosticArtifact *diagnostics =
+        serve_analyze(w, inc, req.incremental, &whole);
+
+    if (!diagnostics) {
+        reply_error(out, "failed to build execution artifact");
+    } else {
+        /* ---- POLICY ---- */
+        PolicyDecision d = policy_evaluate(&req.policy, diagnostics);
+
+        diagnostic_project_ndjson(diagnostics, out);
+        fprintf(out,
+                "{\"status\":\"ok\",\"decision\":\"%s\","
+                "\"diagnostics\":%zu",
+                decision_name(d), diagnostics->count);
+        if (req.incremental) {
+            fprintf(out, ",\"functions\":%zu,\"reanalyzed\":%zu",
+                    (*inc)->functions, (*inc)->reanalyzed);
+        }
+        fputs("}\n", out);
+    }
+    diagnostic_artifact_free(&whole);
+
+    /* Inline source was borrowed; the AST is kept for recycling */
+    if (req.source) {
+        w->ast->source_text = NULL;
+        w->ast->source_len = 0;
+    }
+    request_free(&req);
+}
+
+/* One request per line until the client closes its end */
+static void serve_client(ServeWorker *w, int fd)
+{
+    int out_fd = dup(fd);
+    FILE *in  = fdopen(fd, "r");
+    FILE *out = out_fd >= 0 ? fdopen(out_fd, "w") : NULL;
+
+    if (!in || !out) {
+        if (in) fclose(in); else close(fd);
+        if (out) fclose(out); else if (out_fd >= 0) close(out_fd);
+        return;
+    }
+
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+
+    /* Incremental requests share one session per connection */
+    Incremental *inc = NULL;
+
+    while ((n = getline(&line, &cap, in)) > 0) {
+        size_t len = (size_t)n;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+            len--;
+        }
+        if (len == 0) {
+            continue;
+        }
+
+        serve_request(w, &inc, line, len, out);
+        if (fflush(out) != 0) {
+            break; /* client went away */
+        }
+    }
+
+    incremental_destroy(inc);
+    free(line);
+    fclose(in);
+    fclose(out);
+}
+
+static void *serve_worker(void *arg)
+{
+    ServeWorker *w = arg;
+    Server *s = w->server;
+
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (s->queue_count == 0 && !s->closing) {
+            pthread_cond_wait(&s->not_empty, &s->lock);
+        }
+        if (s->queue_count == 0) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+
+        int fd = s->queue[s->queue_head];
+        s->queue_head = (s->queue_head + 1) % s->queue_cap;
+        s->queue_count--;
+
+        int closing = s->closing;
+        w->active_fd = closing ? -1 : fd;
+        pthread_cond_signal(&s->not_full);
+        pthread_mutex_unlock(&s->lock);
+
+        if (closing) {
+            close(fd);
+            continue;
+        }
+
+        serve_client(w, fd);
+
+        pthread_mutex_lock(&s->lock);
+        w->active_fd = -1;
+        pthread_mutex_unlock(&s->lock);
+    }
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------
+ * Socket
+ * ------------------------------------------------------------ */
+
+static int serve_listen(const char *path, int backlog)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "serve: socket path too long\n");
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    /* Replace a stale socket, but never a live server or a file */
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "serve: '%s' exists and is not a socket\n",
+                    path);
+            return -1;
+        }
+
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        int live = probe >= 0 &&
+            connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if (probe >= 0) close(probe);
+
+        if (live) {
+            fprintf(stderr, "serve: already serving on '%s'\n", path);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("serve: socket");
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, backlog) != 0) {
+        perror("serve: bind");
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Wait for room in the queue; 0 if asked to stop meanwhile */
+static int wait_for_room(Server *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->queue_count == s->queue_cap && !serve_stop) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += 100 * 1000 * 1000;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&s->not_full, &s->lock, &ts);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return !serve_stop;
+}
+
+static int parse_count(const char *flag, const char *v, long lo, long hi,
+                       long *out)
+{
+    char *end = NULL;
+    long n = v ? strtol(v, &end, 10) : 0;
+    if (!v || *end != '\0' || n < lo || n > hi) {
+        fprintf(stderr, "error: %s requires a number\n", flag);
+        return 0;
+    }
+    *out = n;
+    return 1;
+}
+
+int cmd_serve(int argc, char **argv)
+{
+    const char *socket_path = NULL;
+    long workers = 0;
+    long queue = 64;
+
+    /* ---- ARG PARSING ---- */
+    for (int i = 0; i < argc; i++) {
+        const char *next = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--socket") == 0) {
+            if (!next) {
+                fprintf(stderr, "error: --socket requires a path\n");
+                return 1;
+            }
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "-j") == 0) {
+            if (!parse_count("-j", next, 0, 1024, &workers)) return 1;
+            i++;
+        } else if (strncmp(argv[i], "-j", 2) == 0) {
+            if (!parse_count("-j", argv[i] + 2, 0, 1024, &workers)) return 1;
+        } else if (strcmp(argv[i], "--queue") == 0) {
+            if (!parse_count("--queue", next, 1, 65536, &queue)) return 1;
+            i++;
+        } else {
+            fprintf(stderr, "error: unexpected argument '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!socket_path) {
+        fprintf(stderr, "error: --socket <path> is required\n");
+        return 1;
+    }
+    if (workers == 0) {
+        workers = (long)pool_cpu_count();
+    }
+
+    int lfd = serve_listen(socket_path, (int)queue);
+    if (lfd < 0) {
+        return 1;
+    }
+
+    Server s = {
+        .queue        = calloc((size_t)queue, sizeof(int)),
+        .queue_cap    = (size_t)queue,
+        .workers      = calloc((size_t)workers, sizeof(ServeWorker)),
+        .worker_count = (unsigned)workers
+    };
+
+    int ok = s.queue && s.workers;
+    for (unsigned i = 0; ok && i < s.worker_count; i++) {
+        s.workers[i].server = &s;
+        s.workers[i].active_fd = -1;
+        s.workers[i].universe = universe_create();
+        ok = s.workers[i].universe != NULL;
+    }
+
+    pthread_mutex_init(&s.lock, NULL);
+    pthread_cond_init(&s.not_empty, NULL);
+    pthread_cond_init(&s.not_full, NULL);
+
+    /* Writes to departed clients must not kill the server */
+    signal(SIGPIPE, SIG_IGN);
+
+    /* No SA_RESTART: a signal interrupts poll() */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = serve_on_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    /* Workers block the stop signals so they reach this thread */
+    sigset_t stop, old;
+    sigemptyset(&stop);
+    sigaddset(&stop, SIGINT);
+    sigaddset(&stop, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop, &old);
+
+    unsigned running = 0;
+    for (unsigned i = 0; ok && i < s.worker_count; i++) {
+        ServeWorker *w = &s.workers[i];
+        w->started = pthread_create(&w->thread, NULL, serve_worker, w) == 0;
+        running += (unsigned)w->started;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (!ok || running == 0) {
+        fprintf(stderr, "serve: could not start workers\n");
+        serve_stop = 1;
+    } else {
+        fprintf(stderr, "serve: listening on %s (%u workers, queue %ld)\n",
+                socket_path, running, queue);
+    }
+
+    /* ---- ACCEPT LOOP ---- */
+    while (wait_for_room(&s)) {
+        /* Wake up now and then so a stop request is never missed */
+        struct pollfd pfd = { .fd = lfd, .events = POLLIN };
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+
+        int fd = accept(lfd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            perror("serve: accept");
+            break;
+        }
+
+        pthread_mutex_lock(&s.lock);
+        size_t tail = (s.queue_head + s.queue_count) % s.queue_cap;
+        s.queue[tail] = fd;
+        s.queue_count++;
+        pthread_cond_signal(&s.not_empty);
+        pthread_mutex_unlock(&s.lock);
+    }
+
+    /* ---- SHUTDOWN ---- */
+    close(lfd);
+    unlink(socket_path);
+
+    pthread_mutex_lock(&s.lock);
+    s.closing = 1;
+    for (unsigned i = 0; i < s.worker_count; i++) {
+        if (s.workers[i].active_fd >= 0) {
+            shutdown(s.workers[i].active_fd, SHUT_RD);
+        }
+    }
+    pthread_cond_broadcast(&s.not_empty);
+    pthread_mutex_unlock(&s.lock);
+
+    for (unsigned i = 0; i < s.worker_count; i++) {
+        if (s.workers[i].started) {
+            pthread_join(s.workers[i].thread, NULL);
+        }
+    }
+
+    /* Nothing was left to drain if no worker ever ran */
+    while (s.queue_count > 0) {
+        close(s.queue[s.queue_head]);
+        s.queue_head = (s.queue_head + 1) % s.queue_cap;
+        s.queue_count--;
+    }
+
+    for (unsigned i = 0; s.workers && i < s.worker_count; i++) {
+        ast_program_free(s.workers[i].ast);
+        universe_destroy(s.workers[i].universe);
+    }
+
+    pthread_cond_destroy(&s.not_full);
+    pthread_cond_destroy(&s.not_empty);
+    pthread_mutex_destroy(&s.lock);
+    free(s.workers);
+    free(s.queue);
+
+    fprintf(stderr, "serve: stopped\n");
+    return ok && running > 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#ifndef LIMINAL_CMD_SERVE_H
+#define LIMINAL_CMD_SERVE_H
+
+/*
+ * cmd_serve
+ *
+ *   liminal serve --socket <path> [-j N] [--queue N]
+ *
+ * Long-running analysis daemon on a Unix domain socket.
+ *
+ * Protocol: NDJSON. A client sends one request object per line
+ * and may send any number of them on one connection:
+ *
+ *   {"path": "src/a.c"}
+ *   {"source": "int main() { x; }", "name": "buffer.c",
+ *    "policy": {"deny": ["REDECLARATION"],
+ *               "max": {"SHADOWING": 4},
+ *               "max_total": 64}}
+ *
+ * Exactly one of "path" or "source" is required. "name" labels
+ * inline source (default "<source>"). "policy" replaces the
+ * default policy; omitted fields are unlimited / not denied.
+ * "incremental": true analyzes through a session kept for the
+ * connection, re-executing only the functions that changed since
+ * its previous incremental request (an editor saving one file);
+ * the result is the same as without it. Unknown members are
+ * ignored.
+ *
+ * For each request the server writes the diagnostics records of
+ * `run` (diagnostic_project_ndjson), then one status line:
+ *
+ *   {"status":"ok","decision":"allow|warn|deny","diagnostics":N}
+ *   {"status":"error","error":"<reason>"}
+ *
+ * Incremental requests add "functions" and "reanalyzed" counts to
+ * the ok line.
+ *
+ * Connections are queued (at most --queue, default 64) and served
+ * by N worker threads (-j, default one per CPU). When the queue is
+ * full the server stops accepting, so further clients wait in the
+ * listen backlog. Each worker recycles its own ASTProgram and
+ * Universe between requests.
+ *
+ * SIGINT / SIGTERM stop the server: queued connections are
+ * closed, open ones are shut down for reading and finish the
+ * request in flight, and the socket file is removed.
+ */
+int cmd_serve(int argc, char **argv);
+
+#endif /* LIMINAL_CMD_SERVE_H */
@@ -1,39 +1,208 @@
+#define _DEFAULT_SOURCE
+
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include "common/common.h"
 
+#if !defined(ARENA_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#endif
+
+#if defined(MAP_ANONYMOUS) || defined(MAP_ANON)
+#define ARENA_HAVE_MMAP 1
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+#ifndef ARENA_MMAP_THRESHOLD
+#define ARENA_MMAP_THRESHOLD (2u * 1024 * 1024)
+#endif
+
+/* Growth stops doubling past this; bigger requests still fit */
+#ifndef ARENA_CHUNK_MAX
+#define ARENA_CHUNK_MAX (64u * 1024 * 1024)
+#endif
+
+#define ARENA_ALIGN 8u
+
+struct ArenaChunk {
+    struct ArenaChunk *prev;
+    size_t capacity;        /* usable bytes in data[] */
+    size_t offset;
+    size_t mapped;          /* size_t, so data[] stays aligned */
+    unsigned char data[];
+};
+
+/* Offsets are aligned relative to data[], so data[] itself must be */
+typedef char arena_data_aligned[
+    offsetof(ArenaChunk, data) % ARENA_ALIGN == 0 ? 1 : -1];
+
+static ArenaChunk *chunk_new(size_t capacity)
+{
+    size_t total = sizeof(ArenaChunk) + capacity;
+    ArenaChunk *c = NULL;
+    size_t mapped = 0;
+
+#ifdef ARENA_HAVE_MMAP
+    if (total >= ARENA_MMAP_THRESHOLD) {
+        void *p = mmap(NULL, total, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+            madvise(p, total, MADV_HUGEPAGE);
+#endif
+            c = p;
+            mapped = 1;
+        }
+    }
+#endif
+
+    if (!c) {
+        c = malloc(total);
+        if (!c) {
+            return NULL;
+        }
+    }
+
+    c->prev = NULL;
+    c->capacity = capacity;
+    c->offset = 0;
+    c->mapped = mapped;
+    return c;
+}
+
+static void chunk_free(ArenaChunk *c)
+{
+#ifdef ARENA_HAVE_MMAP
+    if (c->mapped) {
+        munmap(c, sizeof(ArenaChunk) + c->capacity);
+        return;
+    }
+#endif
+    free(c);
+}
+
+/*
+ * Append a chunk large enough for `size` bytes.
+ */
+static int arena_grow(Arena *a, size_t size)
+{
+    size_t cap = a->next_size;
+    if (cap < size) {
+        cap = size;
+    }
+
+    ArenaChunk *c = chunk_new(cap);
+    if (!c) {
+        return 0;
+    }
+
+    c->prev = a->chunk;
+    a->chunk = c;
+    a->reserved += cap;
+    a->chunks++;
+
+    if (a->next_size < ARENA_CHUNK_MAX) {
+        a->next_size *= 2;
+    }
+
+    return 1;
+}
+
 void arena_init(Arena *a, size_t capacity)
 {
-    a->base = malloc(capacity);
-    a->capacity = capacity;
-    a->offset = 0;
+    a->chunk = NULL;
+    a->next_size = capacity ? capacity : 4096;
+    a->used = 0;
+    a->reserved = 0;
+    a->high_water = 0;
+    a->chunks = 0;
+
+    /* First chunk is eager; failure is retried on first alloc */
+    arena_grow(a, 0);
 }
 
-void *arena_alloc(Arena *a, size_t size)
+void *arena_alloc_uninit(Arena *a, size_t size)
 {
+    if (size > SIZE_MAX - ARENA_ALIGN) {
+        return NULL;
+    }
+
     /* align to 8 bytes */
-    size = (size + 7) & ~7;
+    size = (size + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
 
-    if (a->offset + size > a->capacity) {
-        return NULL;
+    ArenaChunk *c = a->chunk;
+    if (!c || c->capacity - c->offset < size) {
+        if (!arena_grow(a, size)) {
+            return NULL;
+        }
+        c = a->chunk;
     }
 
-    void *ptr = a->base + a->offset;
-    a->offset += size;
+    void *ptr = c->data + c->offset;
+    c->offset += size;
+
+    a->used += size;
+    if (a->used > a->high_water) {
+        a->high_water = a->used;
+    }
 
-    memset(ptr, 0, size);
+    return ptr;
+}
+
+void *arena_alloc(Arena *a, size_t size)
+{
+    void *ptr = arena_alloc_uninit(a, size);
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
     return ptr;
 }
 
 void arena_reset(Arena *a)
 {
-    a->offset = 0;
+    ArenaChunk *keep = a->chunk;
+    if (!keep) {
+        a->used = 0;
+        return;
+    }
+
+    ArenaChunk *c = keep->prev;
+    while (c) {
+        ArenaChunk *prev = c->prev;
+        chunk_free(c);
+        c = prev;
+    }
+
+    keep->prev = NULL;
+    keep->offset = 0;
+
+    a->used = 0;
+    a->reserved = keep->capacity;
+    a->chunks = 1;
 }
 
 void arena_destroy(Arena *a)
 {
-    free(a->base);
-    a->base = NULL;
-    a->capacity = 0;
-    a->offset = 0;
+    ArenaChunk *c = a->chunk;
+    while (c) {
+        ArenaChunk *prev = c->prev;
+        chunk_free(c);
+        c = prev;
+    }
+
+    a->chunk = NULL;
+    a->used = 0;
+    a->reserved = 0;
+    a->chunks = 0;
+}
+
+void arena_stats(const Arena *a, ArenaStats *out)
+{
+    out->used       = a->used;
+    out->reserved   = a->reserved;
+    out->high_water = a->high_water;
+    out->chunks     = a->chunks;
 }
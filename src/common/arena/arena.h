@@ -3,15 +3,60 @@
 
 #include <stddef.h>
 
+/*
+ * Arena
+ *
+ * Monotonic, chunked bump allocator.
+ *
+ * When the current chunk is full a new one is appended, roughly
+ * twice the size of the previous one. Chunks are never moved, so
+ * every pointer handed out stays valid until reset/destroy.
+ *
+ * Chunks of ARENA_MMAP_THRESHOLD bytes or more are mapped directly
+ * (with a transparent huge-page hint where available) instead of
+ * going through malloc. Build with -DARENA_NO_MMAP to disable.
+ *
+ * arena_alloc returns zeroed memory.
+ * arena_alloc_uninit skips the memset for callers that initialise
+ * every field themselves.
+ *
+ * Both return NULL only when the system is out of memory.
+ */
+
+typedef struct ArenaChunk ArenaChunk;
+
 typedef struct Arena {
-    unsigned char *base;
-    size_t capacity;
-    size_t offset;
+    ArenaChunk *chunk;      /* current chunk (newest) */
+    size_t next_size;       /* capacity of the next chunk */
+
+    size_t used;            /* bytes handed out since last reset */
+    size_t reserved;        /* bytes held in chunks */
+    size_t high_water;      /* max `used` ever observed */
+    size_t chunks;          /* live chunk count */
 } Arena;
 
+typedef struct ArenaStats {
+    size_t used;
+    size_t reserved;
+    size_t high_water;
+    size_t chunks;
+} ArenaStats;
+
+/* `capacity` is the size of the first chunk */
 void arena_init(Arena *a, size_t capacity);
+
 void *arena_alloc(Arena *a, size_t size);
+void *arena_alloc_uninit(Arena *a, size_t size);
+
+/*
+ * Forget all allocations.
+ * Keeps the newest (largest) chunk for reuse, releases the rest.
+ * The high-water mark survives resets.
+ */
 void arena_reset(Arena *a);
+
 void arena_destroy(Arena *a);
 
+void arena_stats(const Arena *a, ArenaStats *out);
+
 #endif
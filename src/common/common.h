@@ -4,6 +4,13 @@
 #include "./arena/arena.h"
 #include "./file/file.h"
 #include "./fs/fs.h"
+#include "./hash/hash.h"
 #include "./hashmap/hashmap.h"
+#include "./intern/intern.h"
+#include "./json/json.h"
+#include "./json/ndjson.h"
+#include "./json/writer.h"
+#include "./pool/pool.h"
+#include "./version/version.h"
 
 #endif
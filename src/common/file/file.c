@@ -1,7 +1,18 @@
+#define _DEFAULT_SOURCE
+
 #include "common/common.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if !defined(FILE_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#define FILE_HAVE_MMAP 1
+#endif
 
 int read_entire_file(
     const char *path,
@@ -46,3 +57,109 @@ int read_entire_file(
     *out_len = (size_t)size;
     return 1;
 }
+
+/* Read `fd` to EOF into a growing heap buffer */
+static int source_read_fd(SourceBuffer *sb, int fd, size_t hint)
+{
+    size_t cap = hint ? hint + 1 : 64 * 1024;
+    size_t len = 0;
+    char *buf = malloc(cap);
+    if (!buf) {
+        return 0;
+    }
+
+    for (;;) {
+        if (len == cap) {
+            size_t ncap = cap * 2;
+            char *nb = realloc(buf, ncap);
+            if (!nb) {
+                free(buf);
+                return 0;
+            }
+            buf = nb;
+            cap = ncap;
+        }
+
+        ssize_t n = read(fd, buf + len, cap - len);
+        if (n < 0) {
+            free(buf);
+            return 0;
+        }
+        if (n == 0) {
+            break;
+        }
+        len += (size_t)n;
+    }
+
+    sb->data = buf;
+    sb->len  = len;
+    sb->heap = buf;
+    return 1;
+}
+
+int source_buffer_open(SourceBuffer *sb, const char *path)
+{
+    if (!sb || !path) {
+        return 0;
+    }
+
+    memset(sb, 0, sizeof(*sb));
+
+    if (strcmp(path, "-") == 0) {
+        return source_read_fd(sb, STDIN_FILENO, 0);
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    int ok = 0;
+
+#ifdef FILE_HAVE_MMAP
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = (size_t)st.st_size;
+        void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            /* The lexer reads front to back exactly once */
+            madvise(map, size, MADV_SEQUENTIAL);
+#endif
+            sb->data    = map;
+            sb->len     = size;
+            sb->map     = map;
+            sb->map_len = size;
+            ok = 1;
+        }
+    }
+#endif
+
+    if (!ok) {
+        size_t hint = S_ISREG(st.st_mode) ? (size_t)st.st_size : 0;
+        ok = source_read_fd(sb, fd, hint);
+    }
+
+    close(fd);
+    return ok;
+}
+
+void source_buffer_close(SourceBuffer *sb)
+{
+    if (!sb) {
+        return;
+    }
+
+#ifdef FILE_HAVE_MMAP
+    if (sb->map) {
+        munmap(sb->map, sb->map_len);
+    }
+#endif
+    free(sb->heap);
+    memset(sb, 0, sizeof(*sb));
+}
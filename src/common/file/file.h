@@ -18,4 +18,30 @@ int read_entire_file(
     size_t     *out_len
 );
 
+/*
+ * SourceBuffer
+ *
+ * Read-only view of a whole input file.
+ *
+ * Regular files are memory-mapped, so nothing is copied and the
+ * pages are shared with the page cache. Anything that cannot be
+ * mapped (pipes, stdin via "-", empty files, platforms without
+ * mmap, or a build with -DFILE_NO_MMAP) is read into the heap.
+ *
+ * `data` is NOT NUL-terminated when mapped; always use `len`.
+ * The view stays valid until source_buffer_close.
+ */
+typedef struct SourceBuffer {
+    const char *data;
+    size_t      len;
+
+    void  *map;       /* mapping base, NULL when read */
+    size_t map_len;
+    char  *heap;      /* read fallback, NULL when mapped */
+} SourceBuffer;
+
+/* Returns 1 on success, 0 on failure (nothing to close) */
+int  source_buffer_open(SourceBuffer *sb, const char *path);
+void source_buffer_close(SourceBuffer *sb);
+
 #endif /* LIMINAL_FILE_H */
@@ -16,7 +16,7 @@ bool fs_mkdir_if_missing(const char *path)
 
 bool fs_write_file(const char *path, const char *data, size_t len)
 {
-    FILE *f = fopen(path, "w");
+    FILE *f = fs_open_file(path);
     if (!f)
         return false;
 
@@ -25,7 +25,12 @@ bool fs_write_file(const char *path, const char *data, size_t len)
     return true;
 }
 
+/*
+ * Replace rather than truncate: an existing file may be a hard
+ * link into the result cache, which must not be rewritten.
+ */
 FILE *fs_open_file(const char *path)
 {
+    remove(path);
     return fopen(path, "w");
 }
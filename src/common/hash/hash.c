@@ -0,0 +1,115 @@
+#include "./hash.h"
+
+#include <string.h>
+
+static const uint64_t SECRET[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+/* 64x64 -> 128 multiply; *a gets the low half, *b the high */
+static void mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 u128;
+    u128 r = (u128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, la = (uint32_t)*a;
+    uint64_t hb = *b >> 32, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b)
+{
+    mum(&a, &b);
+    return a ^ b;
+}
+
+static uint64_t r8(const uint8_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static uint64_t r4(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/* 1..3 bytes */
+static uint64_t r3(const uint8_t *p, size_t k)
+{
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t hash64(const void *data, size_t len, uint64_t seed)
+{
+    const uint8_t *p = data;
+    uint64_t a, b;
+
+    seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t off = (len >> 3) << 2;
+            a = (r4(p) << 32) | r4(p + off);
+            b = (r4(p + len - 4) << 32) | r4(p + len - 4 - off);
+        } else if (len > 0) {
+            a = r3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(r8(p) ^ SECRET[1], r8(p + 8) ^ seed);
+                see1 = mix(r8(p + 16) ^ SECRET[2], r8(p + 24) ^ see1);
+                see2 = mix(r8(p + 32) ^ SECRET[3], r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = mix(r8(p) ^ SECRET[1], r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = r8(p + i - 16);
+        b = r8(p + i - 8);
+    }
+
+    a ^= SECRET[1];
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+}
+
+uint64_t hash64_mix(uint64_t a, uint64_t b)
+{
+    return mix(a ^ SECRET[0], b ^ SECRET[1]);
+}
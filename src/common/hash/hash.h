@@ -0,0 +1,22 @@
+#ifndef LIMINAL_HASH_H
+#define LIMINAL_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * hash64
+ *
+ * Fast non-cryptographic 64-bit hash of `len` bytes (wyhash
+ * construction: 48 bytes per round through 64x64->128 multiplies).
+ *
+ * Input is read as little-endian words, so values are the same on
+ * every host and may be persisted. Different seeds give
+ * independent hashes.
+ */
+uint64_t hash64(const void *data, size_t len, uint64_t seed);
+
+/* Mix two 64-bit values into one (for combining hashes) */
+uint64_t hash64_mix(uint64_t a, uint64_t b);
+
+#endif /* LIMINAL_HASH_H */
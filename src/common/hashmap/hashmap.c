@@ -3,130 +3,272 @@
 #include <string.h>
 #include <stdint.h>
 
-typedef struct HashEntry {
-    const char *key;
+/*
+ * Hash array mapped trie over symbol keys.
+ *
+ * Each level consumes HASH_BITS of the key and indexes a sparse
+ * 2^HASH_BITS-way node. `bitmap` marks occupied slots and `childmap`
+ * marks the subset of those slots that point at a sub-node rather
+ * than at a HashLeaf.
+ *
+ * Symbols are dense and unique, so the key is its own hash: two
+ * distinct keys always part within 32 bits and no collision handling
+ * is needed. Sequential symbols fill nodes left to right.
+ *
+ * Slots are single pointers and leaves are allocated once, so copying
+ * a node on the insert path costs 8 bytes per occupied slot.
+ */
+
+#define HASH_BITS  4u
+#define HASH_MASK  ((1u << HASH_BITS) - 1u)
+#define HASH_WIDTH 32u
+
+typedef struct HashLeaf {
+    uint32_t key;
     void *value;
-    struct HashEntry *next;
-} HashEntry;
+} HashLeaf;
+
+typedef struct HashNode {
+    uint32_t bitmap;
+    uint32_t childmap;
+    const void *slots[];   /* HashLeaf * or HashNode * */
+} HashNode;
 
 struct HashMap {
     struct Arena *arena;
-    size_t bucket_count;
-    HashEntry **buckets;
+    const HashNode *root;
+    size_t count;
 };
 
-/* Simple FNV-1a hash */
-static uint64_t hash_str(const char *s)
+static unsigned popcount32(uint32_t x)
 {
-    uint64_t h = 1469598103934665603ULL;
-    while (*s) {
-        h ^= (unsigned char)*s++;
-        h *= 1099511628211ULL;
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0f0f0f0fu;
+    return (unsigned)((x * 0x01010101u) >> 24);
+}
+
+/* Callers fill every slot, so skip zeroing */
+static HashNode *node_alloc(
+    struct Arena *arena,
+    unsigned slots,
+    uint32_t bitmap,
+    uint32_t childmap
+)
+{
+    HashNode *n = arena_alloc_uninit(
+        arena, sizeof(HashNode) + slots * sizeof(void *));
+    if (n) {
+        n->bitmap   = bitmap;
+        n->childmap = childmap;
     }
-    return h;
+    return n;
 }
 
-HashMap *hashmap_create(struct Arena *arena, size_t bucket_count)
+static HashLeaf *leaf_new(struct Arena *arena, uint32_t key, void *value)
 {
-    if (!arena || bucket_count == 0) {
+    HashLeaf *l = arena_alloc_uninit(arena, sizeof(HashLeaf));
+    if (!l) {
         return NULL;
     }
+    l->key   = key;
+    l->value = value;
+    return l;
+}
 
-    HashMap *map = arena_alloc(arena, sizeof(HashMap));
-    if (!map) {
+/*
+ * Build the smallest subtree holding two leaves with distinct keys.
+ */
+static HashNode *node_pair(
+    struct Arena *arena,
+    unsigned shift,
+    const HashLeaf *a,
+    const HashLeaf *b
+)
+{
+    uint32_t ba = 1u << ((a->key >> shift) & HASH_MASK);
+    uint32_t bb = 1u << ((b->key >> shift) & HASH_MASK);
+
+    if (ba == bb) {
+        HashNode *child = node_pair(arena, shift + HASH_BITS, a, b);
+        HashNode *n = node_alloc(arena, 1, ba, ba);
+        if (!child || !n) {
+            return NULL;
+        }
+        n->slots[0] = child;
+        return n;
+    }
+
+    HashNode *n = node_alloc(arena, 2, ba | bb, 0);
+    if (!n) {
         return NULL;
     }
+    n->slots[ba < bb ? 0 : 1] = a;
+    n->slots[ba < bb ? 1 : 0] = b;
+    return n;
+}
 
-    map->arena = arena;
-    map->bucket_count = bucket_count;
+/*
+ * Copy `n` with room for `extra` additional slots.
+ */
+static HashNode *node_copy(
+    struct Arena *arena,
+    const HashNode *n,
+    unsigned size,
+    unsigned extra
+)
+{
+    HashNode *c = node_alloc(arena, size + extra, n->bitmap, n->childmap);
+    if (!c) {
+        return NULL;
+    }
+    memcpy(c->slots, n->slots, size * sizeof(void *));
+    return c;
+}
+
+/*
+ * Path-copying insert of `leaf`. Returns the replacement for `n`.
+ * `*added` is set when the key did not exist before.
+ */
+static HashNode *node_put(
+    struct Arena *arena,
+    const HashNode *n,
+    unsigned shift,
+    const HashLeaf *leaf,
+    int *added
+)
+{
+    unsigned size = popcount32(n->bitmap);
+    uint32_t bit = 1u << ((leaf->key >> shift) & HASH_MASK);
+    unsigned idx = popcount32(n->bitmap & (bit - 1));
+
+    /* Empty slot: widen the node */
+    if (!(n->bitmap & bit)) {
+        HashNode *c = node_alloc(arena, size + 1,
+                                 n->bitmap | bit, n->childmap);
+        if (!c) {
+            return NULL;
+        }
+        memcpy(c->slots, n->slots, idx * sizeof(void *));
+        c->slots[idx] = leaf;
+        memcpy(c->slots + idx + 1, n->slots + idx,
+               (size - idx) * sizeof(void *));
+        *added = 1;
+        return c;
+    }
 
-    map->buckets = arena_alloc(arena, sizeof(HashEntry *) * bucket_count);
-    if (!map->buckets) {
+    HashNode *c = node_copy(arena, n, size, 0);
+    if (!c) {
         return NULL;
     }
 
-    memset(map->buckets, 0, sizeof(HashEntry *) * bucket_count);
-    return map;
+    /* Sub-node: recurse and replace the child pointer */
+    if (n->childmap & bit) {
+        c->slots[idx] = node_put(arena, n->slots[idx],
+                                 shift + HASH_BITS, leaf, added);
+        return c->slots[idx] ? c : NULL;
+    }
+
+    /* Same key: the new leaf replaces the old one */
+    const HashLeaf *old = n->slots[idx];
+    if (old->key == leaf->key) {
+        c->slots[idx] = leaf;
+        return c;
+    }
+
+    /* Different key in the same slot: push both one level down */
+    c->slots[idx] = node_pair(arena, shift + HASH_BITS, old, leaf);
+    c->childmap |= bit;
+    *added = 1;
+    return c->slots[idx] ? c : NULL;
 }
 
-HashMap *hashmap_clone(HashMap *src, struct Arena *arena)
+HashMap *hashmap_create(struct Arena *arena)
 {
     if (!arena) {
         return NULL;
     }
 
-    if (!src) {
-        /* Create empty map if no parent */
-        return hashmap_create(arena, 32);
-    }
-
     HashMap *map = arena_alloc(arena, sizeof(HashMap));
     if (!map) {
         return NULL;
     }
 
     map->arena = arena;
-    map->bucket_count = src->bucket_count;
-
-    map->buckets = arena_alloc(arena, sizeof(HashEntry *) * map->bucket_count);
-    if (!map->buckets) {
-        return NULL;
-    }
-
-    /* Structural (shallow) copy */
-    memcpy(
-        map->buckets,
-        src->buckets,
-        sizeof(HashEntry *) * map->bucket_count
-    );
+    map->root  = NULL;
+    map->count = 0;
 
     return map;
 }
 
-void hashmap_put(HashMap *map, const char *key, void *value)
+HashMap *hashmap_put(const HashMap *map, Symbol key, void *value)
 {
-    if (!map || !key) {
-        return;
+    if (!map) {
+        return NULL;
     }
 
-    uint64_t h = hash_str(key);
-    size_t idx = h % map->bucket_count;
+    HashLeaf *leaf = leaf_new(map->arena, key, value);
+    if (!leaf) {
+        return NULL;
+    }
+
+    int added = 0;
+    HashNode *root;
 
-    /* Overwrite if exists */
-    for (HashEntry *e = map->buckets[idx]; e; e = e->next) {
-        if (strcmp(e->key, key) == 0) {
-            e->value = value;
-            return;
+    if (!map->root) {
+        root = node_alloc(map->arena, 1, 1u << (key & HASH_MASK), 0);
+        if (!root) {
+            return NULL;
+        }
+        root->slots[0] = leaf;
+        added = 1;
+    } else {
+        root = node_put(map->arena, map->root, 0, leaf, &added);
+        if (!root) {
+            return NULL;
         }
     }
 
-    /* Insert new entry */
-    HashEntry *e = arena_alloc(map->arena, sizeof(HashEntry));
-    if (!e) {
-        return;
+    HashMap *next = arena_alloc_uninit(map->arena, sizeof(HashMap));
+    if (!next) {
+        return NULL;
     }
 
-    e->key = key;
-    e->value = value;
-    e->next = map->buckets[idx];
+    next->arena = map->arena;
+    next->root  = root;
+    next->count = map->count + (size_t)added;
 
-    map->buckets[idx] = e;
+    return next;
 }
 
-void *hashmap_get(HashMap *map, const char *key)
+void *hashmap_get(const HashMap *map, Symbol key)
 {
-    if (!map || !key) {
+    if (!map || !map->root) {
         return NULL;
     }
 
-    uint64_t h = hash_str(key);
-    size_t idx = h % map->bucket_count;
+    const HashNode *n = map->root;
+
+    for (unsigned shift = 0; shift < HASH_WIDTH; shift += HASH_BITS) {
+        uint32_t bit = 1u << ((key >> shift) & HASH_MASK);
+        if (!(n->bitmap & bit)) {
+            return NULL;
+        }
+
+        const void *slot = n->slots[popcount32(n->bitmap & (bit - 1))];
 
-    for (HashEntry *e = map->buckets[idx]; e; e = e->next) {
-        if (strcmp(e->key, key) == 0) {
-            return e->value;
+        if (!(n->childmap & bit)) {
+            const HashLeaf *l = slot;
+            return l->key == key ? l->value : NULL;
         }
+
+        n = slot;
     }
 
     return NULL;
 }
+
+size_t hashmap_count(const HashMap *map)
+{
+    return map ? map->count : 0;
+}
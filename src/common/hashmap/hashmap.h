@@ -3,29 +3,42 @@
 
 #include <stddef.h>
 
+#include "../intern/intern.h"
+
 struct Arena;
 
 /*
  * HashMap
  *
- * Minimal string-key hashmap.
- * Keys are NOT owned.
+ * Persistent map from interned symbols (hash array mapped trie).
+ * Keys are Symbols from an InternTable; lookups compare integers.
  * Values are opaque pointers.
  *
+ * A HashMap is immutable once returned.
+ * `hashmap_put` produces a NEW map that shares every untouched
+ * node with its source, copying only the O(log16 n) nodes on the
+ * path to the changed key. Older versions stay valid and unchanged.
+ *
  * Allocation is arena-backed and monotonic.
  */
 typedef struct HashMap HashMap;
 
 /* Create an empty hashmap */
-HashMap *hashmap_create(struct Arena *arena, size_t bucket_count);
+HashMap *hashmap_create(struct Arena *arena);
 
-/* Shallow clone (structural copy of buckets) */
-HashMap *hashmap_clone(HashMap *src, struct Arena *arena);
-
-/* Insert or overwrite */
-void hashmap_put(HashMap *map, const char *key, void *value);
+/*
+ * Insert or overwrite.
+ *
+ * Returns the new version; `map` itself is left untouched.
+ * New nodes are allocated from the arena `map` was created with.
+ * Returns NULL on allocation failure.
+ */
+HashMap *hashmap_put(const HashMap *map, Symbol key, void *value);
 
 /* Lookup (NULL if missing) */
-void *hashmap_get(HashMap *map, const char *key);
+void *hashmap_get(const HashMap *map, Symbol key);
+
+/* Number of keys in this version */
+size_t hashmap_count(const HashMap *map);
 
 #endif /* LIMINAL_HASHMAP_H */
@@ -0,0 +1,184 @@
+#include "./intern.h"
+#include "../hash/hash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Linear-probing table of symbols, kept at most half full.
+ * Per-symbol hash and length live in side arrays so probing and
+ * rehashing never touch the spellings.
+ */
+
+#define INTERN_INITIAL_SLOTS 256u
+#define INTERN_INITIAL_SYMS  128u
+
+/* FNV-1a, folded to 32 bits */
+static uint32_t hash_bytes(const char *s, size_t len)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+void intern_init(InternTable *t)
+{
+    memset(t, 0, sizeof(*t));
+    arena_init(&t->strings, 16 * 1024);
+    t->count = 1; /* symbol 0 is reserved */
+}
+
+void intern_free(InternTable *t)
+{
+    if (!t) {
+        return;
+    }
+
+    arena_destroy(&t->strings);
+    free(t->names);
+    free(t->hashes);
+    free(t->lens);
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+void intern_reset(InternTable *t)
+{
+    if (!t) {
+        return;
+    }
+
+    arena_reset(&t->strings);
+    if (t->slots) {
+        memset(t->slots, 0, t->slot_cap * sizeof(*t->slots));
+    }
+    t->count = 1;
+}
+
+static int grow_symbols(InternTable *t)
+{
+    size_t ncap = t->cap ? t->cap * 2 : INTERN_INITIAL_SYMS;
+
+    const char **names = realloc(t->names, ncap * sizeof(*names));
+    if (!names) {
+        return 0;
+    }
+    t->names = names;
+
+    uint32_t *hashes = realloc(t->hashes, ncap * sizeof(*hashes));
+    if (!hashes) {
+        return 0;
+    }
+    t->hashes = hashes;
+
+    uint32_t *lens = realloc(t->lens, ncap * sizeof(*lens));
+    if (!lens) {
+        return 0;
+    }
+    t->lens = lens;
+
+    t->cap = ncap;
+    return 1;
+}
+
+static int grow_slots(InternTable *t)
+{
+    size_t ncap = t->slot_cap ? t->slot_cap * 2 : INTERN_INITIAL_SLOTS;
+
+    Symbol *slots = calloc(ncap, sizeof(*slots));
+    if (!slots) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < t->slot_cap; i++) {
+        Symbol sym = t->slots[i];
+        if (sym == SYMBOL_NONE) {
+            continue;
+        }
+        size_t j = t->hashes[sym] & (ncap - 1);
+        while (slots[j] != SYMBOL_NONE) {
+            j = (j + 1) & (ncap - 1);
+        }
+        slots[j] = sym;
+    }
+
+    free(t->slots);
+    t->slots = slots;
+    t->slot_cap = ncap;
+    return 1;
+}
+
+Symbol intern(InternTable *t, const char *s, size_t len)
+{
+    if (!t || !s || len > UINT32_MAX) {
+        return SYMBOL_NONE;
+    }
+
+    /* Room for one more symbol at a load factor of at most 1/2 */
+    if (2 * t->count > t->slot_cap && !grow_slots(t)) {
+        return SYMBOL_NONE;
+    }
+
+    uint32_t h = hash_bytes(s, len);
+    size_t mask = t->slot_cap - 1;
+    size_t i = h & mask;
+
+    for (;;) {
+        Symbol sym = t->slots[i];
+        if (sym == SYMBOL_NONE) {
+            break;
+        }
+        if (t->hashes[sym] == h && t->lens[sym] == len &&
+            memcmp(t->names[sym], s, len) == 0) {
+            return sym;
+        }
+        i = (i + 1) & mask;
+    }
+
+    /* New spelling */
+    if (t->count >= UINT32_MAX) {
+        return SYMBOL_NONE;
+    }
+    if (t->count >= t->cap && !grow_symbols(t)) {
+        return SYMBOL_NONE;
+    }
+
+    char *copy = arena_alloc_uninit(&t->strings, len + 1);
+    if (!copy) {
+        return SYMBOL_NONE;
+    }
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+
+    Symbol sym = (Symbol)t->count++;
+    t->names[sym]  = copy;
+    t->hashes[sym] = h;
+    t->lens[sym]   = (uint32_t)len;
+    t->slots[i]    = sym;
+
+    return sym;
+}
+
+const char *intern_name(const InternTable *t, Symbol sym)
+{
+    if (!t || sym == SYMBOL_NONE || sym >= t->count) {
+        return NULL;
+    }
+    return t->names[sym];
+}
+
+uint64_t intern_hash64(const InternTable *t, Symbol sym)
+{
+    if (!t || sym == SYMBOL_NONE || sym >= t->count) {
+        return 0;
+    }
+    return hash64(t->names[sym], t->lens[sym], 0);
+}
+
+size_t intern_count(const InternTable *t)
+{
+    return t && t->count ? t->count - 1 : 0;
+}
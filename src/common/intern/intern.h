@@ -0,0 +1,67 @@
+#ifndef LIMINAL_INTERN_H
+#define LIMINAL_INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../arena/arena.h"
+
+/*
+ * InternTable
+ *
+ * Maps identifier spellings to dense 32-bit symbols.
+ *
+ * Equal spellings always yield the same symbol, so identifier
+ * comparison anywhere downstream is an integer compare.
+ * Symbols start at 1; SYMBOL_NONE (0) never names a string.
+ *
+ * Spellings are copied once (NUL-terminated) into the table's
+ * arena and stay valid until intern_free.
+ */
+typedef uint32_t Symbol;
+
+#define SYMBOL_NONE ((Symbol)0)
+
+typedef struct InternTable {
+    Arena strings;          /* spelling storage */
+
+    const char **names;     /* symbol -> spelling (names[0] unused) */
+    uint32_t    *hashes;    /* symbol -> hash of spelling */
+    uint32_t    *lens;      /* symbol -> length of spelling */
+    size_t       count;     /* symbols handed out, plus one */
+    size_t       cap;
+
+    Symbol *slots;          /* open addressing, 0 = empty */
+    size_t  slot_cap;       /* power of two */
+} InternTable;
+
+void intern_init(InternTable *t);
+void intern_free(InternTable *t);
+
+/*
+ * Forget every symbol but keep the storage for reuse.
+ * Spellings handed out before the reset become invalid.
+ */
+void intern_reset(InternTable *t);
+
+/*
+ * Symbol for `len` bytes at `s` (need not be NUL-terminated).
+ * Returns SYMBOL_NONE on allocation failure.
+ */
+Symbol intern(InternTable *t, const char *s, size_t len);
+
+/* Spelling of `sym`, or NULL if it is not a symbol of `t` */
+const char *intern_name(const InternTable *t, Symbol sym);
+
+/*
+ * hash64 (seed 0) of the spelling of `sym`, or 0 if it is not a
+ * symbol of `t`. Unlike the symbol itself, it does not depend on
+ * the order names were interned in, so it is the same for one
+ * spelling in any program.
+ */
+uint64_t intern_hash64(const InternTable *t, Symbol sym);
+
+/* Number of distinct symbols */
+size_t intern_count(const InternTable *t);
+
+#endif /* LIMINAL_INTERN_H */
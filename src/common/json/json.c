@@ -0,0 +1,386 @@
+#include "./json.h"
+
+#include <string.h>
+
+void json_reader_init(JsonReader *r, const char *text, size_t len)
+{
+    r->start = text;
+    r->p     = text;
+    r->end   = text + len;
+    r->error = 0;
+}
+
+static int fail(JsonReader *r)
+{
+    r->error = 1;
+    return 0;
+}
+
+static void skip_ws(JsonReader *r)
+{
+    while (r->p < r->end &&
+           (*r->p == ' ' || *r->p == '\t' ||
+            *r->p == '\n' || *r->p == '\r')) {
+        r->p++;
+    }
+}
+
+/* Next significant byte, or 0 at the end */
+static char peek(JsonReader *r)
+{
+    skip_ws(r);
+    return r->p < r->end ? *r->p : 0;
+}
+
+static int expect(JsonReader *r, char c)
+{
+    if (r->error || peek(r) != c) {
+        return fail(r);
+    }
+    r->p++;
+    return 1;
+}
+
+/* Last significant byte before the cursor */
+static char prev(const JsonReader *r)
+{
+    const char *q = r->p;
+    while (q > r->start) {
+        char c = *--q;
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return c;
+        }
+    }
+    return 0;
+}
+
+int json_object_begin(JsonReader *r)
+{
+    return expect(r, '{');
+}
+
+int json_array_begin(JsonReader *r)
+{
+    return expect(r, '[');
+}
+
+/*
+ * Shared member/element separator logic: the opening bracket
+ * directly before the cursor means first item, otherwise a ','
+ * is required.
+ */
+static int next_item(JsonReader *r, char open, char close)
+{
+    if (r->error) {
+        return 0;
+    }
+
+    char c = peek(r);
+    if (c == close) {
+        r->p++;
+        return 0;
+    }
+
+    if (prev(r) != open) {
+        if (c != ',') {
+            return fail(r);
+        }
+        r->p++;
+        if (peek(r) == close) {
+            return fail(r); /* trailing comma */
+        }
+    }
+
+    return 1;
+}
+
+int json_object_next(JsonReader *r, JsonStr *key)
+{
+    if (!next_item(r, '{', '}')) {
+        return 0;
+    }
+    if (!json_read_string(r, key)) {
+        return 0;
+    }
+    return expect(r, ':');
+}
+
+int json_array_next(JsonReader *r)
+{
+    return next_item(r, '[', ']');
+}
+
+int json_read_string(JsonReader *r, JsonStr *out)
+{
+    if (!expect(r, '"')) {
+        return 0;
+    }
+
+    const char *s = r->p;
+    int escaped = 0;
+
+    while (r->p < r->end && *r->p != '"') {
+        if ((unsigned char)*r->p < 0x20) {
+            return fail(r);
+        }
+        if (*r->p == '\\') {
+            escaped = 1;
+            if (++r->p >= r->end) {
+                return fail(r);
+            }
+        }
+        r->p++;
+    }
+
+    if (r->p >= r->end) {
+        return fail(r);
+    }
+
+    out->ptr = s;
+    out->len = (size_t)(r->p - s);
+    out->escaped = escaped;
+
+    r->p++; /* closing quote */
+    return 1;
+}
+
+char json_peek(JsonReader *r)
+{
+    return r->error ? 0 : peek(r);
+}
+
+int json_read_u64(JsonReader *r, uint64_t *out)
+{
+    char c = r->error ? 0 : peek(r);
+    if (c < '0' || c > '9') {
+        return fail(r);
+    }
+
+    uint64_t v = 0;
+    while (r->p < r->end && *r->p >= '0' && *r->p <= '9') {
+        unsigned d = (unsigned)(*r->p - '0');
+        if (v > (UINT64_MAX - d) / 10) {
+            return fail(r);
+        }
+        v = v * 10 + d;
+        r->p++;
+    }
+
+    /* Fractions and exponents are not integers */
+    if (r->p < r->end &&
+        (*r->p == '.' || *r->p == 'e' || *r->p == 'E')) {
+        return fail(r);
+    }
+
+    *out = v;
+    return 1;
+}
+
+static int literal(JsonReader *r, const char *lit)
+{
+    size_t n = strlen(lit);
+    if ((size_t)(r->end - r->p) < n || memcmp(r->p, lit, n) != 0) {
+        return fail(r);
+    }
+    r->p += n;
+    return 1;
+}
+
+int json_read_hex64(JsonReader *r, uint64_t *out)
+{
+    JsonStr s;
+    if (!json_read_string(r, &s) || s.len == 0 || s.len > 16) {
+        return 0;
+    }
+
+    uint64_t v = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
+        unsigned d;
+        if (c >= '0' && c <= '9')      d = (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') d = (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') d = (unsigned)(c - 'A' + 10);
+        else return 0;
+        v = v << 4 | d;
+    }
+    *out = v;
+    return 1;
+}
+
+int json_read_bool(JsonReader *r, int *out)
+{
+    char c = r->error ? 0 : peek(r);
+    if (c == 't' && literal(r, "true")) {
+        *out = 1;
+        return 1;
+    }
+    if (c == 'f' && literal(r, "false")) {
+        *out = 0;
+        return 1;
+    }
+    return fail(r);
+}
+
+static int skip_number(JsonReader *r)
+{
+    const char *s = r->p;
+    if (r->p < r->end && *r->p == '-') {
+        r->p++;
+    }
+    while (r->p < r->end &&
+           ((*r->p >= '0' && *r->p <= '9') || *r->p == '.' ||
+            *r->p == 'e' || *r->p == 'E' || *r->p == '+' ||
+            *r->p == '-')) {
+        r->p++;
+    }
+    return r->p > s ? 1 : fail(r);
+}
+
+int json_skip(JsonReader *r)
+{
+    JsonStr s;
+
+    switch (r->error ? 0 : peek(r)) {
+    case '"':
+        return json_read_string(r, &s);
+
+    case '{':
+        json_object_begin(r);
+        while (json_object_next(r, &s)) {
+            if (!json_skip(r)) {
+                return 0;
+            }
+        }
+        return !r->error;
+
+    case '[':
+        json_array_begin(r);
+        while (json_array_next(r)) {
+            if (!json_skip(r)) {
+                return 0;
+            }
+        }
+        return !r->error;
+
+    case 't': return literal(r, "true");
+    case 'f': return literal(r, "false");
+    case 'n': return literal(r, "null");
+
+    case 0:
+        return fail(r);
+
+    default:
+        return skip_number(r);
+    }
+}
+
+int json_at_end(JsonReader *r)
+{
+    return !r->error && peek(r) == 0 && r->p == r->end;
+}
+
+static int hex4(const char *s, unsigned *out)
+{
+    unsigned v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (unsigned)(c - 'A' + 10);
+        else return 0;
+    }
+    *out = v;
+    return 1;
+}
+
+static size_t put_utf8(char *dst, unsigned cp)
+{
+    if (cp < 0x80) {
+        dst[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        dst[0] = (char)(0xC0 | (cp >> 6));
+        dst[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        dst[0] = (char)(0xE0 | (cp >> 12));
+        dst[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        dst[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    dst[0] = (char)(0xF0 | (cp >> 18));
+    dst[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    dst[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    dst[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+size_t json_str_decode(JsonStr s, char *dst)
+{
+    if (!s.escaped) {
+        memcpy(dst, s.ptr, s.len);
+        dst[s.len] = '\0';
+        return s.len;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
+        if (c != '\\') {
+            dst[n++] = c;
+            continue;
+        }
+
+        /* json_read_string guarantees a byte after each '\' */
+        switch (s.ptr[++i]) {
+        case '"':  dst[n++] = '"';  break;
+        case '\\': dst[n++] = '\\'; break;
+        case '/':  dst[n++] = '/';  break;
+        case 'b':  dst[n++] = '\b'; break;
+        case 'f':  dst[n++] = '\f'; break;
+        case 'n':  dst[n++] = '\n'; break;
+        case 'r':  dst[n++] = '\r'; break;
+        case 't':  dst[n++] = '\t'; break;
+
+        case 'u': {
+            /* \uXXXX (6 bytes) never decodes to more than 3 */
+            unsigned cp;
+            if (i + 4 >= s.len || !hex4(s.ptr + i + 1, &cp)) {
+                return (size_t)-1;
+            }
+            i += 4;
+
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                unsigned lo;
+                if (i + 6 >= s.len || s.ptr[i + 1] != '\\' ||
+                    s.ptr[i + 2] != 'u' || !hex4(s.ptr + i + 3, &lo) ||
+                    lo < 0xDC00 || lo > 0xDFFF) {
+                    return (size_t)-1;
+                }
+                i += 6;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return (size_t)-1;
+            }
+
+            n += put_utf8(dst + n, cp);
+            break;
+        }
+
+        default:
+            return (size_t)-1;
+        }
+    }
+
+    dst[n] = '\0';
+    return n;
+}
+
+int json_str_eq(JsonStr s, const char *lit)
+{
+    size_t n = strlen(lit);
+    return !s.escaped && s.len == n && memcmp(s.ptr, lit, n) == 0;
+}
@@ -0,0 +1,84 @@
+#ifndef LIMINAL_JSON_H
+#define LIMINAL_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * JsonReader
+ *
+ * Pull scanner over one JSON text in memory. Nothing is built:
+ * callers walk objects and arrays and read the values they want,
+ * skipping the rest.
+ *
+ *   json_object_begin(r);
+ *   while (json_object_next(r, &key)) {
+ *       if (json_str_eq(key, "path")) json_read_string(r, &s);
+ *       else                          json_skip(r);
+ *   }
+ *
+ * Strings are returned as spans into the input (JsonStr). Use
+ * json_str_decode to resolve escapes.
+ *
+ * Every call returns 0 on malformed input and sets `error`;
+ * once set, every later call returns 0 as well.
+ */
+typedef struct JsonReader {
+    const char *start;
+    const char *p;
+    const char *end;
+    int         error;
+} JsonReader;
+
+/* Raw string contents between the quotes */
+typedef struct JsonStr {
+    const char *ptr;
+    size_t      len;
+    int         escaped;    /* contains backslashes */
+} JsonStr;
+
+void json_reader_init(JsonReader *r, const char *text, size_t len);
+
+/* Consume '{' / '[' */
+int json_object_begin(JsonReader *r);
+int json_array_begin(JsonReader *r);
+
+/*
+ * 1: a member follows; its key is in `key` and the ':' is consumed.
+ * 0: the closing '}' was consumed (or error).
+ */
+int json_object_next(JsonReader *r, JsonStr *key);
+
+/*
+ * 1: an element follows.
+ * 0: the closing ']' was consumed (or error).
+ */
+int json_array_next(JsonReader *r);
+
+/* Next significant byte, not consumed ('"', '{', a digit...); 0 at end */
+char json_peek(JsonReader *r);
+
+int json_read_string(JsonReader *r, JsonStr *out);
+int json_read_u64(JsonReader *r, uint64_t *out);
+
+/* A string of 1 to 16 hex digits (as json_write_hex64 writes) */
+int json_read_hex64(JsonReader *r, uint64_t *out);
+int json_read_bool(JsonReader *r, int *out);
+
+/* Skip one value of any type */
+int json_skip(JsonReader *r);
+
+/* Trailing whitespace only (one value per NDJSON line) */
+int json_at_end(JsonReader *r);
+
+/*
+ * Decode `s` into `dst` (at least s.len + 1 bytes), NUL-terminated.
+ * \uXXXX becomes UTF-8; surrogate pairs are combined.
+ * Returns the decoded length, or (size_t)-1 on a bad escape.
+ */
+size_t json_str_decode(JsonStr s, char *dst);
+
+/* `s` equals the plain ASCII literal `lit` */
+int json_str_eq(JsonStr s, const char *lit);
+
+#endif /* LIMINAL_JSON_H */
@@ -0,0 +1,92 @@
+#include "./ndjson.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NDJSON_CHUNK 65536
+
+void ndjson_reader_init(NdjsonReader *r, FILE *in)
+{
+    memset(r, 0, sizeof(*r));
+    r->in = in;
+}
+
+void ndjson_reader_free(NdjsonReader *r)
+{
+    free(r->buf);
+    memset(r, 0, sizeof(*r));
+}
+
+/* Move the unread bytes to the front and read more. 0 if none came. */
+static int fill(NdjsonReader *r)
+{
+    if (r->eof || r->error) {
+        return 0;
+    }
+
+    if (r->start > 0) {
+        memmove(r->buf, r->buf + r->start, r->end - r->start);
+        r->end -= r->start;
+        r->start = 0;
+    }
+
+    /* A line longer than the buffer: grow */
+    if (r->end == r->cap) {
+        size_t ncap = r->cap ? r->cap * 2 : NDJSON_CHUNK;
+        char *nb = realloc(r->buf, ncap);
+        if (!nb) {
+            r->error = 1;
+            return 0;
+        }
+        r->buf = nb;
+        r->cap = ncap;
+    }
+
+    size_t n = fread(r->buf + r->end, 1, r->cap - r->end, r->in);
+    r->end += n;
+
+    if (n == 0) {
+        r->eof = 1;
+        r->error = ferror(r->in) != 0;
+    }
+    return n > 0;
+}
+
+int ndjson_next_line(NdjsonReader *r, const char **line, size_t *len)
+{
+    for (;;) {
+        char *p = r->buf + r->start;
+        size_t avail = r->end - r->start;
+        char *nl = avail ? memchr(p, '\n', avail) : NULL;
+
+        size_t n;
+        if (nl) {
+            n = (size_t)(nl - p);
+            r->start += n + 1;
+        } else if (!fill(r)) {
+            /* fill may have moved the unread bytes */
+            p = r->buf + r->start;
+            avail = r->end - r->start;
+            if (r->error || avail == 0) {
+                return 0;
+            }
+            /* Last line without a newline */
+            n = avail;
+            r->start = r->end;
+        } else {
+            continue;
+        }
+
+        r->line_no++;
+        if (n > 0 && p[n - 1] == '\r') {
+            n--;
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        *line = p;
+        *len = n;
+        return 1;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef LIMINAL_JSON_NDJSON_H
+#define LIMINAL_JSON_NDJSON_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * NdjsonReader
+ *
+ * Line splitter for NDJSON streams. Reads in large chunks and hands
+ * out each line as a span into its buffer, so memory stays at the
+ * longest line no matter how long the stream is.
+ *
+ *   NdjsonReader r;
+ *   ndjson_reader_init(&r, in);
+ *   while (ndjson_next_line(&r, &line, &len)) {
+ *       JsonReader j;
+ *       json_reader_init(&j, line, len);
+ *       ...
+ *   }
+ *   ndjson_reader_free(&r);
+ *
+ * Line ends ("\n" or "\r\n") are stripped; blank lines are skipped.
+ * A line is valid until the next call.
+ */
+typedef struct NdjsonReader {
+    FILE  *in;
+    char  *buf;
+    size_t cap;
+    size_t start;       /* unread bytes are buf[start..end) */
+    size_t end;
+    size_t line_no;     /* 1-based number of the last line returned */
+    int    eof;
+    int    error;       /* read or allocation failure */
+} NdjsonReader;
+
+void ndjson_reader_init(NdjsonReader *r, FILE *in);
+void ndjson_reader_free(NdjsonReader *r);
+
+/* 1 with the next non-blank line; 0 at end of input or on error */
+int ndjson_next_line(NdjsonReader *r, const char **line, size_t *len);
+
+#endif /* LIMINAL_JSON_NDJSON_H */
@@ -0,0 +1,94 @@
+#include "./writer.h"
+
+void json_writer_init(JsonWriter *w, FILE *out)
+{
+    w->out   = out;
+    w->len   = 0;
+    w->error = 0;
+}
+
+int json_writer_flush(JsonWriter *w)
+{
+    if (w->len > 0 &&
+        fwrite(w->buf, 1, w->len, w->out) != w->len) {
+        w->error = 1;
+    }
+    w->len = 0;
+    return !w->error;
+}
+
+void json_write_spill(JsonWriter *w, const char *p, size_t n)
+{
+    json_writer_flush(w);
+
+    /* Too large to be worth buffering */
+    if (n >= JSON_WRITER_BUF) {
+        if (fwrite(p, 1, n, w->out) != n) {
+            w->error = 1;
+        }
+        return;
+    }
+
+    memcpy(w->buf, p, n);
+    w->len = n;
+}
+
+void json_write_u64(JsonWriter *w, uint64_t v)
+{
+    char tmp[20];
+    size_t i = sizeof(tmp);
+
+    do {
+        tmp[--i] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    json_write_raw(w, tmp + i, sizeof(tmp) - i);
+}
+
+void json_write_hex64(JsonWriter *w, uint64_t v)
+{
+    static const char digits[] = "0123456789abcdef";
+    char tmp[16];
+
+    for (int i = 15; i >= 0; i--) {
+        tmp[i] = digits[v & 0xf];
+        v >>= 4;
+    }
+    json_write_raw(w, tmp, sizeof(tmp));
+}
+
+void json_write_string(JsonWriter *w, const char *s)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    json_write_lit(w, "\"");
+
+    const char *run = s;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        json_write_raw(w, run, (size_t)(s - run));
+        run = s + 1;
+
+        switch (c) {
+        case '"':  json_write_lit(w, "\\\""); break;
+        case '\\': json_write_lit(w, "\\\\"); break;
+        case '\n': json_write_lit(w, "\\n");  break;
+        case '\r': json_write_lit(w, "\\r");  break;
+        case '\t': json_write_lit(w, "\\t");  break;
+        default: {
+            char esc[6] = { '\\', 'u', '0', '0',
+                            digits[c >> 4], digits[c & 0xf] };
+            json_write_raw(w, esc, sizeof(esc));
+            break;
+        }
+        }
+    }
+    json_write_raw(w, run, (size_t)(s - run));
+
+    json_write_lit(w, "\"");
+}
@@ -0,0 +1,73 @@
+#ifndef LIMINAL_JSON_WRITER_H
+#define LIMINAL_JSON_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * JsonWriter
+ *
+ * Buffered output for NDJSON artifacts. Records are assembled in
+ * an in-struct buffer and handed to stdio in JSON_WRITER_BUF
+ * chunks, so writing allocates nothing and skips stdio's
+ * per-call locking and format parsing.
+ *
+ *   JsonWriter w;
+ *   json_writer_init(&w, out);
+ *   json_write_lit(&w, "{\"time\":");
+ *   json_write_u64(&w, t);
+ *   json_write_lit(&w, "}\n");
+ *   json_writer_flush(&w);
+ *
+ * Integers are written in the same form as printf's %llu / %u /
+ * %016llx. Nothing reaches `out` before a flush or a full buffer,
+ * so do not interleave direct writes to `out` with an open writer.
+ */
+
+#define JSON_WRITER_BUF 65536
+
+typedef struct JsonWriter {
+    FILE  *out;
+    size_t len;
+    int    error;       /* a write to `out` failed */
+    char   buf[JSON_WRITER_BUF];
+} JsonWriter;
+
+void json_writer_init(JsonWriter *w, FILE *out);
+
+/* Hand everything buffered to `out`. Returns 0 if any write failed. */
+int json_writer_flush(JsonWriter *w);
+
+/* Slow path of json_write_raw: the bytes do not fit */
+void json_write_spill(JsonWriter *w, const char *p, size_t n);
+
+static inline void json_write_raw(JsonWriter *w, const char *p, size_t n)
+{
+    if (n <= JSON_WRITER_BUF - w->len) {
+        memcpy(w->buf + w->len, p, n);
+        w->len += n;
+    } else {
+        json_write_spill(w, p, n);
+    }
+}
+
+/* String literal, length known at compile time */
+#define json_write_lit(w, lit) json_write_raw((w), (lit), sizeof(lit) - 1)
+
+static inline void json_write_cstr(JsonWriter *w, const char *s)
+{
+    json_write_raw(w, s, strlen(s));
+}
+
+/* Decimal, as %llu / %u */
+void json_write_u64(JsonWriter *w, uint64_t v);
+
+/* 16 lowercase hex digits, as %016llx */
+void json_write_hex64(JsonWriter *w, uint64_t v);
+
+/* Quoted JSON string; '"', '\' and control characters escaped */
+void json_write_string(JsonWriter *w, const char *s);
+
+#endif /* LIMINAL_JSON_WRITER_H */
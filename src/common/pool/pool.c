@@ -0,0 +1,186 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "./pool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+ * One range of pending items per worker, [lo, hi).
+ * The owner takes from lo, thieves split off the top half.
+ */
+typedef struct PoolRange {
+    pthread_mutex_t lock;
+    size_t lo;
+    size_t hi;
+} PoolRange;
+
+typedef struct Pool {
+    PoolRange *ranges;
+    unsigned   workers;
+
+    pool_fn    fn;
+    void      *ctx;
+} Pool;
+
+typedef struct PoolWorker {
+    Pool     *pool;
+    unsigned  index;
+} PoolWorker;
+
+static int take_own(PoolRange *r, size_t *item)
+{
+    int got = 0;
+
+    pthread_mutex_lock(&r->lock);
+    if (r->lo < r->hi) {
+        *item = r->lo++;
+        got = 1;
+    }
+    pthread_mutex_unlock(&r->lock);
+
+    return got;
+}
+
+/*
+ * Move the top half of some other worker's range into `self`.
+ * Returns 0 once every range is empty: items are never added,
+ * so an empty sweep means there is nothing left to steal.
+ */
+static int steal(Pool *pool, unsigned self)
+{
+    for (unsigned k = 1; k < pool->workers; k++) {
+        PoolRange *victim = &pool->ranges[(self + k) % pool->workers];
+        size_t lo = 0, hi = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        size_t left = victim->hi - victim->lo;
+        if (left > 0) {
+            /* Leave the victim the half it will reach first */
+            hi = victim->hi;
+            lo = hi - (left + 1) / 2;
+            victim->hi = lo;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (lo < hi) {
+            PoolRange *own = &pool->ranges[self];
+            pthread_mutex_lock(&own->lock);
+            own->lo = lo;
+            own->hi = hi;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void *pool_worker(void *arg)
+{
+    PoolWorker *w = arg;
+    Pool *pool = w->pool;
+    size_t item;
+
+    for (;;) {
+        while (take_own(&pool->ranges[w->index], &item)) {
+            pool->fn(pool->ctx, w->index, item);
+        }
+        if (!steal(pool, w->index)) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+unsigned pool_run(size_t count, unsigned workers, pool_fn fn, void *ctx)
+{
+    if (!fn || count == 0) {
+        return 0;
+    }
+
+    if (workers > count) {
+        workers = (unsigned)count;
+    }
+
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            fn(ctx, 0, i);
+        }
+        return 1;
+    }
+
+    PoolRange  *ranges  = calloc(workers, sizeof(*ranges));
+    PoolWorker *ws      = calloc(workers, sizeof(*ws));
+    pthread_t  *threads = calloc(workers, sizeof(*threads));
+    char       *started = calloc(workers, 1);
+
+    if (!ranges || !ws || !threads || !started) {
+        free(ranges);
+        free(ws);
+        free(threads);
+        free(started);
+
+        for (size_t i = 0; i < count; i++) {
+            fn(ctx, 0, i);
+        }
+        return 1;
+    }
+
+    Pool pool = {
+        .ranges  = ranges,
+        .workers = workers,
+        .fn      = fn,
+        .ctx     = ctx
+    };
+
+    /* Even split; the first `count % workers` ranges get one extra */
+    size_t per = count / workers;
+    size_t extra = count % workers;
+    size_t at = 0;
+
+    for (unsigned i = 0; i < workers; i++) {
+        pthread_mutex_init(&ranges[i].lock, NULL);
+        ranges[i].lo = at;
+        at += per + (i < extra ? 1 : 0);
+        ranges[i].hi = at;
+
+        ws[i].pool = &pool;
+        ws[i].index = i;
+    }
+
+    unsigned ran = 1;
+    for (unsigned i = 1; i < workers; i++) {
+        if (pthread_create(&threads[i], NULL, pool_worker, &ws[i]) == 0) {
+            started[i] = 1;
+            ran++;
+        }
+    }
+
+    /* The calling thread is worker 0 */
+    pool_worker(&ws[0]);
+
+    for (unsigned i = 1; i < workers; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    for (unsigned i = 0; i < workers; i++) {
+        pthread_mutex_destroy(&ranges[i].lock);
+    }
+
+    free(ranges);
+    free(ws);
+    free(threads);
+    free(started);
+    return ran;
+}
+
+unsigned pool_cpu_count(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned)n : 1;
+}
@@ -0,0 +1,32 @@
+#ifndef LIMINAL_POOL_H
+#define LIMINAL_POOL_H
+
+#include <stddef.h>
+
+/*
+ * Pool
+ *
+ * Runs `fn` once for every item in [0, count) on `workers`
+ * threads and returns when all of them are done.
+ *
+ * Items start evenly split into one contiguous range per worker.
+ * A worker takes items from the front of its own range; when it
+ * runs dry it steals the back half of another worker's range, so
+ * a few slow items do not leave the other cores idle.
+ *
+ * `fn` receives the worker index (0 .. workers-1), which callers
+ * use to give each worker its own state. Nothing else is shared.
+ *
+ * The calling thread is worker 0. With one worker (or one item)
+ * everything runs on it in item order. If a thread cannot be
+ * started, the others steal its range, so every item is still run
+ * exactly once. Returns the number of workers that ran.
+ */
+typedef void (*pool_fn)(void *ctx, unsigned worker, size_t item);
+
+unsigned pool_run(size_t count, unsigned workers, pool_fn fn, void *ctx);
+
+/* Online CPUs (at least 1) */
+unsigned pool_cpu_count(void);
+
+#endif /* LIMINAL_POOL_H */
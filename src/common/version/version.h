@@ -0,0 +1,12 @@
+#ifndef LIMINAL_VERSION_H
+#define LIMINAL_VERSION_H
+
+/*
+ * Liminal release version.
+ *
+ * Written into every run's meta.json and part of every result
+ * cache key, so bumping it invalidates cached results.
+ */
+#define LIMINAL_VERSION "0.5.3"
+
+#endif /* LIMINAL_VERSION_H */
@@ -1,4 +1,5 @@
 #include "cause_key.h"
+#include "../../common/common.h"
 
 inline int cause_key_equal(const CauseKey *a, const CauseKey *b)
 {
@@ -6,3 +7,9 @@ inline int cause_key_equal(const CauseKey *a, const CauseKey *b)
            a->ast_id == b->ast_id &&
            a->scope_id == b->scope_id;
 }
+
+uint64_t cause_key_hash(const CauseKey *k)
+{
+    return hash64_mix(hash64_mix((uint64_t)k->step, k->ast_id),
+                      k->scope_id);
+}
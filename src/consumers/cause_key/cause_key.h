@@ -14,6 +14,9 @@ typedef struct CauseKey {
 /* MUST be exported — used by convergence_map */
 int cause_key_equal(const CauseKey *a, const CauseKey *b);
 
+/* Hash of the packed (step, ast_id, scope_id); equal keys, equal hashes */
+uint64_t cause_key_hash(const CauseKey *k);
+
 
 int extract_cause_key(
     const RootChain *chain,
@@ -21,11 +21,11 @@ int extract_cause_key(
         return 1;
     }
 
-    const RootChainNode *n = &chain->nodes[0];
+    RootChainNode n = root_chain_node(chain, 0);
 
-    out->step     = n->step;
-    out->ast_id   = n->ast_id;
-    out->scope_id = n->scope_id;
+    out->step     = n.step;
+    out->ast_id   = n.ast_id;
+    out->scope_id = n.scope_id;
 
     return 0;
 }
@@ -9,21 +9,30 @@
  * Build convergence groups across diagnostics by causal signature.
  */
 int build_convergence_map(
+    Arena *arena,
     const DiagnosticArtifact *diags,
     const RootChain *chains,
     ConvergenceMap *out
 )
 {
-    if (!diags || !chains || !out)
+    if (!arena || !diags || !chains || !out)
         return -1;
 
-    for (size_t i = 0; i < diags->count; i++) {
-        CauseKey key;
+    size_t n = diags->count;
+    CauseKey *keys = arena_alloc_uninit(arena, (n ? n : 1) * sizeof(*keys));
+    const Diagnostic **keyed =
+        arena_alloc_uninit(arena, (n ? n : 1) * sizeof(*keyed));
 
-        if (extract_cause_key(&chains[i], &key) == 0) {
-            convergence_map_add(out, &key, &diags->items[i]);
+    if (!keys || !keyed)
+        return -1;
+
+    /* Diagnostics without a cause key take no part */
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (extract_cause_key(&chains[i], &keys[m]) == 0) {
+            keyed[m++] = &diags->items[i];
         }
     }
 
-    return 0;
+    return convergence_map_build(arena, keys, keyed, m, out);
 }
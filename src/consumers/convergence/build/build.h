@@ -9,10 +9,11 @@
  * Build convergence groups from diagnostics + root chains.
  *
  * PURE:
- *  - no allocation outside ConvergenceMap
- *  - deterministic
+ *  - arena-only allocation (the map lives in `arena`)
+ *  - deterministic, O(diagnostics)
  */
 int build_convergence_map(
+    Arena *arena,
     const struct DiagnosticArtifact *diags,
     const struct RootChain *chains,
     ConvergenceMap *out
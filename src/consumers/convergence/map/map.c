@@ -1,47 +1,77 @@
-#include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "./map.h"
 #include "../../cause_key/cause_key.h"
 
-/* Forward declaration — real definition lives in cause_key.c */
-int cause_key_equal(const CauseKey *a, const CauseKey *b);
-
-static ConvergenceEntry *
-find_entry(ConvergenceMap *m, const CauseKey *key)
+int convergence_map_build(
+    Arena *arena,
+    const CauseKey *keys,
+    const Diagnostic *const *diags,
+    size_t n,
+    ConvergenceMap *out
+)
 {
-    for (size_t i = 0; i < m->count; i++) {
-        if (cause_key_equal(&m->entries[i].key, key))
-            return &m->entries[i];
+    memset(out, 0, sizeof(*out));
+    if (n == 0) {
+        return 0;
+    }
+    if (n > UINT32_MAX - 1) {
+        return -1;
     }
-    return NULL;
-}
 
-void convergence_map_add(
-    ConvergenceMap *m,
-    const CauseKey *key,
-    const Diagnostic *diag
-)
-{
-    ConvergenceEntry *e = find_entry(m, key);
+    /* At most half full; slots hold entry index + 1 */
+    unsigned bits = 4;
+    while (((size_t)1 << bits) < n * 2) {
+        bits++;
+    }
+    size_t mask = ((size_t)1 << bits) - 1;
 
-    if (!e) {
-        if (m->count == m->capacity) {
-            size_t nc = m->capacity ? m->capacity * 2 : 4;
-            m->entries = realloc(m->entries, nc * sizeof(*m->entries));
-            m->capacity = nc;
+    uint32_t *slots = arena_alloc(arena, (mask + 1) * sizeof(*slots));
+    uint32_t *entry_of = arena_alloc_uninit(arena, n * sizeof(*entry_of));
+    ConvergenceEntry *entries =
+        arena_alloc_uninit(arena, n * sizeof(*entries));
+    const Diagnostic **members =
+        arena_alloc_uninit(arena, n * sizeof(*members));
+
+    if (!slots || !entry_of || !entries || !members) {
+        return -1;
+    }
+
+    /* ---- ASSIGN ENTRIES (first appearance order) ---- */
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t s = (size_t)(cause_key_hash(&keys[i]) >> (64 - bits));
+
+        while (slots[s] &&
+               !cause_key_equal(&entries[slots[s] - 1].key, &keys[i])) {
+            s = (s + 1) & mask;
+        }
+        if (!slots[s]) {
+            entries[count] = (ConvergenceEntry){ .key = keys[i] };
+            slots[s] = (uint32_t)++count;
         }
 
-        e = &m->entries[m->count++];
-        memset(e, 0, sizeof(*e));
-        e->key = *key;
+        entry_of[i] = slots[s] - 1;
+        entries[entry_of[i]].count++;
     }
 
-    if (e->count == e->capacity) {
-        size_t nc = e->capacity ? e->capacity * 2 : 4;
-        e->diagnostics = realloc(e->diagnostics, nc * sizeof(*e->diagnostics));
-        e->capacity = nc;
+    /* ---- LAY OUT MEMBERS ---- */
+    size_t at = 0;
+    for (size_t e = 0; e < count; e++) {
+        entries[e].first = at;
+        at += entries[e].count;
+        entries[e].count = 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        ConvergenceEntry *e = &entries[entry_of[i]];
+        members[e->first + e->count++] = diags[i];
     }
 
-    e->diagnostics[e->count++] = diag;
+    out->entries = entries;
+    out->count = count;
+    out->members = members;
+    out->member_count = n;
+    return 0;
 }
@@ -2,34 +2,61 @@
 #define LIMINAL_CONVERGENCE_MAP_H
 
 #include <stddef.h>
+#include "../../../common/common.h"
 #include "../../cause_key/cause_key.h"
 #include "../../../analyzer/analyzer.h"
 /*
  * A convergence entry groups diagnostics that share
  * an identical semantic cause key.
+ *
+ * Its diagnostics are members[first .. first + count) of the
+ * owning map.
  */
 typedef struct ConvergenceEntry {
     CauseKey key;
 
-    const Diagnostic **diagnostics;
+    size_t first;
     size_t count;
-    size_t capacity;
 } ConvergenceEntry;
 
 /*
  * A convergence map groups all convergence entries
  * discovered in a run.
+ *
+ * Entries are in order of first appearance, members of an entry
+ * in input order. Everything lives in the arena it was built in.
  */
 typedef struct ConvergenceMap {
     ConvergenceEntry *entries;
     size_t count;
-    size_t capacity;
+
+    const Diagnostic **members;
+    size_t member_count;
 } ConvergenceMap;
 
-void convergence_map_add(
-    ConvergenceMap *map,
-    const CauseKey *key,
-    const Diagnostic *diag
+/*
+ * Group diags[i] by keys[i] in O(n): an open-addressing table
+ * on the packed key assigns entries, then members are laid out
+ * by entry in one buffer.
+ *
+ * Returns 0 on success, -1 on allocation failure.
+ */
+int convergence_map_build(
+    Arena *arena,
+    const CauseKey *keys,
+    const Diagnostic *const *diags,
+    size_t n,
+    ConvergenceMap *out
 );
 
+/* Diagnostic j of entry e */
+static inline const Diagnostic *convergence_entry_diagnostic(
+    const ConvergenceMap *m,
+    const ConvergenceEntry *e,
+    size_t j
+)
+{
+    return m->members[e->first + j];
+}
+
 #endif /* LIMINAL_CONVERGENCE_MAP_H */
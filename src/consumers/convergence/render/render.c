@@ -32,7 +32,7 @@ void render_convergence(const ConvergenceMap *m)
         );
 
         for (size_t j = 0; j < e->count; j++) {
-            const Diagnostic *d = e->diagnostics[j];
+            const Diagnostic *d = convergence_entry_diagnostic(m, e, j);
             printf(
                 "  ↳ %s (time=%llu)\n",
                 diagnostic_kind_name(d->kind),
@@ -6,6 +6,7 @@
 #include "./anchor/anchor.h"
 #include "./cause/cause.h"
 #include "./diff/diff.h"
+#include "./index/index.h"
 #include "./render/render.h"
 #include "./anchor/anchor.h"
 #include "./stats/stats.h"
@@ -1,4 +1,5 @@
 #include "./diff.h"
+#include "../index/index.h"
 
 /*
  * diagnostic_diff
@@ -6,12 +7,13 @@
  * Compare two diagnostic artifacts by stable DiagnosticId.
  *
  * Output guarantees:
- *  - Each DiagnosticId appears at most once
- *  - No allocation
+ *  - Old diagnostics first, in old order (UNCHANGED / REMOVED),
+ *    then new ones missing from the old run, in new order (ADDED)
  *  - No sorting
  *  - Deterministic
  *
- * Complexity: O(n²) by design (small n, stable identity)
+ * Complexity: O(n) through a DiagnosticIndex on each run; the
+ * index tables are the only allocation.
  */
 size_t diagnostic_diff(
     const DiagnosticArtifact *old_run,
@@ -25,20 +27,15 @@ size_t diagnostic_diff(
     if (!out || cap == 0)
         return 0;
 
+    DiagnosticIndex old_ix, new_ix;
+    diagnostic_index_build(&old_ix, old_run);
+    diagnostic_index_build(&new_ix, new_run);
+
     /* ---- REMOVED / UNCHANGED ---- */
-    for (size_t i = 0; old_run && i < old_run->count; i++) {
+    for (size_t i = 0; old_run && i < old_run->count && count < cap; i++) {
         DiagnosticId id = old_run->items[i].id;
-        int found = 0;
-
-        for (size_t j = 0; new_run && j < new_run->count; j++) {
-            if (new_run->items[j].id.value == id.value) {
-                found = 1;
-                break;
-            }
-        }
-
-        if (count >= cap)
-            return count;
+        int found = diagnostic_index_find(&new_ix, id.value) !=
+                    DIAGNOSTIC_INDEX_NONE;
 
         out[count++] = (DiagnosticDiff){
             .kind = found ? DIFF_UNCHANGED : DIFF_REMOVED,
@@ -47,18 +44,11 @@ size_t diagnostic_diff(
     }
 
     /* ---- ADDED ---- */
-    for (size_t i = 0; new_run && i < new_run->count; i++) {
+    for (size_t i = 0; new_run && i < new_run->count && count < cap; i++) {
         DiagnosticId id = new_run->items[i].id;
-        int found = 0;
-
-        for (size_t j = 0; old_run && j < old_run->count; j++) {
-            if (old_run->items[j].id.value == id.value) {
-                found = 1;
-                break;
-            }
-        }
 
-        if (!found && count < cap) {
+        if (diagnostic_index_find(&old_ix, id.value) ==
+            DIAGNOSTIC_INDEX_NONE) {
             out[count++] = (DiagnosticDiff){
                 .kind = DIFF_ADDED,
                 .id   = id
@@ -66,5 +56,7 @@ size_t diagnostic_diff(
         }
     }
 
+    diagnostic_index_free(&old_ix);
+    diagnostic_index_free(&new_ix);
     return count;
 }
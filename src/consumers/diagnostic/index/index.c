@@ -0,0 +1,80 @@
+#include <stdlib.h>
+
+#include "./index.h"
+
+/* Fibonacci hashing: ids are structured, spread them over the table */
+static size_t slot_of(const DiagnosticIndex *ix, uint64_t id)
+{
+    return (size_t)((id * 0x9e3779b97f4a7c15ull) >> ix->shift);
+}
+
+void diagnostic_index_build(DiagnosticIndex *ix, const DiagnosticArtifact *a)
+{
+    ix->a = a;
+    ix->slots = NULL;
+    ix->shift = 64;
+
+    size_t n = a ? a->count : 0;
+    if (n == 0 || n > UINT32_MAX - 1) {
+        return;
+    }
+
+    /* At most half full */
+    unsigned bits = 4;
+    while (((size_t)1 << bits) < n * 2) {
+        bits++;
+    }
+
+    ix->slots = calloc((size_t)1 << bits, sizeof(*ix->slots));
+    if (!ix->slots) {
+        return;
+    }
+    ix->shift = 64 - bits;
+
+    size_t mask = ((size_t)1 << bits) - 1;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t id = a->items[i].id.value;
+        size_t s = slot_of(ix, id);
+
+        /* Keep the first occurrence of a repeated id */
+        while (ix->slots[s] &&
+               a->items[ix->slots[s] - 1].id.value != id) {
+            s = (s + 1) & mask;
+        }
+        if (!ix->slots[s]) {
+            ix->slots[s] = (uint32_t)(i + 1);
+        }
+    }
+}
+
+void diagnostic_index_free(DiagnosticIndex *ix)
+{
+    free(ix->slots);
+    ix->slots = NULL;
+}
+
+size_t diagnostic_index_find(const DiagnosticIndex *ix, uint64_t id)
+{
+    const DiagnosticArtifact *a = ix->a;
+
+    if (!a) {
+        return DIAGNOSTIC_INDEX_NONE;
+    }
+
+    if (!ix->slots) {
+        for (size_t i = 0; i < a->count; i++) {
+            if (a->items[i].id.value == id) {
+                return i;
+            }
+        }
+        return DIAGNOSTIC_INDEX_NONE;
+    }
+
+    size_t mask = ((size_t)1 << (64 - ix->shift)) - 1;
+    for (size_t s = slot_of(ix, id); ix->slots[s]; s = (s + 1) & mask) {
+        if (a->items[ix->slots[s] - 1].id.value == id) {
+            return ix->slots[s] - 1;
+        }
+    }
+    return DIAGNOSTIC_INDEX_NONE;
+}
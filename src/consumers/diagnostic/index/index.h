@@ -0,0 +1,34 @@
+#ifndef LIMINAL_DIAGNOSTIC_INDEX_H
+#define LIMINAL_DIAGNOSTIC_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "analyzer/analyzer.h"
+
+/*
+ * DiagnosticIndex
+ *
+ * Open-addressing hash index from DiagnosticId to the position of
+ * its first occurrence in an artifact. Used to join two runs on
+ * identity in O(n).
+ *
+ * The artifact is borrowed and must not change while indexed.
+ * If the table cannot be allocated the index still works, falling
+ * back to a linear scan.
+ */
+typedef struct DiagnosticIndex {
+    const DiagnosticArtifact *a;
+    uint32_t *slots;        /* position + 1; 0 = empty */
+    unsigned  shift;        /* 64 - log2(slot count) */
+} DiagnosticIndex;
+
+#define DIAGNOSTIC_INDEX_NONE ((size_t)-1)
+
+void diagnostic_index_build(DiagnosticIndex *ix, const DiagnosticArtifact *a);
+void diagnostic_index_free(DiagnosticIndex *ix);
+
+/* Position of the first diagnostic with `id`, or DIAGNOSTIC_INDEX_NONE */
+size_t diagnostic_index_find(const DiagnosticIndex *ix, uint64_t id);
+
+#endif /* LIMINAL_DIAGNOSTIC_INDEX_H */
@@ -1,7 +1,51 @@
 #include "analyzer/analyzer.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+typedef struct LoadState {
+    DiagnosticArtifact *out;
+    size_t cap;
+    int    nomem;
+} LoadState;
+
+static int collect(const Diagnostic *d, void *ctx)
+{
+    LoadState *s = ctx;
+    DiagnosticArtifact *a = s->out;
+
+    if (a->count == s->cap) {
+        size_t ncap = s->cap ? s->cap * 2 : 256;
+        Diagnostic *np = realloc(a->items, ncap * sizeof(*np));
+        if (!np) {
+            s->nomem = 1;
+            return 0;
+        }
+        a->items = np;
+        s->cap = ncap;
+    }
+
+    Diagnostic *slot = &a->items[a->count];
+    *slot = *d;
+    if (d->anchor) {
+        slot->anchor = malloc(sizeof(*slot->anchor));
+        if (!slot->anchor) {
+            s->nomem = 1;
+            return 0;
+        }
+        *slot->anchor = *d->anchor;
+    }
+    a->count++;
+    return 1;
+}
+
+/*
+ * Load every record of a diagnostics.ndjson.
+ *
+ * Returns 0 on success, 2 if the file cannot be opened, 3 on a
+ * malformed record, 4 on a read or allocation failure. On failure
+ * `out` is left empty.
+ */
 int load_diagnostics(const char *path, DiagnosticArtifact *out)
 {
     if (!path || !out)
@@ -11,17 +55,15 @@ int load_diagnostics(const char *path, DiagnosticArtifact *out)
     if (!f)
         return 2;
 
-    Diagnostic *buf = calloc(256, sizeof(Diagnostic));
-    size_t count = 0;
-
-    while (count < 256 &&
-           diagnostic_deserialize_line(f, &buf[count])) {
-        count++;
-    }
+    memset(out, 0, sizeof(*out));
+    LoadState s = { .out = out };
 
+    int rc = diagnostic_read_ndjson(f, collect, &s, NULL);
     fclose(f);
 
-    out->items = buf;
-    out->count = count;
+    if (rc != 0 || s.nomem) {
+        diagnostic_artifact_free(out);
+        return rc == 1 ? 3 : 4;
+    }
     return 0;
 }
@@ -1,29 +1,26 @@
 #include <stdlib.h>
-#include <string.h>
 #include "./fix_surface.h"
 
 
-static void add_cause(FixSurface *fs, const CauseKey *key)
-{
-    if (fs->count == fs->capacity) {
-        size_t nc = fs->capacity ? fs->capacity * 2 : 4;
-        fs->causes = realloc(fs->causes, nc * sizeof(*fs->causes));
-        fs->capacity = nc;
-    }
-    fs->causes[fs->count++] = *key;
-}
-
 FixSurface build_fix_surface(const ConvergenceMap *map)
 {
     FixSurface fs = {0};
 
     /* In current architecture:
        every diagnostic belongs to exactly one cause.
-       So minimal fix surface = all unique causes.
+       So minimal fix surface = all unique causes,
+       which the map already holds once each.
      */
+    if (map->count == 0)
+        return fs;
+
+    fs.causes = malloc(map->count * sizeof(*fs.causes));
+    if (!fs.causes)
+        return fs;
+    fs.capacity = map->count;
 
     for (size_t i = 0; i < map->count; i++) {
-        add_cause(&fs, &map->entries[i].key);
+        fs.causes[fs.count++] = map->entries[i].key;
     }
 
     return fs;
@@ -1,73 +1,63 @@
 #include "./cause.h"
+#include "../index/index.h"
 #include "../../../executor/executor.h"
-#include "../../../frontends/frontends.h"
 #include "../../../analyzer/analyzer.h"
 
 RootCause root_cause_extract(
-    const struct World *head,
+    const struct CausalIndex *ix,
     const struct Diagnostic *d
 )
 {
-    const struct World *w = head;
+    /* Time is the index: look just before the diagnostic */
+    size_t t = (ix && d->time < ix->count) ? (size_t)d->time : 0;
+    uint32_t at = CAUSAL_NONE;
+    RootCauseKind kind = ROOT_CAUSE_UNKNOWN;
 
-    /* Seek to diagnostic time */
-    while (w && w->time != d->time)
-        w = w->next;
-
-    /* Walk backwards */
-    while (w && w->prev) {
-        w = w->prev;
-        if (!w->step)
-            continue;
+    if (t > 0) {
+        /* Scope entry / exit is authoritative */
+        at = ix->prev_scope[t];
+        if (at != CAUSAL_NONE) {
+            kind = causal_index_step(ix, at)->step == STEP_ENTER_SCOPE
+                 ? ROOT_CAUSE_SCOPE_ENTRY
+                 : ROOT_CAUSE_SCOPE_EXIT;
+        }
 
-        ASTNode *n = (ASTNode *)w->step->origin;
-        uint64_t ast_id = n ? n->id : 0;
+        /* ...unless the step the diagnostic is about came later */
+        uint32_t near = CAUSAL_NONE;
+        RootCauseKind near_kind = ROOT_CAUSE_UNKNOWN;
 
-        /* Declaration-related diagnostics */
         if (d->kind == DIAG_REDECLARATION ||
             d->kind == DIAG_SHADOWING) {
-
-            if (w->step->kind == STEP_DECLARE) {
-                return (RootCause){
-                    .kind     = ROOT_CAUSE_DECLARATION,
-                    .time     = w->time,
-                    .ast_id   = ast_id,
-                    .scope_id = d->scope_id   /* diagnostic-derived */
-                };
-            }
+            near = ix->prev_declare[t];
+            near_kind = ROOT_CAUSE_DECLARATION;
+        } else if (d->kind == DIAG_USE_BEFORE_DECLARE) {
+            near = ix->prev_use[t];
+            near_kind = ROOT_CAUSE_USE;
         }
 
-        /* Use-related diagnostics */
-        if (d->kind == DIAG_USE_BEFORE_DECLARE) {
-            if (w->step->kind == STEP_USE) {
-                return (RootCause){
-                    .kind     = ROOT_CAUSE_USE,
-                    .time     = w->time,
-                    .ast_id   = ast_id,
-                    .scope_id = d->scope_id
-                };
-            }
+        if (near != CAUSAL_NONE && (at == CAUSAL_NONE || near > at)) {
+            at = near;
+            kind = near_kind;
         }
+    }
 
-        /* Scope entry / exit is authoritative */
-        if (w->step->kind == STEP_ENTER_SCOPE ||
-            w->step->kind == STEP_EXIT_SCOPE) {
-
-            return (RootCause){
-                .kind     = (w->step->kind == STEP_ENTER_SCOPE)
-                              ? ROOT_CAUSE_SCOPE_ENTRY
-                              : ROOT_CAUSE_SCOPE_EXIT,
-                .time     = w->time,
-                .ast_id   = ast_id,
-                .scope_id = w->step->info   /* ← THIS is correct */
-            };
-        }
+    if (at == CAUSAL_NONE) {
+        return (RootCause){
+            .kind     = ROOT_CAUSE_UNKNOWN,
+            .time     = d->time,
+            .ast_id   = 0,
+            .scope_id = d->scope_id
+        };
     }
 
+    const RootChainStep *s = causal_index_step(ix, at);
     return (RootCause){
-        .kind     = ROOT_CAUSE_UNKNOWN,
-        .time     = d->time,
-        .ast_id   = 0,
-        .scope_id = d->scope_id
+        .kind     = kind,
+        .time     = at,
+        .ast_id   = s->ast_id,
+        /* scope steps carry their own; others are diagnostic-derived */
+        .scope_id = kind == ROOT_CAUSE_SCOPE_ENTRY ||
+                    kind == ROOT_CAUSE_SCOPE_EXIT ? s->scope_id
+                                                  : d->scope_id
     };
 }
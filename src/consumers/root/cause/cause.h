@@ -19,6 +19,18 @@ typedef struct RootCause {
     uint64_t scope_id;
 } RootCause;
 
+struct CausalIndex;
+struct Diagnostic;
 
+/*
+ * Closest step before the diagnostic that explains it: the
+ * latest scope entry / exit, or a later DECLARE (redeclaration,
+ * shadowing) or USE (use before declare). O(1) through the
+ * index back-pointers.
+ */
+RootCause root_cause_extract(
+    const struct CausalIndex *ix,
+    const struct Diagnostic *d
+);
 
 #endif
@@ -8,97 +8,52 @@
 #include "consumers/consumers.h"
 
 #include "analyzer/analyzer.h"
-#include "frontends/frontends.h"   /* for ASTNode */
+#include "./build.h"
 #include "./role.h"
 
 /*
- * Build a root-cause chain by walking the World timeline backwards
- * from the diagnostic time.
+ * Build a root-cause chain from the shared newest-first steps.
  *
- * nodes[0] is the closest causal event to the diagnostic.
+ * steps[0] is the closest causal event to the diagnostic.
  */
 RootChain build_root_chain(
-    Arena *arena,
-    const World *world_tail,
+    const CausalIndex *ix,
     const Diagnostic *diag
 )
 {
     RootChain chain = {0};
     chain.diagnostic_id = diag->id;
+    chain.kind = diag->kind;
+    chain.scope_id = diag->scope_id;
 
-    /* ----------------------------------------
-     * First pass: count causal steps
-     * ---------------------------------------- */
-    size_t count = 0;
-
-    for (const World *w = world_tail; w; w = w->prev) {
-        if (w->time > diag->time)
-            continue;
-
-        if (!w->step)
-            continue;
-
-        count++;
-    }
-
-    if (count == 0)
+    if (!ix || ix->count == 0)
         return chain;
 
     /* ----------------------------------------
-     * Allocate nodes
+     * Every step at or before the diagnostic is causal:
+     * times [0, last] with time == index
      * ---------------------------------------- */
-    RootChainNode *nodes = arena_alloc(arena, count * sizeof(*nodes));
-    if (!nodes)
-        return chain;
-
-    /* ----------------------------------------
-     * Second pass: populate nodes
-     * ---------------------------------------- */
-    size_t i = 0;
-
-    for (const World *w = world_tail; w; w = w->prev) {
-        if (w->time > diag->time)
-            continue;
-
-        const Step *s = w->step;
-        if (!s)
-            continue;
+    size_t last = diag->time < ix->count
+        ? (size_t)diag->time
+        : ix->count - 1;
 
-        RootChainNode *n = &nodes[i++];
-
-        n->time = w->time;
-        n->step = s->kind;
-
-        /* Derive AST id from origin */
-        if (s->origin) {
-            const struct ASTNode *ast = (const struct ASTNode *)s->origin;
-            n->ast_id = ast->id;
-        } else {
-            n->ast_id = 0;
-        }
-
-        /* Derive scope id conservatively */
-        switch (s->kind) {
-            case STEP_ENTER_SCOPE:
-            case STEP_EXIT_SCOPE:
-                n->scope_id = s->info;
-                break;
-
-            default:
-                n->scope_id = diag->scope_id;
-                break;
-        }
-
-        n->role = ROOT_ROLE_WITNESS;
-    }
-
-    chain.nodes = nodes;
-    chain.count = i;
-
-    /* ----------------------------------------
-     * Assign semantic roles
-     * ---------------------------------------- */
-    assign_root_chain_roles(&chain, diag->kind);
+    chain.steps = causal_index_step(ix, last);
+    chain.count = last + 1;
 
     return chain;
 }
+
+RootChainNode root_chain_node(const RootChain *chain, size_t i)
+{
+    const RootChainStep *s = &chain->steps[i];
+    int is_scope = s->step == STEP_ENTER_SCOPE ||
+                   s->step == STEP_EXIT_SCOPE;
+
+    return (RootChainNode){
+        .time     = s->time,
+        .step     = s->step,
+        .ast_id   = s->ast_id,
+        .scope_id = is_scope ? s->scope_id : chain->scope_id,
+        .role     = root_chain_role(chain->kind, i, s->step)
+    };
+}
@@ -6,19 +6,20 @@
 #include "../../../common/common.h"              // ✅ REQUIRED
 #include "../../../executor/executor.h"
 #include "./chain.h"
+#include "../index/index.h"
 
 /*
- * Build a root-cause chain by walking the World timeline backwards.
+ * Build a root-cause chain: every step at or before the
+ * diagnostic, newest first.
  *
  * PURE:
  *  - no mutation
- *  - arena-only allocation
+ *  - no allocation; O(1), the steps are shared with `ix`
  */
 RootChain build_root_chain(
-    Arena *arena,
-    const World *head,
+    const CausalIndex *ix,
     const Diagnostic *diag
 );
 
 
-#endif /* LIMINAL_ROOT_CHAIN_H */
+#endif /* LIMINAL_ROOT_BUILD_H */
@@ -8,7 +8,7 @@
 
 
 void build_and_render_root_chains(
-    const World *world,
+    const Timeline *tl,
     const DiagnosticArtifact *diags
 )
 {
@@ -18,10 +18,15 @@ void build_and_render_root_chains(
     Arena arena;
     arena_init(&arena, 4096);
 
+    CausalIndex ix;
+    if (causal_index_build(&arena, tl, &ix) != 0) {
+        arena_destroy(&arena);
+        return;
+    }
+
     for (size_t i = 0; i < diags->count; i++) {
         struct RootChain chain = build_root_chain(
-            &arena,
-            world,
+            &ix,
             &diags->items[i]
         );
         render_root_chain(&chain);
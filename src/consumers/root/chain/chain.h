@@ -21,6 +21,20 @@ typedef enum RootRole {
     ROOT_ROLE_SUPPRESSOR
 } RootRole;
 
+/*
+ * RootChainStep
+ *
+ * One timeline step as chains see it. Chains point into the
+ * CausalIndex copy of these instead of owning theirs.
+ */
+typedef struct RootChainStep {
+    uint64_t time;
+    StepKind step;
+    uint64_t ast_id;
+    uint64_t scope_id;      /* ENTER/EXIT_SCOPE only, else 0 */
+} RootChainStep;
+
+/* Node i of a chain, with its diagnostic applied */
 typedef struct RootChainNode {
     uint64_t time;
     StepKind step;
@@ -29,12 +43,27 @@ typedef struct RootChainNode {
     RootRole role;
 } RootChainNode;
 
+/*
+ * RootChain
+ *
+ * steps[0] is the closest causal event to the diagnostic. The
+ * steps are a suffix of the shared CausalIndex array, so chains
+ * of earlier diagnostics are suffixes of later ones; read nodes
+ * through root_chain_node.
+ */
 typedef struct RootChain {
     DiagnosticId diagnostic_id;
-    RootChainNode *nodes;
+    DiagnosticKind kind;
+    uint64_t scope_id;              /* diagnostic scope */
+    const RootChainStep *steps;
     size_t count;
 } RootChain;
 
+/*
+ * Node i: scope steps keep their own scope, every other step
+ * reports the diagnostic's; the role follows root_chain_role.
+ */
+RootChainNode root_chain_node(const RootChain *chain, size_t i);
 
 /* Render only */
 void render_root_chain(const RootChain *chain);
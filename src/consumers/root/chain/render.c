@@ -23,14 +23,14 @@ void render_root_chain(const RootChain *chain)
     printf("----------------------------\n");
 
     for (size_t i = 0; i < chain->count; i++) {
-        const RootChainNode *n = &chain->nodes[i];
+        RootChainNode n = root_chain_node(chain, i);
         printf(
             "[t=%llu] %-11s step=%s ast=%llu scope=%llu\n",
-            (unsigned long long)n->time,
-            role_str(n->role),
-            step_kind_str(n->step),
-            (unsigned long long)n->ast_id,
-            (unsigned long long)n->scope_id
+            (unsigned long long)n.time,
+            role_str(n.role),
+            step_kind_str(n.step),
+            (unsigned long long)n.ast_id,
+            (unsigned long long)n.scope_id
         );
     }
 }
@@ -1,40 +1,34 @@
 #include "consumers/consumers.h"
 #include "analyzer/analyzer.h"
+#include "./role.h"
 
 /*
  * Assign semantic roles based on diagnostic kind and causal distance.
  *
- * nodes[0] is the closest cause to the diagnostic.
+ * depth 0 is the closest cause to the diagnostic.
  */
-void assign_root_chain_roles(RootChain *chain, DiagnosticKind kind)
+RootRole root_chain_role(
+    DiagnosticKind kind,
+    size_t depth,
+    StepKind step
+)
 {
-    if (!chain || chain->count == 0)
-        return;
-
-    for (size_t i = 0; i < chain->count; i++) {
-        RootChainNode *n = &chain->nodes[i];
-
-        if (i == 0) {
-            /* Closest event to diagnostic */
-            n->role = ROOT_ROLE_CAUSE;
-            continue;
-        }
+    if (depth == 0) {
+        /* Closest event to diagnostic */
+        return ROOT_ROLE_CAUSE;
+    }
 
-        switch (kind) {
-            case DIAG_USE_BEFORE_DECLARE:
-            case DIAG_REDECLARATION:
-            case DIAG_SHADOWING:
-                if (n->step == STEP_DECLARE ||
-                    n->step == STEP_USE) {
-                    n->role = ROOT_ROLE_AMPLIFIER;
-                } else {
-                    n->role = ROOT_ROLE_WITNESS;
-                }
-                break;
+    switch (kind) {
+        case DIAG_USE_BEFORE_DECLARE:
+        case DIAG_REDECLARATION:
+        case DIAG_SHADOWING:
+            if (step == STEP_DECLARE ||
+                step == STEP_USE) {
+                return ROOT_ROLE_AMPLIFIER;
+            }
+            return ROOT_ROLE_WITNESS;
 
-            default:
-                n->role = ROOT_ROLE_WITNESS;
-                break;
-        }
+        default:
+            return ROOT_ROLE_WITNESS;
     }
 }
@@ -5,13 +5,15 @@
 #include "analyzer/analyzer.h"
 
 /*
- * Assign semantic roles to nodes in a root-cause chain.
+ * Semantic role of the node `depth` steps back from a
+ * diagnostic of `kind`.
  *
- * nodes[0] is the closest causal event to the diagnostic.
+ * depth 0 is the closest causal event to the diagnostic.
  */
-void assign_root_chain_roles(
-    RootChain *chain,
-    DiagnosticKind kind
+RootRole root_chain_role(
+    DiagnosticKind kind,
+    size_t depth,
+    StepKind step
 );
 
 #endif /* LIMINAL_ROOT_CHAIN_ROLE_H */
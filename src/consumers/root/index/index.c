@@ -0,0 +1,67 @@
+#include <stdint.h>
+
+#include "./index.h"
+#include "frontends/frontends.h"   /* for ASTNode */
+
+int causal_index_build(
+    Arena *arena,
+    const Timeline *tl,
+    CausalIndex *out
+)
+{
+    *out = (CausalIndex){0};
+
+    size_t count = tl ? tl->count : 0;
+    if (count == 0) {
+        return 0;
+    }
+    if (count >= CAUSAL_NONE) {
+        return 1;
+    }
+
+    RootChainStep *steps = arena_alloc_uninit(arena, count * sizeof(*steps));
+    uint32_t *scope   = arena_alloc_uninit(arena, count * sizeof(*scope));
+    uint32_t *declare = arena_alloc_uninit(arena, count * sizeof(*declare));
+    uint32_t *use     = arena_alloc_uninit(arena, count * sizeof(*use));
+
+    if (!steps || !scope || !declare || !use) {
+        return 1;
+    }
+
+    uint32_t at_scope = CAUSAL_NONE;
+    uint32_t at_declare = CAUSAL_NONE;
+    uint32_t at_use = CAUSAL_NONE;
+
+    for (size_t t = 0; t < count; t++) {
+        StepKind kind = timeline_kind(tl, t);
+        const ASTNode *ast = timeline_origin(tl, t);
+        uint64_t info = timeline_info(tl, t);
+        int is_scope = kind == STEP_ENTER_SCOPE || kind == STEP_EXIT_SCOPE;
+
+        steps[count - 1 - t] = (RootChainStep){
+            .time     = t,
+            .step     = kind,
+            .ast_id   = ast ? ast->id : 0,
+            .scope_id = is_scope ? info : 0
+        };
+
+        scope[t]   = at_scope;
+        declare[t] = at_declare;
+        use[t]     = at_use;
+
+        if (is_scope) {
+            at_scope = (uint32_t)t;
+        } else if (kind == STEP_DECLARE) {
+            at_declare = (uint32_t)t;
+        } else if (kind == STEP_USE) {
+            at_use = (uint32_t)t;
+        }
+    }
+
+    out->count        = count;
+    out->newest_first = steps;
+    out->prev_scope   = scope;
+    out->prev_declare = declare;
+    out->prev_use     = use;
+    return 0;
+}
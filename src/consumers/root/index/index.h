@@ -0,0 +1,57 @@
+#ifndef LIMINAL_ROOT_INDEX_H
+#define LIMINAL_ROOT_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../../common/common.h"
+#include "../../../executor/executor.h"
+#include "../chain/chain.h"
+
+/* No earlier step of the kind asked for */
+#define CAUSAL_NONE UINT32_MAX
+
+/*
+ * CausalIndex
+ *
+ * Random-access view of one Timeline, built once in O(T) and
+ * shared by every root chain and root cause derived from it.
+ *
+ *   newest_first[i]  — the step at time count - 1 - i; the chain
+ *                      of a diagnostic at time t is the suffix
+ *                      starting at count - 1 - t
+ *   prev_scope[t]    — latest ENTER/EXIT_SCOPE before t, of any
+ *                      scope id
+ *   prev_declare[t]  — latest DECLARE before t
+ *   prev_use[t]      — latest USE before t
+ *
+ * Back-pointers are indexed by time and ignore ids: each answers
+ * "the last step of this kind before t", all root_cause_extract
+ * asks. They hold times, CAUSAL_NONE when there is none.
+ * Everything lives in the arena passed to causal_index_build.
+ */
+typedef struct CausalIndex {
+    size_t count;
+    const RootChainStep *newest_first;
+    const uint32_t *prev_scope;
+    const uint32_t *prev_declare;
+    const uint32_t *prev_use;
+} CausalIndex;
+
+/* Returns 0 on success, 1 on allocation failure or overflow */
+int causal_index_build(
+    Arena *arena,
+    const Timeline *tl,
+    CausalIndex *out
+);
+
+/* Step at time t (t < count) */
+static inline const RootChainStep *causal_index_step(
+    const CausalIndex *ix,
+    size_t t
+)
+{
+    return &ix->newest_first[ix->count - 1 - t];
+}
+
+#endif /* LIMINAL_ROOT_INDEX_H */
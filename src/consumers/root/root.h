@@ -3,6 +3,7 @@
 
 #include "./chain/chain.h"
 #include "./cause/cause.h"
+#include "./index/index.h"
 
 #endif
 
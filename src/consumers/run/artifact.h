@@ -3,6 +3,8 @@
 
 #include <stddef.h>
 #include "../../analyzer/analyzer.h"
+#include "../timeline/binary.h"
+#include "../timeline/event.h"
 
 /*
  * Loaded run snapshot.
@@ -16,14 +18,17 @@ typedef struct RunArtifact {
 
     DiagnosticArtifact diagnostics;
 
-    /* Timeline (opaque for now) */
-    struct {
-        unsigned long time;
-        int step;
-        unsigned int ast;
-    } *timeline;
+    /* timeline.ndjson records (NULL when absent, or when
+     * timeline.bin was loaded instead) */
+    TimelineEvent *timeline;
 
     size_t timeline_count;
+
+    /* timeline.bin, mapped; count 0 when absent */
+    TimelineColumns timeline_columns;
+
+    /* Opening timeline.bin (OK when absent); load_run fails if not OK */
+    TimelineBinaryStatus timeline_bin_status;
 } RunArtifact;
 
 #endif /* LIMINAL_RUN_ARTIFACT_H */
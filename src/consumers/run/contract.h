@@ -10,6 +10,7 @@
  *
  * Optional:
  *   - timeline.ndjson
+ *   - timeline.bin (preferred; must open if present)
  */
 typedef struct RunContract {
     int require_meta;
@@ -14,6 +14,7 @@ typedef struct RunDescriptor {
     const char *meta_path;
     const char *diagnostics_path;
     const char *timeline_path;
+    const char *timeline_bin_path;      /* optional, preferred */
 } RunDescriptor;
 
 #endif /* LIMINAL_RUN_DESCRIPTOR_H */
@@ -1,9 +1,11 @@
+#include <sys/stat.h>
+
 #include "./descriptor.h"
 #include "./artifact.h"
+#include "../timeline/load_timeline.h"
 
 int run_probe(const RunDescriptor *rd);
 int load_diagnostics(const char *path, DiagnosticArtifact *out);
-int load_timeline(const char *path, void **out, size_t *count);
 
 int load_run(const RunDescriptor *rd, RunArtifact *out)
 {
@@ -20,11 +22,23 @@ int load_run(const RunDescriptor *rd, RunArtifact *out)
                           &out->diagnostics) != 0)
         return 10;
 
-    /* Timeline optional */
-    if (rd->timeline_path) {
+    /*
+     * Timeline optional. The binary form needs no parsing, so the
+     * NDJSON is only read without one; a timeline.bin that exists
+     * but does not open is an error, not a reason to fall back.
+     */
+    struct stat st;
+    if (rd->timeline_bin_path && stat(rd->timeline_bin_path, &st) == 0) {
+        out->timeline_bin_status = timeline_binary_open(
+            rd->timeline_bin_path,
+            &out->timeline_columns
+        );
+        if (out->timeline_bin_status != TIMELINE_BIN_OK)
+            return 11;
+    } else if (rd->timeline_path) {
         load_timeline(
             rd->timeline_path,
-            (void **)&out->timeline,
+            &out->timeline,
             &out->timeline_count
         );
     }
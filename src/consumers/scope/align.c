@@ -1,6 +1,46 @@
+#include <stdlib.h>
+
 #include "./align.h"
 #include "./signature.h"
 
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Signatures of every node, computed once; sorted when `sorted` */
+static uint64_t *signatures(const ScopeGraph *g, int sorted)
+{
+    uint64_t *sig = malloc((g->count ? g->count : 1) * sizeof(*sig));
+    if (!sig)
+        return NULL;
+
+    for (size_t i = 0; i < g->count; i++) {
+        sig[i] = scope_signature(&g->nodes[i]);
+    }
+    if (sorted) {
+        qsort(sig, g->count, sizeof(*sig), cmp_u64);
+    }
+    return sig;
+}
+
+static int contains(const uint64_t *sorted, size_t n, uint64_t sig)
+{
+    size_t lo = 0, hi = n;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (sorted[mid] < sig) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < n && sorted[lo] == sig;
+}
+
 size_t scope_align(
     const ScopeGraph *a,
     const ScopeGraph *b,
@@ -10,45 +50,41 @@ size_t scope_align(
 {
     size_t count = 0;
 
+    /* Both in input order, plus each sorted for lookups */
+    uint64_t *sig_a = signatures(a, 0);
+    uint64_t *sig_b = signatures(b, 0);
+    uint64_t *set_a = signatures(a, 1);
+    uint64_t *set_b = signatures(b, 1);
+
+    if (!sig_a || !sig_b || !set_a || !set_b)
+        goto done;
+
     /* Removed / unchanged */
     for (size_t i = 0; i < a->count && count < cap; i++) {
-        uint64_t sig_a = scope_signature(&a->nodes[i]);
-        int found = 0;
-
-        for (size_t j = 0; j < b->count; j++) {
-            if (sig_a == scope_signature(&b->nodes[j])) {
-                found = 1;
-                break;
-            }
-        }
+        int found = contains(set_b, b->count, sig_a[i]);
 
         out[count++] = (ScopeAlignment){
-            .old_sig = sig_a,
-            .new_sig = found ? sig_a : 0,
+            .old_sig = sig_a[i],
+            .new_sig = found ? sig_a[i] : 0,
             .kind = found ? SCOPE_UNCHANGED : SCOPE_REMOVED
         };
     }
 
     /* Added */
     for (size_t j = 0; j < b->count && count < cap; j++) {
-        uint64_t sig_b = scope_signature(&b->nodes[j]);
-        int found = 0;
-
-        for (size_t i = 0; i < a->count; i++) {
-            if (sig_b == scope_signature(&a->nodes[i])) {
-                found = 1;
-                break;
-            }
-        }
-
-        if (!found) {
+        if (!contains(set_a, a->count, sig_b[j])) {
             out[count++] = (ScopeAlignment){
                 .old_sig = 0,
-                .new_sig = sig_b,
+                .new_sig = sig_b[j],
                 .kind = SCOPE_ADDED
             };
         }
     }
 
+done:
+    free(sig_a);
+    free(sig_b);
+    free(set_a);
+    free(set_b);
     return count;
 }
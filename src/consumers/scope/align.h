@@ -1,7 +1,11 @@
 #ifndef LIMINAL_SCOPE_ALIGNMENT_H
 #define LIMINAL_SCOPE_ALIGNMENT_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+
+#include "./graph.h"
 
 typedef enum ScopeChangeKind {
     SCOPE_UNCHANGED,
@@ -18,4 +22,28 @@ typedef struct ScopeAlignment {
     ScopeChangeKind kind;
 } ScopeAlignment;
 
+/*
+ * scope_align
+ *
+ * Match scopes of two runs by signature: every scope of `a`
+ * (UNCHANGED or REMOVED, in order), then the scopes of `b` that
+ * `a` lacks (ADDED). Signatures are computed once per node and
+ * looked up in sorted copies, O(n log n).
+ *
+ * Returns the number of entries written to `out` (at most `cap`;
+ * 0 if memory runs out).
+ */
+size_t scope_align(
+    const ScopeGraph *a,
+    const ScopeGraph *b,
+    ScopeAlignment *out,
+    size_t cap
+);
+
+void scope_align_render(
+    const ScopeAlignment *a,
+    size_t count,
+    FILE *out
+);
+
 #endif
@@ -1,45 +1,80 @@
 #include "./graph_extract.h"
 #include "../../executor/executor.h"
 #include <stdlib.h>
+#include <string.h>
 
 ScopeGraph scope_graph_extract(
-    const struct World *head
+    const struct Timeline *tl
 )
 {
-    ScopeNode *buf = calloc(128, sizeof(ScopeNode));
-    size_t count = 0;
-
-    const struct World *w = head;
-
-    while (w) {
-        if (w->step) {
-            if (w->step->kind == STEP_ENTER_SCOPE) {
-                ScopeNode *n = &buf[count++];
-                n->scope_id   = w->step->info;
-                n->parent_id  =
-                    w->prev && w->prev->active_scope
-                        ? w->prev->active_scope->id
-                        : 0;
-                n->enter_time = w->time;
-                n->exit_time  = UINT64_MAX;
+    ScopeNode *buf = NULL;
+    size_t count = 0, cap = 0;
+
+    /* Nodes still open, innermost last */
+    size_t *open = NULL;
+    size_t depth = 0, open_cap = 0;
+
+    for (size_t t = 0; tl && t < tl->count; t++) {
+        StepKind kind = timeline_kind(tl, t);
+
+        if (kind == STEP_ENTER_SCOPE) {
+            const Scope *parent = t ? timeline_scope(tl, t - 1) : NULL;
+
+            if (count == cap) {
+                size_t nc = cap ? cap * 2 : 64;
+                ScopeNode *p = realloc(buf, nc * sizeof(*buf));
+                if (!p)
+                    goto fail;
+                buf = p;
+                cap = nc;
+            }
+            if (depth == open_cap) {
+                size_t nc = open_cap ? open_cap * 2 : 64;
+                size_t *p = realloc(open, nc * sizeof(*open));
+                if (!p)
+                    goto fail;
+                open = p;
+                open_cap = nc;
             }
 
-            if (w->step->kind == STEP_EXIT_SCOPE) {
-                uint64_t sid = w->step->info;
-                for (size_t i = count; i > 0; i--) {
-                    if (buf[i - 1].scope_id == sid &&
-                        buf[i - 1].exit_time == UINT64_MAX) {
-                        buf[i - 1].exit_time = w->time;
-                        break;
-                    }
+            ScopeNode *n = &buf[count];
+            n->scope_id   = timeline_info(tl, t);
+            n->parent_id  = parent ? parent->id : 0;
+            n->enter_time = t;
+            n->exit_time  = UINT64_MAX;
+            open[depth++] = count++;
+        }
+
+        if (kind == STEP_EXIT_SCOPE) {
+            /* Latest open node of this scope: the top when nested */
+            uint64_t sid = timeline_info(tl, t);
+            for (size_t i = depth; i > 0; i--) {
+                if (buf[open[i - 1]].scope_id == sid) {
+                    buf[open[i - 1]].exit_time = t;
+                    memmove(&open[i - 1], &open[i],
+                            (depth - i) * sizeof(*open));
+                    depth--;
+                    break;
                 }
             }
         }
-        w = w->next;
     }
 
+    free(open);
     return (ScopeGraph){
         .nodes = buf,
         .count = count
     };
+
+fail:
+    free(open);
+    free(buf);
+    return (ScopeGraph){0};
+}
+
+void scope_graph_free(ScopeGraph *g)
+{
+    free(g->nodes);
+    g->nodes = NULL;
+    g->count = 0;
 }
@@ -4,8 +4,15 @@
 #include "../../executor/executor.h"
 #include "./graph.h"
 
+/*
+ * One node per ENTER_SCOPE, in entry order; EXIT_SCOPE closes the
+ * latest open node of its scope. O(T) with a stack of open
+ * scopes. Returns an empty graph if memory runs out.
+ */
 ScopeGraph scope_graph_extract(
-    const struct World *head
+    const struct Timeline *tl
 );
 
+void scope_graph_free(ScopeGraph *g);
+
 #endif
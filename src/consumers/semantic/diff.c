@@ -1,10 +1,14 @@
 #include "./diff.h"
+#include "../diagnostic/index/index.h"
 
 /*
  * semantic_diff
  *
  * Identity axis: DiagnosticId
  * Temporal axis: time
+ *
+ * Each old diagnostic is joined with the first new one of the same
+ * id through a DiagnosticIndex, so the diff is O(n).
  */
 size_t semantic_diff(
     const DiagnosticArtifact *old_run,
@@ -18,60 +22,41 @@ size_t semantic_diff(
     if (!out || cap == 0)
         return 0;
 
+    DiagnosticIndex old_ix, new_ix;
+    diagnostic_index_build(&old_ix, old_run);
+    diagnostic_index_build(&new_ix, new_run);
+
     /* ---- REMOVED / UNCHANGED / MOVED ---- */
-    for (size_t i = 0; old_run && i < old_run->count; i++) {
+    for (size_t i = 0; old_run && i < old_run->count && count < cap; i++) {
         const Diagnostic *d_old = &old_run->items[i];
-        int found = 0;
-
-        for (size_t j = 0; new_run && j < new_run->count; j++) {
-            const Diagnostic *d_new = &new_run->items[j];
-            if (d_new->id.value == d_old->id.value) {
-                found = 1;
-                if (count >= cap)
-                    return count;
-
-                if (d_new->time == d_old->time) {
-                    out[count++] = (SemanticDiff){
-                        .kind = SEMDIFF_UNCHANGED,
-                        .id = d_old->id,
-                        .old_time = d_old->time,
-                        .new_time = d_new->time
-                    };
-                } else {
-                    out[count++] = (SemanticDiff){
-                        .kind = SEMDIFF_MOVED,
-                        .id = d_old->id,
-                        .old_time = d_old->time,
-                        .new_time = d_new->time
-                    };
-                }
-                break;
-            }
-        }
+        size_t j = diagnostic_index_find(&new_ix, d_old->id.value);
 
-        if (!found && count < cap) {
+        if (j == DIAGNOSTIC_INDEX_NONE) {
             out[count++] = (SemanticDiff){
                 .kind = SEMDIFF_REMOVED,
                 .id = d_old->id,
                 .old_time = d_old->time,
                 .new_time = 0
             };
+            continue;
         }
+
+        const Diagnostic *d_new = &new_run->items[j];
+        out[count++] = (SemanticDiff){
+            .kind = d_new->time == d_old->time ? SEMDIFF_UNCHANGED
+                                               : SEMDIFF_MOVED,
+            .id = d_old->id,
+            .old_time = d_old->time,
+            .new_time = d_new->time
+        };
     }
 
     /* ---- ADDED ---- */
-    for (size_t i = 0; new_run && i < new_run->count; i++) {
+    for (size_t i = 0; new_run && i < new_run->count && count < cap; i++) {
         const Diagnostic *d_new = &new_run->items[i];
-        int found = 0;
-
-        for (size_t j = 0; old_run && j < old_run->count; j++) {
-            if (old_run->items[j].id.value == d_new->id.value) {
-                found = 1;
-                break;
-            }
-        }
 
-        if (!found && count < cap) {
+        if (diagnostic_index_find(&old_ix, d_new->id.value) ==
+            DIAGNOSTIC_INDEX_NONE) {
             out[count++] = (SemanticDiff){
                 .kind = SEMDIFF_ADDED,
                 .id = d_new->id,
@@ -81,5 +66,7 @@ size_t semantic_diff(
         }
     }
 
+    diagnostic_index_free(&old_ix);
+    diagnostic_index_free(&new_ix);
     return count;
 }
@@ -21,9 +21,10 @@ typedef struct SemanticDiff {
 /*
  * Compute semantic diff between two runs.
  *
- * No allocation.
+ * O(n): hash join on DiagnosticId (index tables are the only
+ * allocation).
  * Deterministic.
- * Stable ordering.
+ * Stable ordering: old run order, then additions in new order.
  */
 size_t semantic_diff(
     const DiagnosticArtifact *old_run,
@@ -0,0 +1,565 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "consumers/consumers.h"
+#include "executor/executor.h"
+#include "frontends/frontends.h"   /* for ASTNode */
+#include "common/common.h"
+
+#define BIN_HEADER_SIZE 64
+#define BIN_BLOCK       65536
+
+static const char BIN_MAGIC[8] = { 'L', 'M', 'N', 'L', 'T', 'I', 'M', 'E' };
+
+/* ------------------------------------------------------------
+ * Encoding
+ * ------------------------------------------------------------ */
+
+static void put_le(unsigned char *out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        out[i] = (unsigned char)(v >> (8 * i));
+    }
+}
+
+static uint64_t get_le(const unsigned char *in, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+        v |= (uint64_t)in[i] << (8 * i);
+    }
+    return v;
+}
+
+static uint64_t zigzag(uint64_t delta)
+{
+    return (delta >> 63) ? ~(delta << 1) : delta << 1;
+}
+
+static uint64_t unzigzag(uint64_t z)
+{
+    return (z & 1) ? ~(z >> 1) : z >> 1;
+}
+
+static int host_is_le(void)
+{
+    const uint16_t one = 1;
+    return *(const unsigned char *)&one == 1;
+}
+
+static uint32_t ast_id_at(const Timeline *tl, size_t t)
+{
+    const ASTNode *n = (const ASTNode *)timeline_origin(tl, t);
+    return n ? n->id : 0;
+}
+
+static size_t varint_len(uint64_t v)
+{
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/* Name table index of entry `t`: its symbol, 0 if none */
+static uint32_t name_at(const Timeline *tl, size_t t, size_t k)
+{
+    Symbol sym = timeline_symbol_at(tl, t);
+    return sym < k ? sym : 0;
+}
+
+/* ------------------------------------------------------------
+ * Writer
+ *
+ * Payload goes out in BIN_BLOCK chunks, each folded into the
+ * checksum as it is flushed.
+ * ------------------------------------------------------------ */
+
+typedef struct BinWriter {
+    FILE         *out;
+    unsigned char buf[BIN_BLOCK];
+    size_t        n;
+    uint64_t      hash;
+    uint64_t      written;
+    int           ok;
+} BinWriter;
+
+static void bin_flush(BinWriter *w)
+{
+    if (w->n == 0) {
+        return;
+    }
+    w->hash = hash64(w->buf, w->n, w->hash);
+    w->ok = w->ok && fwrite(w->buf, 1, w->n, w->out) == w->n;
+    w->written += w->n;
+    w->n = 0;
+}
+
+static void bin_put(BinWriter *w, const unsigned char *p, size_t len)
+{
+    while (len > 0) {
+        size_t room = BIN_BLOCK - w->n;
+        size_t take = len < room ? len : room;
+
+        memcpy(w->buf + w->n, p, take);
+        w->n += take;
+        p += take;
+        len -= take;
+
+        if (w->n == BIN_BLOCK) {
+            bin_flush(w);
+        }
+    }
+}
+
+static void bin_put_fixed(BinWriter *w, uint64_t v, int bytes)
+{
+    unsigned char b[8];
+    put_le(b, v, bytes);
+    bin_put(w, b, (size_t)bytes);
+}
+
+static void bin_put_varint(BinWriter *w, uint64_t v)
+{
+    unsigned char b[10];
+    size_t n = 0;
+
+    while (v >= 0x80) {
+        b[n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    b[n++] = (unsigned char)v;
+    bin_put(w, b, n);
+}
+
+static uint64_t bin_offset(const BinWriter *w)
+{
+    return w->written + w->n;
+}
+
+int timeline_emit_binary(
+    const struct Timeline *tl,
+    FILE *out,
+    unsigned flags
+)
+{
+    static const Timeline empty = {0};
+    if (!tl) {
+        tl = &empty;
+    }
+
+    BinWriter *w = malloc(sizeof(*w));
+    if (!w) {
+        return 0;
+    }
+    *w = (BinWriter){ .out = out, .ok = 1 };
+
+    unsigned char header[BIN_HEADER_SIZE] = {0};
+    w->ok = fwrite(header, 1, sizeof(header), out) == sizeof(header);
+
+    int varint = (flags & TIMELINE_BIN_VARINT) != 0;
+    uint64_t start, prev, bytes[3];
+
+    flags &= TIMELINE_BIN_VARINT;
+    if (tl->symbols) {
+        flags |= TIMELINE_BIN_NAMES;
+    }
+
+    /* ---- NAMES ---- */
+    if (flags & TIMELINE_BIN_NAMES) {
+        size_t k = tl->symbols->count ? tl->symbols->count : 1;
+        uint64_t column = 0;
+
+        /* The column size leads the section, so measure it first */
+        prev = 0;
+        for (size_t t = 0; varint && t < tl->count; t++) {
+            uint64_t v = name_at(tl, t, k);
+            column += varint_len(zigzag(v - prev));
+            prev = v;
+        }
+        if (!varint) {
+            column = ((uint64_t)tl->count * 4 + 7) & ~(uint64_t)7;
+        }
+
+        bin_put_fixed(w, k, 8);
+        bin_put_fixed(w, column, 8);
+        for (size_t i = 0; i < k; i++) {
+            bin_put_fixed(w, intern_hash64(tl->symbols, (Symbol)i), 8);
+        }
+
+        start = bin_offset(w);
+        prev = 0;
+        for (size_t t = 0; t < tl->count; t++) {
+            uint64_t v = name_at(tl, t, k);
+            if (varint) {
+                bin_put_varint(w, zigzag(v - prev));
+                prev = v;
+            } else {
+                bin_put_fixed(w, v, 4);
+            }
+        }
+        while (bin_offset(w) - start < column) {
+            bin_put_fixed(w, 0, 1);
+        }
+    }
+
+    /* ---- INFO ---- */
+    start = bin_offset(w);
+    prev = 0;
+    for (size_t t = 0; t < tl->count; t++) {
+        uint64_t v = timeline_info(tl, t);
+        if (varint) {
+            bin_put_varint(w, zigzag(v - prev));
+            prev = v;
+        } else {
+            bin_put_fixed(w, v, 8);
+        }
+    }
+    bytes[0] = bin_offset(w) - start;
+
+    /* ---- AST ---- */
+    start = bin_offset(w);
+    prev = 0;
+    for (size_t t = 0; t < tl->count; t++) {
+        uint64_t v = ast_id_at(tl, t);
+        if (varint) {
+            bin_put_varint(w, zigzag(v - prev));
+            prev = v;
+        } else {
+            bin_put_fixed(w, v, 4);
+        }
+    }
+    bytes[1] = bin_offset(w) - start;
+
+    /* ---- STEP ---- */
+    start = bin_offset(w);
+    bin_put(w, tl->kind, tl->count);
+    bytes[2] = bin_offset(w) - start;
+
+    bin_flush(w);
+
+    /* ---- HEADER ---- */
+    memcpy(header, BIN_MAGIC, sizeof(BIN_MAGIC));
+    put_le(header + 8, TIMELINE_BIN_VERSION, 4);
+    put_le(header + 12, flags, 4);
+    put_le(header + 16, tl->count, 8);
+    put_le(header + 24, bytes[0], 8);
+    put_le(header + 32, bytes[1], 8);
+    put_le(header + 40, bytes[2], 8);
+    put_le(header + 48, hash64_mix(w->hash, hash64(header, 48, 0)), 8);
+
+    int ok = w->ok && fseek(out, 0, SEEK_SET) == 0 &&
+             fwrite(header, 1, sizeof(header), out) == sizeof(header) &&
+             fseek(out, 0, SEEK_END) == 0;
+    free(w);
+    return ok;
+}
+
+/* ------------------------------------------------------------
+ * Reader
+ * ------------------------------------------------------------ */
+
+/* Decode `count` varint deltas; 0 unless exactly `len` bytes */
+static int decode_varints(const unsigned char *p, uint64_t len,
+                          size_t count, int bytes, void *out)
+{
+    const unsigned char *end = p + len;
+    uint64_t prev = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t z = 0;
+        int shift = 0;
+
+        for (;;) {
+            if (p == end || shift > 63) {
+                return 0;
+            }
+            unsigned char b = *p++;
+            z |= (uint64_t)(b & 0x7f) << shift;
+            shift += 7;
+            if (!(b & 0x80)) {
+                break;
+            }
+        }
+
+        prev += unzigzag(z);
+        if (bytes == 8) {
+            ((uint64_t *)out)[i] = prev;
+        } else if (prev > UINT32_MAX) {
+            return 0;
+        } else {
+            ((uint32_t *)out)[i] = (uint32_t)prev;
+        }
+    }
+    return p == end;
+}
+
+static void decode_fixed(const unsigned char *p, size_t count, int bytes,
+                         void *out)
+{
+    for (size_t i = 0; i < count; i++, p += bytes) {
+        if (bytes == 8) {
+            ((uint64_t *)out)[i] = get_le(p, 8);
+        } else {
+            ((uint32_t *)out)[i] = (uint32_t)get_le(p, 4);
+        }
+    }
+}
+
+/* 0 unless every name index is below `k` */
+static int names_in_table(const uint32_t *name, size_t count, uint64_t k)
+{
+    for (size_t t = 0; t < count; t++) {
+        if (name[t] >= k) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Validates the header and sizes every section. names[0] and
+ * names[1] are the name table entries and column bytes (both 0
+ * without TIMELINE_BIN_NAMES).
+ */
+static TimelineBinaryStatus check_header(const unsigned char *h,
+                                         size_t file_len,
+                                         uint64_t *count,
+                                         uint64_t bytes[3],
+                                         uint64_t names[2])
+{
+    const uint64_t known = TIMELINE_BIN_VARINT | TIMELINE_BIN_NAMES;
+
+    if (file_len < BIN_HEADER_SIZE ||
+        memcmp(h, BIN_MAGIC, sizeof(BIN_MAGIC)) != 0 ||
+        get_le(h + 8, 4) != TIMELINE_BIN_VERSION ||
+        (get_le(h + 12, 4) & ~known) != 0) {
+        return TIMELINE_BIN_FORMAT;
+    }
+
+    uint64_t flags = get_le(h + 12, 4);
+    *count = get_le(h + 16, 8);
+    uint64_t payload = file_len - BIN_HEADER_SIZE;
+    uint64_t sum = 0;
+
+    names[0] = names[1] = 0;
+    if (flags & TIMELINE_BIN_NAMES) {
+        if (payload < 16) {
+            return TIMELINE_BIN_FORMAT;
+        }
+        names[0] = get_le(h + BIN_HEADER_SIZE, 8);
+        names[1] = get_le(h + BIN_HEADER_SIZE + 8, 8);
+        sum = 16;
+        if (names[0] == 0 || names[0] > (payload - sum) / 8) {
+            return TIMELINE_BIN_FORMAT;
+        }
+        sum += names[0] * 8;
+        if (names[1] > payload - sum) {
+            return TIMELINE_BIN_FORMAT;
+        }
+        sum += names[1];
+    }
+
+    for (int i = 0; i < 3; i++) {
+        bytes[i] = get_le(h + 24 + 8 * i, 8);
+        if (bytes[i] > payload - sum) {
+            return TIMELINE_BIN_FORMAT;
+        }
+        sum += bytes[i];
+    }
+
+    /* Every column holds at least one byte per entry */
+    if (sum != payload || *count != bytes[2]) {
+        return TIMELINE_BIN_FORMAT;
+    }
+    if (!(flags & TIMELINE_BIN_VARINT) &&
+        (bytes[0] != *count * 8 || bytes[1] != *count * 4 ||
+         names[1] != ((flags & TIMELINE_BIN_NAMES)
+                      ? (*count * 4 + 7) & ~(uint64_t)7 : 0))) {
+        return TIMELINE_BIN_FORMAT;
+    }
+
+    uint64_t hash = 0;
+    for (uint64_t off = 0; off < payload; off += BIN_BLOCK) {
+        uint64_t n = payload - off < BIN_BLOCK ? payload - off : BIN_BLOCK;
+        hash = hash64(h + BIN_HEADER_SIZE + off, (size_t)n, hash);
+    }
+    if (hash64_mix(hash, hash64(h, 48, 0)) != get_le(h + 48, 8)) {
+        return TIMELINE_BIN_CHECKSUM;
+    }
+    return TIMELINE_BIN_OK;
+}
+
+const char *timeline_binary_status_name(TimelineBinaryStatus s)
+{
+    switch (s) {
+    case TIMELINE_BIN_OK:       return "ok";
+    case TIMELINE_BIN_IO:       return "cannot be read";
+    case TIMELINE_BIN_FORMAT:   return "not a supported timeline.bin";
+    case TIMELINE_BIN_CHECKSUM: return "checksum mismatch";
+    case TIMELINE_BIN_NOMEM:    return "out of memory";
+    }
+    return "unknown error";
+}
+
+TimelineBinaryStatus timeline_binary_open(
+    const char *path,
+    TimelineColumns *out
+)
+{
+    memset(out, 0, sizeof(*out));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return TIMELINE_BIN_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return TIMELINE_BIN_IO;
+    }
+    if (st.st_size < BIN_HEADER_SIZE) {
+        close(fd);
+        return TIMELINE_BIN_FORMAT;
+    }
+
+    size_t len = (size_t)st.st_size;
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return TIMELINE_BIN_IO;
+    }
+
+    const unsigned char *h = map;
+    uint64_t count, bytes[3], names[2];
+    TimelineBinaryStatus rc = check_header(h, len, &count, bytes, names);
+    if (rc != TIMELINE_BIN_OK) {
+        munmap(map, len);
+        return rc;
+    }
+
+    uint64_t flags = get_le(h + 12, 4);
+    const unsigned char *table = NULL, *name = NULL;
+    const unsigned char *info  = h + BIN_HEADER_SIZE;
+    if (flags & TIMELINE_BIN_NAMES) {
+        table = info + 16;
+        name  = table + names[0] * 8;
+        info  = name + names[1];
+    }
+    const unsigned char *ast  = info + bytes[0];
+    const unsigned char *step = ast + bytes[1];
+
+    out->count = (size_t)count;
+    out->step  = step;
+
+    /* Fixed-width, native order: the mapping is the columns */
+    if (!(flags & TIMELINE_BIN_VARINT) && host_is_le()) {
+        out->info    = (const uint64_t *)(const void *)info;
+        out->ast     = (const uint32_t *)(const void *)ast;
+        out->map     = map;
+        out->map_len = len;
+        if (flags & TIMELINE_BIN_NAMES) {
+            out->name       = (const uint32_t *)(const void *)name;
+            out->names      = (const uint64_t *)(const void *)table;
+            out->name_count = (size_t)names[0];
+            if (!names_in_table(out->name, out->count, names[0])) {
+                timeline_binary_close(out);
+                return TIMELINE_BIN_FORMAT;
+            }
+        }
+        return TIMELINE_BIN_OK;
+    }
+
+    /*
+     * Otherwise decode once (step stays byte-wide). The table is
+     * no larger than the file, so only the columns can overflow.
+     */
+    size_t k = (size_t)names[0];
+    size_t width = (flags & TIMELINE_BIN_NAMES) ? 17 : 13;
+    unsigned char *owned = count <= (SIZE_MAX - k * 8) / width
+                         ? malloc(k * 8 + count * width + 1) : NULL;
+    if (!owned) {
+        munmap(map, len);
+        return TIMELINE_BIN_NOMEM;
+    }
+    uint64_t *info_col  = (uint64_t *)(void *)owned;
+    uint64_t *table_col = info_col + count;
+    uint32_t *ast_col   = (uint32_t *)(void *)(table_col + k);
+    uint32_t *name_col  = ast_col + count;
+    uint8_t  *step_col  = (uint8_t *)(name_col + (k ? count : 0));
+    int ok = 1;
+
+    if (flags & TIMELINE_BIN_VARINT) {
+        ok = decode_varints(info, bytes[0], out->count, 8, info_col) &&
+             decode_varints(ast, bytes[1], out->count, 4, ast_col) &&
+             (!k || decode_varints(name, names[1], out->count, 4,
+                                   name_col));
+    } else {
+        decode_fixed(info, out->count, 8, info_col);
+        decode_fixed(ast, out->count, 4, ast_col);
+        if (k) {
+            decode_fixed(name, out->count, 4, name_col);
+        }
+    }
+    decode_fixed(table, k, 8, table_col);
+    ok = ok && (!k || names_in_table(name_col, out->count, k));
+    memcpy(step_col, step, out->count);
+    munmap(map, len);
+
+    if (!ok) {
+        free(owned);
+        return TIMELINE_BIN_FORMAT;
+    }
+
+    out->info  = info_col;
+    out->ast   = ast_col;
+    out->step  = step_col;
+    out->owned = owned;
+    if (k) {
+        out->name       = name_col;
+        out->names      = table_col;
+        out->name_count = k;
+    }
+    return TIMELINE_BIN_OK;
+}
+
+void timeline_binary_close(TimelineColumns *c)
+{
+    if (!c) {
+        return;
+    }
+    if (c->map) {
+        munmap(c->map, c->map_len);
+    }
+    free(c->owned);
+    memset(c, 0, sizeof(*c));
+}
+
+/* ------------------------------------------------------------
+ * Comparison
+ * ------------------------------------------------------------ */
+
+size_t timeline_columns_first_divergence(
+    const TimelineColumns *a,
+    const TimelineColumns *b
+)
+{
+    size_t n = a->count < b->count ? a->count : b->count;
+
+    for (size_t t = 0; t < n; t++) {
+        if (a->step[t] != b->step[t] || a->ast[t] != b->ast[t]) {
+            return t;
+        }
+    }
+    return a->count == b->count ? (size_t)-1 : n;
+}
@@ -0,0 +1,135 @@
+#ifndef LIMINAL_TIMELINE_BINARY_H
+#define LIMINAL_TIMELINE_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "./diff.h"
+
+struct Timeline;
+
+/*
+ * Timeline binary artifact (timeline.bin)
+ *
+ * The columns of a Timeline, for timelines too large for NDJSON.
+ * All integers are little-endian.
+ *
+ *   header (64 bytes)
+ *     0  magic      "LMNLTIME"
+ *     8  u32        version (1)
+ *    12  u32        flags (TIMELINE_BIN_*)
+ *    16  u64        count (entries; time is the index)
+ *    24  u64        info column bytes
+ *    32  u64        ast column bytes
+ *    40  u64        step column bytes
+ *    48  u64        checksum
+ *    56  u64        reserved (0)
+ *
+ *   names (only with TIMELINE_BIN_NAMES)
+ *      u64          table entries (k >= 1)
+ *      u64          name column bytes
+ *      name table   u64 per entry: spelling hash (intern_hash64)
+ *                   of symbol i; entry 0 is 0
+ *      name column  u32 per entry, an index into the table;
+ *                   zero-padded to a multiple of 8 bytes
+ *   info column     u64 per entry
+ *   ast column      u32 per entry (0 = no node)
+ *   step column     u8 per entry (StepKind)
+ *
+ * Columns are stored widest first, so in a mapped file each is
+ * naturally aligned. With TIMELINE_BIN_VARINT the name (unpadded),
+ * info and ast columns instead hold zigzag deltas from the
+ * previous entry as LEB128 varints (ids mostly move by small
+ * steps); the table and step column are unchanged.
+ *
+ * checksum = hash64_mix(P, hash64(header bytes 0..47, 0)), where P
+ * chains hash64 over the payload in 64 KiB blocks, seed 0 and then
+ * the previous block's hash. It is checked on open.
+ */
+
+#define TIMELINE_BIN_VERSION 1
+
+/* Delta + varint encoded name, info and ast columns */
+#define TIMELINE_BIN_VARINT  0x1u
+
+/* Name section present; set by the writer when `tl` has symbols */
+#define TIMELINE_BIN_NAMES   0x2u
+
+/*
+ * Write `tl` to `out`, which must be seekable: the header is
+ * written last. Returns 0 on write failure.
+ */
+int timeline_emit_binary(
+    const struct Timeline *tl,
+    FILE *out,
+    unsigned flags
+);
+
+/*
+ * TimelineColumns
+ *
+ * Read-only columns of a loaded timeline.bin. Fixed-width files
+ * are mapped and the columns point into the mapping; encoded ones
+ * are decoded once into owned memory. `name` is NULL for files
+ * written without names.
+ */
+typedef struct TimelineColumns {
+    size_t          count;
+    const uint64_t *info;
+    const uint32_t *ast;
+    const uint8_t  *step;
+    const uint32_t *name;       /* index into names */
+    const uint64_t *names;      /* name_count spelling hashes */
+    size_t          name_count;
+
+    /* Private */
+    void   *map;
+    size_t  map_len;
+    void   *owned;
+} TimelineColumns;
+
+typedef enum {
+    TIMELINE_BIN_OK = 0,
+    TIMELINE_BIN_IO,          /* open / stat / mmap failed */
+    TIMELINE_BIN_FORMAT,      /* not a (supported) timeline.bin */
+    TIMELINE_BIN_CHECKSUM,    /* contents do not match the header */
+    TIMELINE_BIN_NOMEM
+} TimelineBinaryStatus;
+
+/* Short description of `s`, for messages */
+const char *timeline_binary_status_name(TimelineBinaryStatus s);
+
+TimelineBinaryStatus timeline_binary_open(
+    const char *path,
+    TimelineColumns *out
+);
+
+void timeline_binary_close(TimelineColumns *c);
+
+/* Entry `t` in the form timeline_diff compares */
+static inline TimelineStepView timeline_columns_step(
+    const TimelineColumns *c,
+    size_t t
+)
+{
+    TimelineStepView v = {
+        .time      = t,
+        .step_kind = c->step[t],
+        .ast_id    = c->ast[t],
+        .name      = c->name ? c->names[c->name[t]] : 0
+    };
+    return v;
+}
+
+/*
+ * First time index at which `a` and `b` differ in step or ast
+ * (the timeline.ndjson fields), or (size_t)-1 if they agree.
+ * Same answer as timeline_diff_first_line on the NDJSON files.
+ */
+size_t timeline_columns_first_divergence(
+    const TimelineColumns *a,
+    const TimelineColumns *b
+);
+
+#endif /* LIMINAL_TIMELINE_BINARY_H */
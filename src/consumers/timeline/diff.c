@@ -1,6 +1,578 @@
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "./diff.h"
+#include "./binary.h"
+#include "common/common.h"
+
+/*
+ * Edit scripts longer than this are not traced (the trace holds
+ * (D+1)² entries, 16 MiB here); those diffs are redone in linear
+ * space instead.
+ */
+#define TRACE_MAX_D 2047
+
+/*
+ * A split whose search passes this many edits settles for the
+ * furthest-reaching path instead of the middle snake (GNU diff's
+ * "too expensive" cut): large rewrites cost O((N + M) * this)
+ * rather than O(N * D), and the alignment stays valid but may be
+ * a little longer than the shortest.
+ */
+#define BISECT_MAX_D 4096
+
+/* ---- SIDES ---- */
+
+/*
+ * What alignment compares. AST ids are positions: one inserted
+ * declaration renumbers every later node, so when both runs carry
+ * names, steps match on kind and name alone; which of several
+ * same-keyed steps pairs up is left to the alignment. Runs without
+ * names fall back to kind and AST id.
+ */
+static inline uint64_t step_key(const TimelineStepView *s, int named)
+{
+    return named ? hash64_mix(s->name, s->step_kind)
+                 : (uint64_t)s->step_kind << 32 | s->ast_id;
+}
+
+/* One input: its keys, and where whole steps come from */
+typedef struct DiffSide {
+    uint64_t *key;
+    const TimelineStepView *steps;     /* NULL: read `cols` */
+    const TimelineColumns *cols;
+} DiffSide;
+
+static TimelineStepView side_step(const DiffSide *s, size_t i)
+{
+    return s->steps ? s->steps[i] : timeline_columns_step(s->cols, i);
+}
+
+/* ---- HUNKS ---- */
+
+typedef struct IndexQueue {
+    size_t *at;
+    size_t len;
+    size_t cap;
+} IndexQueue;
+
+/*
+ * Receives the edit script in order and turns each hunk into
+ * TimelineDiff entries. (x, y) is the position just past the
+ * last edit; an edit anywhere else means matching steps came
+ * between, closing the open hunk.
+ */
+typedef struct DiffSink {
+    const DiffSide *a;
+    const DiffSide *b;
+    TimelineDiff *out;
+    size_t cap;
+    size_t total;
+
+    size_t x;
+    size_t y;
+    IndexQueue del;
+    IndexQueue ins;
+    int nomem;
+} DiffSink;
+
+static void queue_push(DiffSink *s, IndexQueue *q, size_t v)
+{
+    if (q->len == q->cap) {
+        size_t cap = q->cap ? q->cap * 2 : 64;
+        size_t *at = realloc(q->at, cap * sizeof(*at));
+        if (!at) {
+            s->nomem = 1;
+            return;
+        }
+        q->at = at;
+        q->cap = cap;
+    }
+    q->at[q->len++] = v;
+}
+
+static void sink_put(DiffSink *s, TimelineDiffKind kind,
+                     const size_t *i, const size_t *j)
+{
+    if (s->total < s->cap) {
+        TimelineDiff *d = &s->out[s->total];
+        memset(d, 0, sizeof(*d));
+        d->kind = kind;
+        if (i) d->before = side_step(s->a, *i);
+        if (j) d->after = side_step(s->b, *j);
+        d->time = i ? d->before.time : d->after.time;
+    }
+    s->total++;
+}
+
+static void sink_flush(DiffSink *s)
+{
+    size_t nd = s->del.len;
+    size_t ni = s->ins.len;
+    size_t pairs = nd < ni ? nd : ni;
+
+    for (size_t k = 0; k < pairs; k++) {
+        sink_put(s, TIMELINE_DIFF_CHANGED, &s->del.at[k], &s->ins.at[k]);
+    }
+    for (size_t k = pairs; k < nd; k++) {
+        sink_put(s, TIMELINE_DIFF_REMOVED, &s->del.at[k], NULL);
+    }
+    for (size_t k = pairs; k < ni; k++) {
+        sink_put(s, TIMELINE_DIFF_ADDED, NULL, &s->ins.at[k]);
+    }
+
+    s->del.len = 0;
+    s->ins.len = 0;
+}
+
+/* Old step `i` has no counterpart */
+static void sink_delete(DiffSink *s, size_t i)
+{
+    if (i != s->x) {
+        sink_flush(s);
+    }
+    queue_push(s, &s->del, i);
+    s->x = i + 1;
+}
+
+/* New step `j` has no counterpart */
+static void sink_insert(DiffSink *s, size_t j)
+{
+    if (j != s->y) {
+        sink_flush(s);
+    }
+    queue_push(s, &s->ins, j);
+    s->y = j + 1;
+}
+
+/* ---- TRACED (O(D²) space) ---- */
+
+/*
+ * Myers' greedy forward search, keeping row d of V for every
+ * d so the path can be walked back. Returns 0 without emitting
+ * anything when the edit distance exceeds TRACE_MAX_D.
+ */
+static int diff_traced(DiffSink *s,
+                       const uint64_t *a, int32_t n, size_t base_a,
+                       const uint64_t *b, int32_t m, size_t base_b)
+{
+    int32_t lim = n + m < TRACE_MAX_D ? n + m : TRACE_MAX_D;
+    int32_t off = lim + 1;
+    int32_t *v = malloc(((size_t)lim * 2 + 3) * sizeof(*v));
+    int32_t *trace = NULL;
+    size_t trace_cap = 0;
+    int32_t found = -1;
+
+    if (!v) {
+        s->nomem = 1;
+        return 1;
+    }
+    v[off + 1] = 0;
+
+    for (int32_t d = 0; d <= lim && found < 0; d++) {
+        for (int32_t k = -d; k <= d; k += 2) {
+            int32_t x = (k == -d || (k != d && v[off + k - 1] < v[off + k + 1]))
+                      ? v[off + k + 1]
+                      : v[off + k - 1] + 1;
+            int32_t y = x - k;
+
+            while (x < n && y < m && a[x] == b[y]) {
+                x++;
+                y++;
+            }
+            v[off + k] = x;
+
+            if (x >= n && y >= m) {
+                found = d;
+                break;
+            }
+        }
+
+        /* Row d lives at d², entry k at d² + k + d */
+        size_t need = (size_t)(d + 1) * (size_t)(d + 1);
+        if (need > trace_cap) {
+            size_t cap = trace_cap ? trace_cap * 2 : 1024;
+            while (cap < need) cap *= 2;
+            int32_t *t = realloc(trace, cap * sizeof(*t));
+            if (!t) {
+                s->nomem = 1;
+                free(trace);
+                free(v);
+                return 1;
+            }
+            trace = t;
+            trace_cap = cap;
+        }
+        memcpy(trace + (size_t)d * (size_t)d, v + off - d,
+               ((size_t)d * 2 + 1) * sizeof(*v));
+    }
+    free(v);
+
+    if (found < 0) {
+        free(trace);
+        return 0;
+    }
+
+    /* Walk back; edit d is stored at ops[d - 1], >= 0 deletes a[op] */
+    int32_t *ops = malloc(((size_t)found + 1) * sizeof(*ops));
+    if (!ops) {
+        s->nomem = 1;
+        free(trace);
+        return 1;
+    }
+
+    int32_t x = n, y = m;
+    for (int32_t d = found; d > 0; d--) {
+        const int32_t *row = trace + (size_t)(d - 1) * (size_t)(d - 1) + (d - 1);
+        int32_t k = x - y;
+        int down = k == -d || (k != d && row[k - 1] < row[k + 1]);
+        int32_t pk = down ? k + 1 : k - 1;
+        int32_t px = row[pk];
+        int32_t py = px - pk;
+
+        ops[d - 1] = down ? ~py : px;
+        x = px;
+        y = py;
+    }
+    free(trace);
+
+    for (int32_t d = 0; d < found; d++) {
+        if (ops[d] >= 0) {
+            sink_delete(s, base_a + (size_t)ops[d]);
+        } else {
+            sink_insert(s, base_b + (size_t)~ops[d]);
+        }
+    }
+    free(ops);
+    return 1;
+}
+
+/* ---- LINEAR SPACE ---- */
+
+/*
+ * Middle snake: run the forward and reverse searches together
+ * until they overlap, and return that point in (*sx, *sy).
+ * Either half then has at most half the edits. v1 / v2 hold at
+ * least n + m + 2 entries; only the band reached so far is
+ * initialized, so a split costs O(D) setup, not O(n + m).
+ * Past BISECT_MAX_D the split is the furthest point either
+ * search reached.
+ */
+static int bisect(const uint64_t *a, int32_t n,
+                  const uint64_t *b, int32_t m,
+                  int32_t *v1, int32_t *v2,
+                  int32_t *sx, int32_t *sy)
+{
+    int32_t max_d = (n + m + 1) / 2;
+    int32_t off = max_d;
+    int32_t delta = n - m;
+    int front = delta & 1;
+    int32_t k1start = 0, k1end = 0, k2start = 0, k2end = 0;
+    int32_t win = -1;
+
+    for (int32_t d = 0; d < max_d; d++) {
+        /* Furthest x + y of this round, forward and from the end */
+        int32_t best_f = -1, fx = 0, fy = 0;
+        int32_t best_r = -1, rx = 0, ry = 0;
+
+        while (win < d + 1) {
+            win++;
+            v1[off + win] = v1[off - win] = -1;
+            v2[off + win] = v2[off - win] = -1;
+        }
+        if (d == 0) {
+            v1[off + 1] = 0;
+            v2[off + 1] = 0;
+        }
+
+        for (int32_t k1 = -d + k1start; k1 <= d - k1end; k1 += 2) {
+            int32_t ko = off + k1;
+            int32_t x1 = (k1 == -d || (k1 != d && v1[ko - 1] < v1[ko + 1]))
+                       ? v1[ko + 1]
+                       : v1[ko - 1] + 1;
+            int32_t y1 = x1 - k1;
+
+            while (x1 < n && y1 < m && a[x1] == b[y1]) {
+                x1++;
+                y1++;
+            }
+            v1[ko] = x1;
+
+            if (x1 > n) {
+                k1end += 2;
+            } else if (y1 > m) {
+                k1start += 2;
+            } else {
+                if (x1 + y1 > best_f) {
+                    best_f = x1 + y1;
+                    fx = x1;
+                    fy = y1;
+                }
+                if (!front) {
+                    continue;
+                }
+                int32_t k2o = off + delta - k1;
+                if (k2o >= off - win && k2o <= off + win && v2[k2o] != -1 &&
+                    x1 >= n - v2[k2o]) {
+                    *sx = x1;
+                    *sy = y1;
+                    return 1;
+                }
+            }
+        }
+
+        for (int32_t k2 = -d + k2start; k2 <= d - k2end; k2 += 2) {
+            int32_t ko = off + k2;
+            int32_t x2 = (k2 == -d || (k2 != d && v2[ko - 1] < v2[ko + 1]))
+                       ? v2[ko + 1]
+                       : v2[ko - 1] + 1;
+            int32_t y2 = x2 - k2;
+
+            while (x2 < n && y2 < m && a[n - x2 - 1] == b[m - y2 - 1]) {
+                x2++;
+                y2++;
+            }
+            v2[ko] = x2;
+
+            if (x2 > n) {
+                k2end += 2;
+            } else if (y2 > m) {
+                k2start += 2;
+            } else {
+                if (x2 + y2 > best_r) {
+                    best_r = x2 + y2;
+                    rx = n - x2;
+                    ry = m - y2;
+                }
+                if (front) {
+                    continue;
+                }
+                int32_t k1o = off + delta - k2;
+                if (k1o >= off - win && k1o <= off + win && v1[k1o] != -1 &&
+                    v1[k1o] >= n - x2) {
+                    *sx = v1[k1o];
+                    *sy = off + v1[k1o] - k1o;
+                    return 1;
+                }
+            }
+        }
+
+        if (d + 1 >= BISECT_MAX_D) {
+            if (best_f >= best_r) {
+                *sx = fx;
+                *sy = fy;
+            } else {
+                *sx = rx;
+                *sy = ry;
+            }
+            /* Either half must be smaller than the whole */
+            return (*sx || *sy) && (*sx != n || *sy != m);
+        }
+    }
+    return 0;
+}
+
+static void diff_linear(DiffSink *s,
+                        const uint64_t *a, size_t a_lo, size_t a_hi,
+                        const uint64_t *b, size_t b_lo, size_t b_hi,
+                        int32_t *v1, int32_t *v2)
+{
+    while (a_lo < a_hi && b_lo < b_hi && a[a_lo] == b[b_lo]) {
+        a_lo++;
+        b_lo++;
+    }
+    while (a_lo < a_hi && b_lo < b_hi && a[a_hi - 1] == b[b_hi - 1]) {
+        a_hi--;
+        b_hi--;
+    }
+
+    int32_t sx, sy;
+    if (a_lo == a_hi || b_lo == b_hi ||
+        !bisect(a + a_lo, (int32_t)(a_hi - a_lo),
+                b + b_lo, (int32_t)(b_hi - b_lo), v1, v2, &sx, &sy)) {
+        /* Nothing in common */
+        for (size_t i = a_lo; i < a_hi; i++) sink_delete(s, i);
+        for (size_t j = b_lo; j < b_hi; j++) sink_insert(s, j);
+        return;
+    }
+
+    diff_linear(s, a, a_lo, a_lo + (size_t)sx, b, b_lo, b_lo + (size_t)sy,
+                v1, v2);
+    diff_linear(s, a, a_lo + (size_t)sx, a_hi, b, b_lo + (size_t)sy, b_hi,
+                v1, v2);
+}
+
+/* ---- DRIVER ---- */
+
+static size_t diff_run(const DiffSide *a, size_t n,
+                       const DiffSide *b, size_t m,
+                       TimelineDiff *out, size_t cap,
+                       int linear_only)
+{
+    /* Diagonal arithmetic is int32 */
+    if (n + m >= INT32_MAX - 2) {
+        return TIMELINE_DIFF_NOMEM;
+    }
+
+    DiffSink s = { .a = a, .b = b, .out = out, .cap = cap };
+
+    /* Common head and tail never reach the search */
+    size_t pre = 0;
+    while (pre < n && pre < m && a->key[pre] == b->key[pre]) {
+        pre++;
+    }
+    size_t suf = 0;
+    while (suf < n - pre && suf < m - pre &&
+           a->key[n - 1 - suf] == b->key[m - 1 - suf]) {
+        suf++;
+    }
+
+    size_t an = n - pre - suf;
+    size_t bm = m - pre - suf;
+    s.x = s.y = pre;
+
+    int done = an == 0 && bm == 0;
+    if (!done && !linear_only) {
+        done = diff_traced(&s, a->key + pre, (int32_t)an, pre,
+                           b->key + pre, (int32_t)bm, pre);
+    }
+    if (!done) {
+        int32_t *v1 = malloc((an + bm + 3) * sizeof(*v1));
+        int32_t *v2 = malloc((an + bm + 3) * sizeof(*v2));
+        if (v1 && v2) {
+            diff_linear(&s, a->key, pre, pre + an, b->key, pre, pre + bm,
+                        v1, v2);
+        } else {
+            s.nomem = 1;
+        }
+        free(v1);
+        free(v2);
+    }
+
+    sink_flush(&s);
+    free(s.del.at);
+    free(s.ins.at);
+    return s.nomem ? TIMELINE_DIFF_NOMEM : s.total;
+}
+
+/* Loaded NDJSON has names unless it predates them (all 0) */
+static int steps_named(const TimelineStepView *steps, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (steps[i].name) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int side_from_steps(DiffSide *side,
+                           const TimelineStepView *steps, size_t count,
+                           int named)
+{
+    side->steps = steps;
+    side->cols = NULL;
+    side->key = malloc((count ? count : 1) * sizeof(*side->key));
+    if (!side->key) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        side->key[i] = step_key(&steps[i], named);
+    }
+    return 1;
+}
+
+static size_t diff_steps(const TimelineStepView *old_steps, size_t old_count,
+                         const TimelineStepView *new_steps, size_t new_count,
+                         TimelineDiff *out, size_t cap, int linear_only)
+{
+    DiffSide a, b;
+    size_t total = TIMELINE_DIFF_NOMEM;
+    int named = steps_named(old_steps, old_count) &&
+                steps_named(new_steps, new_count);
+
+    int ok = side_from_steps(&a, old_steps, old_count, named);
+    ok = side_from_steps(&b, new_steps, new_count, named) && ok;
+    if (ok) {
+        total = diff_run(&a, old_count, &b, new_count, out, cap,
+                         linear_only);
+    }
+
+    free(a.key);
+    free(b.key);
+    return total;
+}
+
+size_t timeline_diff(
+    const TimelineStepView *old_steps,
+    size_t old_count,
+    const TimelineStepView *new_steps,
+    size_t new_count,
+    TimelineDiff *out,
+    size_t cap
+)
+{
+    return diff_steps(old_steps, old_count, new_steps, new_count,
+                      out, cap, 0);
+}
+
+size_t timeline_diff_linear(
+    const TimelineStepView *old_steps,
+    size_t old_count,
+    const TimelineStepView *new_steps,
+    size_t new_count,
+    TimelineDiff *out,
+    size_t cap
+)
+{
+    return diff_steps(old_steps, old_count, new_steps, new_count,
+                      out, cap, 1);
+}
+
+static int side_from_columns(DiffSide *side, const TimelineColumns *c,
+                             int named)
+{
+    side->steps = NULL;
+    side->cols = c;
+    side->key = malloc((c->count ? c->count : 1) * sizeof(*side->key));
+    if (!side->key) {
+        return 0;
+    }
+    for (size_t i = 0; i < c->count; i++) {
+        TimelineStepView s = timeline_columns_step(c, i);
+        side->key[i] = step_key(&s, named);
+    }
+    return 1;
+}
+
+size_t timeline_diff_columns(
+    const TimelineColumns *old_cols,
+    const TimelineColumns *new_cols,
+    TimelineDiff *out,
+    size_t cap
+)
+{
+    DiffSide a, b;
+    size_t total = TIMELINE_DIFF_NOMEM;
+
+    int named = old_cols->name && new_cols->name;
+
+    int ok = side_from_columns(&a, old_cols, named);
+    ok = side_from_columns(&b, new_cols, named) && ok;
+    if (ok) {
+        total = diff_run(&a, old_cols->count, &b, new_cols->count,
+                         out, cap, 0);
+    }
+
+    free(a.key);
+    free(b.key);
+    return total;
+}
+
+/* ---- FIRST LINE ---- */
+
 size_t timeline_diff_first_line(
     FILE *a,
     FILE *b
@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "./event.h"
+
 /*
  * TimelineDiffKind
  *
@@ -21,13 +23,10 @@ typedef enum {
  * TimelineStepView
  *
  * Minimal, normalized view of a timeline step.
- * Mirrors timeline.ndjson fields exactly.
+ * Mirrors timeline.ndjson fields exactly, so loaded events
+ * (TimelineEvent) are compared in place.
  */
-typedef struct {
-    uint64_t time;
-    uint32_t step_kind;
-    uint32_t ast_id;
-} TimelineStepView;
+typedef TimelineEvent TimelineStepView;
 
 /*
  * TimelineDiff
@@ -36,8 +35,8 @@ typedef struct {
  *
  * Invariants:
  *  - Deterministic
- *  - No allocation
- *  - One entry per divergent time index
+ *  - REMOVED carries `before`, ADDED `after`, CHANGED both
+ *  - `time` is before.time, or after.time for ADDED
  */
 typedef struct {
     TimelineDiffKind kind;
@@ -48,19 +47,30 @@ typedef struct {
     TimelineStepView after;
 } TimelineDiff;
 
+/* Returned by the timeline_diff family when memory runs out */
+#define TIMELINE_DIFF_NOMEM ((size_t)-1)
+
 /*
  * timeline_diff
  *
- * Compare two normalized timeline streams.
+ * Align two normalized timeline streams and report the steps
+ * that do not line up (Myers' O(ND) shortest edit script).
  *
  * Rules:
- *  - Comparison is by `time` index
- *  - No sorting
- *  - No allocation
+ *  - Steps match on (step_kind, name) when both runs carry names,
+ *    else on (step_kind, ast_id); `time` and (with names) AST ids
+ *    are ignored, so inserted code does not shift every later step
+ *  - Each hunk (run of edits between matching steps) pairs its
+ *    removals with its additions in order as CHANGED; the
+ *    surplus is REMOVED or ADDED
+ *  - Small edit distances keep the O(D²) trace; larger ones
+ *    switch to the linear-space middle-snake refinement
  *  - Deterministic output
  *
  * Returns:
- *  - Number of diff entries written to `out`
+ *  - Number of entries in the full diff; only the first `cap`
+ *    are written to `out` (0 when the streams align)
+ *  - TIMELINE_DIFF_NOMEM on allocation failure
  */
 size_t timeline_diff(
     const TimelineStepView *old_steps,
@@ -71,6 +81,39 @@ size_t timeline_diff(
     size_t cap
 );
 
+/* timeline_diff, always in linear space */
+size_t timeline_diff_linear(
+    const TimelineStepView *old_steps,
+    size_t old_count,
+    const TimelineStepView *new_steps,
+    size_t new_count,
+    TimelineDiff *out,
+    size_t cap
+);
+
+struct TimelineColumns;
+
+/* timeline_diff over two mapped timeline.bin files */
+size_t timeline_diff_columns(
+    const struct TimelineColumns *old_cols,
+    const struct TimelineColumns *new_cols,
+    TimelineDiff *out,
+    size_t cap
+);
+
+/*
+ * timeline_diff_render
+ *
+ * One line per entry; `total` is what timeline_diff returned,
+ * so a truncated diff says how much was left out.
+ */
+void timeline_diff_render(
+    const TimelineDiff *diffs,
+    size_t count,
+    size_t total,
+    FILE *out
+);
+
 /*
  * timeline_diff_first_line
  *
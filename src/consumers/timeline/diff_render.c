@@ -0,0 +1,69 @@
+#include <stdio.h>
+
+#include "./diff.h"
+#include "executor/executor.h"
+
+static const char *kind_str(TimelineDiffKind k)
+{
+    switch (k) {
+    case TIMELINE_DIFF_ADDED:     return "ADDED";
+    case TIMELINE_DIFF_REMOVED:   return "REMOVED";
+    case TIMELINE_DIFF_CHANGED:   return "CHANGED";
+    case TIMELINE_DIFF_UNCHANGED: return "UNCHANGED";
+    default:                      return "UNKNOWN";
+    }
+}
+
+/* "t=12 declare #5" into buf, or "-" when the side is absent */
+static const char *step_str(char *buf, size_t len,
+                            const TimelineStepView *s, int present)
+{
+    if (!present) {
+        return "-";
+    }
+    snprintf(buf, len, "t=%llu %s #%u",
+             (unsigned long long)s->time,
+             step_kind_name((StepKind)s->step_kind),
+             s->ast_id);
+    return buf;
+}
+
+void timeline_diff_render(
+    const TimelineDiff *diffs,
+    size_t count,
+    size_t total,
+    FILE *out
+)
+{
+    char before[64];
+    char after[64];
+
+    fprintf(out,
+        "%-10s %-28s %-28s\n",
+        "TIMELINE", "OLD", "NEW"
+    );
+    fprintf(out,
+        "%-10s %-28s %-28s\n",
+        "----------",
+        "----------------------------",
+        "----------------------------"
+    );
+
+    for (size_t i = 0; i < count; i++) {
+        const TimelineDiff *d = &diffs[i];
+
+        fprintf(
+            out,
+            "%-10s %-28s %-28s\n",
+            kind_str(d->kind),
+            step_str(before, sizeof(before), &d->before,
+                     d->kind != TIMELINE_DIFF_ADDED),
+            step_str(after, sizeof(after), &d->after,
+                     d->kind != TIMELINE_DIFF_REMOVED)
+        );
+    }
+
+    if (total > count) {
+        fprintf(out, "... %zu more\n", total - count);
+    }
+}
@@ -3,52 +3,60 @@
 
 #include "consumers/consumers.h"
 #include "executor/executor.h"
-#include "frontends/frontends.h"   /* for ASTNode */    
+#include "frontends/frontends.h"   /* for ASTNode */
+#include "common/common.h"
 
 /*
  * Timeline NDJSON — Stage 7 canonical artifact
  *
  * Contract:
- *  - One line per World
+ *  - One line per timeline entry
  *  - Deterministic
  *  - No executor pointers
  *  - No formatting variance
  *  - Stable across runs
  *
  * Schema v1:
- * { "v":1, "t":<uint64>, "step":"<name>", "ast":<uint32> }
+ * { "v":1, "t":<uint64>, "step":"<name>", "ast":<uint32>,
+ *   "name":"<hex16>" }
+ *
+ * "name" (timeline_name_at) is left out when the step names
+ * nothing.
  */
 void timeline_emit_ndjson(
-    const struct World *head,
+    const struct Timeline *tl,
     FILE *out
 )
 {
-    const struct World *w = head;
+    JsonWriter w;
+    json_writer_init(&w, out);
 
-    while (w) {
+    for (size_t t = 0; tl && t < tl->count; t++) {
         uint32_t ast_id = 0;
-        const char *step_name = "UNKNOWN";
-
-        if (w->step) {
-            step_name = step_kind_name(w->step->kind);
+        const char *step_name = step_kind_name(timeline_kind(tl, t));
 
-            if (w->step->origin) {
-                const ASTNode *n =
-                    (const ASTNode *)w->step->origin;
-                ast_id = n->id;
-            }
+        const ASTNode *n = (const ASTNode *)timeline_origin(tl, t);
+        if (n) {
+            ast_id = n->id;
         }
 
-        fprintf(
-            out,
-            "{\"v\":1,\"t\":%llu,\"step\":\"%s\",\"ast\":%u}\n",
-            (unsigned long long)w->time,
-            step_name,
-            ast_id
-        );
+        json_write_lit(&w, "{\"v\":1,\"t\":");
+        json_write_u64(&w, t);
+        json_write_lit(&w, ",\"step\":\"");
+        json_write_cstr(&w, step_name);
+        json_write_lit(&w, "\",\"ast\":");
+        json_write_u64(&w, ast_id);
 
-        w = w->next;
+        uint64_t name = timeline_name_at(tl, t);
+        if (name) {
+            json_write_lit(&w, ",\"name\":\"");
+            json_write_hex64(&w, name);
+            json_write_lit(&w, "\"");
+        }
+        json_write_lit(&w, "}\n");
     }
+
+    json_writer_flush(&w);
 }
 
 /*
@@ -58,28 +66,24 @@ void timeline_emit_ndjson(
  * NOT used for diffing or artifacts.
  */
 void emit_timeline(
-    const struct World *head,
+    const struct Timeline *tl,
     FILE *out
 )
 {
-    const struct World *w = head;
-
-    while (w) {
+    for (size_t t = 0; tl && t < tl->count; t++) {
         uint32_t ast_id = 0;
 
-        if (w->step && w->step->origin) {
-            const ASTNode *n = (const ASTNode *)w->step->origin;
+        const ASTNode *n = (const ASTNode *)timeline_origin(tl, t);
+        if (n) {
             ast_id = n->id;
         }
 
         fprintf(
             out,
             "t=%llu step=%d ast=%u\n",
-            (unsigned long long)w->time,
-            w->step ? w->step->kind : 0,
+            (unsigned long long)t,
+            (int)timeline_kind(tl, t),
             ast_id
         );
-
-        w = w->next;
     }
 }
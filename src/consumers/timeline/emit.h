@@ -3,17 +3,17 @@
 
 #include <stdio.h>
 
-struct World;
+struct Timeline;
 
 /* Human / tool readable timeline */
 void emit_timeline(
-    const struct World *head,
+    const struct Timeline *tl,
     FILE *out
 );
 
 /* NDJSON artifact timeline */
 void timeline_emit_ndjson(
-    const struct World *head,
+    const struct Timeline *tl,
     FILE *out
 );
 
@@ -7,6 +7,10 @@ typedef struct TimelineEvent {
     uint64_t time;
     uint32_t step_kind;
     uint32_t ast_id;
+
+    /* Spelling hash (intern_hash64) of the variable or function
+     * the step is about; 0 if none, or if the artifact predates it */
+    uint64_t name;
 } TimelineEvent;
 
 #endif /* LIMINAL_TIMELINE_EVENT_H */
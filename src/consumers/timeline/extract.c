@@ -2,29 +2,49 @@
 #include "executor/executor.h"
 #include "frontends/frontends.h"   /* for ASTNode */
 
+Symbol timeline_symbol_at(const struct Timeline *tl, size_t t)
+{
+    const ASTNode *n = (const ASTNode *)timeline_origin(tl, t);
+    if (!n) {
+        return SYMBOL_NONE;
+    }
+
+    switch (n->kind) {
+    case AST_VAR_DECL: return n->as.vdecl.name;
+    case AST_VAR_USE:  return n->as.vuse.name;
+    case AST_FUNCTION: return n->as.fn.name;
+    default:           return SYMBOL_NONE;
+    }
+}
+
+uint64_t timeline_name_at(const struct Timeline *tl, size_t t)
+{
+    return intern_hash64(tl->symbols, timeline_symbol_at(tl, t));
+}
+
 size_t timeline_extract(
-    const struct World *head,
+    const struct Timeline *tl,
     TimelineEvent *out,
     size_t cap
 )
 {
     size_t count = 0;
-    const struct World *w = head;
 
-    while (w && count < cap) {
+    while (tl && count < tl->count && count < cap) {
         uint32_t ast_id = 0;
-        if (w->step && w->step->origin) {
-            const ASTNode *n = (const ASTNode *)w->step->origin;
+        const ASTNode *n = (const ASTNode *)timeline_origin(tl, count);
+        if (n) {
             ast_id = n->id;
         }
 
-        out[count++] = (TimelineEvent){
-            .time = w->time,
-            .step_kind = w->step ? w->step->kind : 0,
-            .ast_id = ast_id
+        out[count] = (TimelineEvent){
+            .time = count,
+            .step_kind = timeline_kind(tl, count),
+            .ast_id = ast_id,
+            .name = timeline_name_at(tl, count)
         };
 
-        w = w->next;
+        count++;
     }
 
     return count;
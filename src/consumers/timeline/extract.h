@@ -5,8 +5,22 @@
 #include "../../executor/executor.h"
 #include "./event.h"
 
+/*
+ * The name entry `t` is about: the variable of a DECLARE or USE,
+ * the function of its ENTER/EXIT steps and of its outermost scope.
+ * SYMBOL_NONE for anything else.
+ */
+Symbol timeline_symbol_at(const struct Timeline *tl, size_t t);
+
+/*
+ * Spelling hash (intern_hash64 over tl->symbols) of that name, or
+ * 0. Unlike the AST id it does not move when code is added
+ * elsewhere, and unlike the symbol it means the same in any run.
+ */
+uint64_t timeline_name_at(const struct Timeline *tl, size_t t);
+
 size_t timeline_extract(
-    const struct World *head,
+    const struct Timeline *tl,
     TimelineEvent *out,
     size_t cap
 );
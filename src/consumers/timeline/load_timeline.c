@@ -1,43 +1,158 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-typedef struct TimelineEvent {
-    unsigned long time;
-    int step;
-    unsigned int ast;
-} TimelineEvent;
+#include "consumers/consumers.h"
+#include "executor/executor.h"
+#include "common/common.h"
 
-int load_timeline(const char *path,
-                  TimelineEvent **out,
-                  size_t *out_count)
+static int read_step(JsonReader *r, uint32_t *out)
+{
+    if (json_peek(r) == '"') {
+        JsonStr s;
+        if (!json_read_string(r, &s)) {
+            return 0;
+        }
+        for (int k = STEP_UNKNOWN; k <= STEP_OTHER; k++) {
+            if (json_str_eq(s, step_kind_name((StepKind)k))) {
+                *out = (uint32_t)k;
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    uint64_t v;
+    if (!json_read_u64(r, &v) || v > STEP_OTHER) {
+        return 0;
+    }
+    *out = (uint32_t)v;
+    return 1;
+}
+
+int timeline_parse_json(const char *line, size_t len, TimelineEvent *out)
+{
+    enum { HAVE_TIME = 1, HAVE_STEP = 2 };
+    unsigned have = 0;
+    JsonReader r;
+    JsonStr key;
+    uint64_t v;
+
+    memset(out, 0, sizeof(*out));
+
+    json_reader_init(&r, line, len);
+    if (!json_object_begin(&r)) {
+        return 0;
+    }
+
+    while (json_object_next(&r, &key)) {
+        int ok;
+        if (json_str_eq(key, "t") || json_str_eq(key, "time")) {
+            ok = json_read_u64(&r, &out->time);
+            have |= HAVE_TIME;
+        } else if (json_str_eq(key, "step")) {
+            ok = read_step(&r, &out->step_kind);
+            have |= HAVE_STEP;
+        } else if (json_str_eq(key, "ast")) {
+            ok = json_read_u64(&r, &v) && v <= UINT32_MAX;
+            out->ast_id = (uint32_t)v;
+        } else if (json_str_eq(key, "name")) {
+            ok = json_read_hex64(&r, &out->name);
+        } else if (json_str_eq(key, "v")) {
+            ok = json_read_u64(&r, &v) && v == 1;
+        } else {
+            ok = json_skip(&r);
+        }
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    return !r.error && json_at_end(&r) && have == (HAVE_TIME | HAVE_STEP);
+}
+
+int timeline_read_ndjson(
+    FILE *in,
+    TimelineEventSink fn,
+    void *ctx,
+    size_t *line_no
+)
+{
+    NdjsonReader r;
+    const char *line;
+    size_t len;
+    int rc = 0;
+
+    ndjson_reader_init(&r, in);
+
+    while (ndjson_next_line(&r, &line, &len)) {
+        TimelineEvent e;
+        if (!timeline_parse_json(line, len, &e)) {
+            rc = 1;
+            break;
+        }
+        if (!fn(&e, ctx)) {
+            break;
+        }
+    }
+
+    if (rc == 0 && r.error) {
+        rc = 2;
+    }
+    if (line_no) {
+        *line_no = r.line_no;
+    }
+    ndjson_reader_free(&r);
+    return rc;
+}
+
+typedef struct LoadState {
+    TimelineEvent *items;
+    size_t         count;
+    size_t         cap;
+    int            nomem;
+} LoadState;
+
+static int collect(const TimelineEvent *e, void *ctx)
+{
+    LoadState *s = ctx;
+
+    if (s->count == s->cap) {
+        size_t ncap = s->cap ? s->cap * 2 : 1024;
+        TimelineEvent *np = realloc(s->items, ncap * sizeof(*np));
+        if (!np) {
+            s->nomem = 1;
+            return 0;
+        }
+        s->items = np;
+        s->cap = ncap;
+    }
+    s->items[s->count++] = *e;
+    return 1;
+}
+
+int load_timeline(const char *path, TimelineEvent **out, size_t *out_count)
 {
     if (!path || !out || !out_count)
         return 1;
 
+    *out = NULL;
+    *out_count = 0;
+
     FILE *f = fopen(path, "r");
     if (!f)
         return 2;
 
-    TimelineEvent *buf = calloc(256, sizeof(TimelineEvent));
-    size_t count = 0;
+    LoadState s = {0};
+    int rc = timeline_read_ndjson(f, collect, &s, NULL);
+    fclose(f);
 
-    while (count < 256) {
-        TimelineEvent e;
-        int n = fscanf(
-            f,
-            "{\"time\":%lu,\"step\":%d,\"ast\":%u}\n",
-            &e.time,
-            &e.step,
-            &e.ast
-        );
-        if (n != 3)
-            break;
-        buf[count++] = e;
+    if (rc != 0 || s.nomem) {
+        free(s.items);
+        return rc == 1 ? 3 : 4;
     }
 
-    fclose(f);
-
-    *out = buf;
-    *out_count = count;
+    *out = s.items;
+    *out_count = s.count;
     return 0;
 }
@@ -0,0 +1,49 @@
+#ifndef LIMINAL_TIMELINE_LOAD_H
+#define LIMINAL_TIMELINE_LOAD_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "./event.h"
+
+/*
+ * Parse one timeline.ndjson record:
+ *
+ *   {"v":1,"t":<time>,"step":"<name>","ast":<id>,"name":"<hex16>"}
+ *
+ * Members may come in any order; unknown ones are skipped. The
+ * older {"time":N,"step":<number>,"ast":N} form is accepted too.
+ * "t" (or "time") and "step" are required, "ast" and "name"
+ * default to 0.
+ *
+ * Returns 1 on success, 0 on a malformed record.
+ */
+int timeline_parse_json(const char *line, size_t len, TimelineEvent *out);
+
+/*
+ * Stream every record of `in` to `fn` in constant memory; `fn`
+ * returns 0 to stop early.
+ *
+ * Returns 0 when the input was read (or `fn` stopped), 1 on a
+ * malformed record, 2 on a read or allocation failure. `line`, if
+ * not NULL, receives the number of the last line read.
+ */
+typedef int (*TimelineEventSink)(const TimelineEvent *e, void *ctx);
+
+int timeline_read_ndjson(
+    FILE *in,
+    TimelineEventSink fn,
+    void *ctx,
+    size_t *line
+);
+
+/*
+ * Load every record of a timeline.ndjson into `*out` (free()).
+ *
+ * Returns 0 on success, 1 on bad arguments, 2 if the file cannot
+ * be opened, 3 on a malformed record, 4 on a read or allocation
+ * failure. On failure `*out` is NULL and `*out_count` 0.
+ */
+int load_timeline(const char *path, TimelineEvent **out, size_t *out_count);
+
+#endif /* LIMINAL_TIMELINE_LOAD_H */
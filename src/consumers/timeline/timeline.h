@@ -5,5 +5,7 @@
 #include "./emit.h"
 #include "./event.h"
 #include "./extract.h"
+#include "./binary.h"
+#include "./load_timeline.h"
 
 #endif
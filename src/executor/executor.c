@@ -17,11 +17,30 @@ Universe *executor_build(const ASTProgram *p)
     if (!u)
         return NULL;
 
-    World *w0 = world_create_initial(u);
-    universe_attach_initial_world(u, w0);
+    executor_run(u, p);
+    return u;
+}
 
+int executor_run(Universe *u, const ASTProgram *p)
+{
+    if (!u || !p || p->root_id == 0)
+        return 0;
+
+    u->timeline.symbols = &p->symbols;
     exec_node(u, p, p->root_id);
-    return u;
+    return 1;
+}
+
+int executor_run_function(Universe *u, const ASTProgram *p,
+                          uint32_t fn_id)
+{
+    const ASTNode *fn = p ? ast_node_get(p, fn_id) : NULL;
+    if (!u || !fn || fn->kind != AST_FUNCTION)
+        return 0;
+
+    u->timeline.symbols = &p->symbols;
+    exec_node(u, p, fn_id);
+    return 1;
 }
 
 /* Recursive structural traversal */
@@ -29,29 +48,27 @@ static void exec_node(Universe *u,
                       const ASTProgram *p,
                       uint32_t node_id)
 {
-    ASTNode *n = ast_node_get((ASTProgram *)p, node_id);
+    ASTNode *n = ast_node_get(p, node_id);
     if (!n) return;
 
     switch (n->kind) {
 
     case AST_PROGRAM:
-        u->current = universe_step(u, n);
-        u->current->step->kind = STEP_ENTER_PROGRAM;
+        universe_step(u, STEP_ENTER_PROGRAM, n);
 
-        /* Assume single function for now */
-        for (size_t i = 0; i < p->count; i++) {
-            if (p->nodes[i].kind == AST_FUNCTION) {
-                exec_node(u, p, p->nodes[i].id);
+        /* Every function, in source order */
+        for (uint32_t id = 1; id <= p->count; id++) {
+            if (ast_node_get(p, id)->kind == AST_FUNCTION) {
+                exec_node(u, p, id);
             }
         }
 
-        u->current = universe_step(u, n);
-        u->current->step->kind = STEP_EXIT_PROGRAM;
+        universe_step(u, STEP_EXIT_PROGRAM, n);
         break;
 
     case AST_FUNCTION:
         /* Structural marker */
-        universe_step(u, n)->step->kind = STEP_ENTER_FUNCTION;
+        universe_step(u, STEP_ENTER_FUNCTION, n);
 
         /* Function introduces a scope */
         universe_enter_scope(u, n);
@@ -63,7 +80,7 @@ static void exec_node(Universe *u,
         universe_exit_scope(u, n);
 
         /* Structural marker */
-        universe_step(u, n)->step->kind = STEP_EXIT_FUNCTION;
+        universe_step(u, STEP_EXIT_FUNCTION, n);
         break;
 
     case AST_BLOCK:
@@ -80,8 +97,7 @@ static void exec_node(Universe *u,
         break;
 
     case AST_RETURN:
-        u->current = universe_step(u, n);
-        u->current->step->kind = STEP_RETURN;
+        universe_step(u, STEP_RETURN, n);
         break;
     case AST_VAR_DECL:
         universe_declare_variable(
@@ -108,32 +124,33 @@ static void exec_node(Universe *u,
     Dump execution artifact (read-only)
     By convention, WORLD[1] is the initial world.
     How:
-        1. Iterate worlds in order
+        1. Iterate timeline entries in order
         2. Print step info
         3. Print relevant metadata
         4. Done
 */
 void executor_dump(const Universe *u)
 {
-    if (!u || !u->head) {
+    if (!u || u->timeline.count == 0) {
         printf("\n-- EXECUTION ARTIFACT --\n(empty)\n");
         return;
     }
 
+    const Timeline *tl = &u->timeline;
+
     printf("\n-- EXECUTION ARTIFACT --\n");
     printf("world_count=%llu\n\n",
            (unsigned long long)u->current_time + 1);
 
     printf("WORLD[1]\n");
 
-    for (World *w = u->head; w; w = w->next) {
-        Step *s = w->step;
-        if (!s) continue;
+    for (size_t t = 0; t < tl->count; t++) {
+        StepKind kind = timeline_kind(tl, t);
 
         printf("  STEP[%llu] ",
-               (unsigned long long)w->time);
+               (unsigned long long)t);
 
-        switch (s->kind) {
+        switch (kind) {
         case STEP_ENTER_PROGRAM:  printf("ENTER_PROGRAM");  break;
         case STEP_EXIT_PROGRAM:   printf("EXIT_PROGRAM");   break;
         case STEP_ENTER_FUNCTION: printf("ENTER_FUNCTION"); break;
@@ -146,14 +163,14 @@ void executor_dump(const Universe *u)
         default:                  printf("UNKNOWN");        break;
         }
 
-        if (s->origin) {
-            ASTNode *n = (ASTNode *)s->origin;
+        if (timeline_origin(tl, t)) {
+            ASTNode *n = (ASTNode *)timeline_origin(tl, t);
             printf(" ast=%u", n->id);
         }
 
-        if (s->kind == STEP_DECLARE || s->kind == STEP_USE) {
+        if (kind == STEP_DECLARE || kind == STEP_USE) {
             printf(" storage=%llu",
-                   (unsigned long long)s->info);
+                   (unsigned long long)timeline_info(tl, t));
         }
 
         printf("\n");
@@ -7,9 +7,9 @@
 #include "./stack/stack.h"
 #include "./step/step.h"
 #include "./storage/storage.h"
+#include "./timeline/timeline.h"
 #include "./universe/universe.h"
 #include "./variable/variable.h"
-#include "./world/world.h"
 #include "../frontends/frontends.h"
 
 
@@ -21,6 +21,24 @@
  */
 Universe *executor_build(const ASTProgram *ast);
 
+/*
+ * Execute `ast` into an existing Universe at time 0
+ * (fresh from universe_create or universe_reset).
+ * Returns 0 if the program has no root.
+ */
+int executor_run(Universe *u, const ASTProgram *ast);
+
+/*
+ * Execute function `fn_id` of `ast` alone into a Universe at
+ * time 0: the steps a whole-program run records for it, from
+ * ENTER_FUNCTION to EXIT_FUNCTION, with scope and storage ids
+ * counted from 1. Functions share no scope, so only time and
+ * those ids differ from the whole-program run.
+ * Returns 0 if `fn_id` is not a function.
+ */
+int executor_run_function(Universe *u, const ASTProgram *ast,
+                          uint32_t fn_id);
+
 /*
  * Dump execution artifact (read-only)
  */
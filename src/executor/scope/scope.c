@@ -1,7 +1,12 @@
 #include "executor/executor.h"
 #include "common/common.h"
 
-int scope_has_name(Scope *s, const char *name)
+int scope_has_name(const Scope *s, Symbol name)
 {
     return s && s->bindings && hashmap_get(s->bindings, name);
+}
+
+Scope *scope_next_distinct(const Scope *s)
+{
+    return s ? s->outer : NULL;
 }
\ No newline at end of file
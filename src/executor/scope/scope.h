@@ -15,6 +15,8 @@
  *   - otherwise, lookup proceeds to the parent
  */
 
+#include "common/intern/intern.h"
+
 struct HashMap;
 
 typedef struct Scope {
@@ -23,10 +25,26 @@ typedef struct Scope {
     /* Parent lexical scope (NULL for root / file scope) */
     struct Scope *parent;
 
+    /* Nearest ancestor with a different id (see scope_next_distinct) */
+    struct Scope *outer;
+
     /* Bindings for this scope: name -> storage location */
     struct HashMap *bindings;
 } Scope;
 
-int scope_has_name(Scope *s, const char *name);
+int scope_has_name(const Scope *s, Symbol name);
+
+/*
+ * Nearest ancestor of `s` with a different scope id.
+ *
+ * Frames of one id are contiguous along a parent chain, and the
+ * bindings of each frame extend those of the frame before it, so
+ * the newest frame of an id already holds every name of the older
+ * ones. Lookups only need to visit one frame per id.
+ *
+ * The link is set when the frame is created, so this is O(1)
+ * however many declarations a block holds.
+ */
+Scope *scope_next_distinct(const Scope *s);
 
 #endif /* LIMINAL_SCOPE_H */
@@ -51,10 +51,11 @@ typedef enum StepKind {
 /*
  * Step
  *
- * A Step is a single semantic cause marker.
+ * A Step is a single semantic cause marker, stored as one entry
+ * of the Timeline (see timeline/timeline.h): kind, origin, info.
  *
  * Invariants:
- *  - Immutable once attached to a World
+ *  - Immutable once appended
  *  - Owned by the Universe
  *  - Does NOT own memory
  *
@@ -67,11 +68,6 @@ typedef enum StepKind {
  *  - STEP_DECLARE / STEP_USE       → storage_id (or UINT64_MAX)
  *  - otherwise                     → unused (0)
  */
-typedef struct Step {
-    StepKind kind;
-    void    *origin;
-    uint64_t info;
-} Step;
 
 /*
  * Canonical stringification.
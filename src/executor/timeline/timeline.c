@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include "executor/executor.h"
+
+#define TIMELINE_INITIAL_CAPACITY 256
+
+void timeline_init(Timeline *tl)
+{
+    tl->kind     = NULL;
+    tl->origin   = NULL;
+    tl->info     = NULL;
+    tl->scope    = NULL;
+    tl->count    = 0;
+    tl->capacity = 0;
+    tl->symbols  = NULL;
+}
+
+void timeline_free(Timeline *tl)
+{
+    free(tl->kind);
+    free(tl->origin);
+    free(tl->info);
+    free(tl->scope);
+    timeline_init(tl);
+}
+
+void timeline_reset(Timeline *tl)
+{
+    tl->count = 0;
+}
+
+/*
+ * Grow every column to `cap` entries.
+ * Columns that were already resized keep their new size on failure;
+ * `capacity` only advances once all of them succeed.
+ */
+static int timeline_grow(Timeline *tl, size_t cap)
+{
+    uint8_t *kind = realloc(tl->kind, cap * sizeof(*kind));
+    if (!kind) return 0;
+    tl->kind = kind;
+
+    void **origin = realloc(tl->origin, cap * sizeof(*origin));
+    if (!origin) return 0;
+    tl->origin = origin;
+
+    uint64_t *info = realloc(tl->info, cap * sizeof(*info));
+    if (!info) return 0;
+    tl->info = info;
+
+    struct Scope **scope = realloc(tl->scope, cap * sizeof(*scope));
+    if (!scope) return 0;
+    tl->scope = scope;
+
+    tl->capacity = cap;
+    return 1;
+}
+
+void timeline_fit(Timeline *tl)
+{
+    if (tl->count == 0 || tl->count == tl->capacity) {
+        return;
+    }
+
+    /* A failed shrink leaves that column larger, never short */
+    timeline_grow(tl, tl->count);
+    tl->capacity = tl->count;
+}
+
+int timeline_append(
+    Timeline *tl,
+    StepKind kind,
+    void *origin,
+    uint64_t info,
+    struct Scope *scope
+)
+{
+    if (tl->count == tl->capacity) {
+        size_t cap = tl->capacity
+            ? tl->capacity * 2
+            : TIMELINE_INITIAL_CAPACITY;
+
+        if (!timeline_grow(tl, cap)) {
+            return 0;
+        }
+    }
+
+    size_t i = tl->count++;
+
+    tl->kind[i]   = (uint8_t)kind;
+    tl->origin[i] = origin;
+    tl->info[i]   = info;
+    tl->scope[i]  = scope;
+
+    return 1;
+}
@@ -0,0 +1,86 @@
+#ifndef LIMINAL_EXECUTOR_TIMELINE_H
+#define LIMINAL_EXECUTOR_TIMELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../step/step.h"
+
+struct Scope;
+struct InternTable;
+
+/*
+ * Timeline
+ *
+ * The execution history, stored column-wise.
+ *
+ * Entry i is the Step that happened at time i:
+ *   kind[i]   — StepKind
+ *   origin[i] — opaque cause (usually ASTNode*)
+ *   info[i]   — kind-dependent payload (see step.h)
+ *   scope[i]  — active scope frame AFTER the step
+ *
+ * Time is the index. Entry 0 is the initial state
+ * (STEP_UNKNOWN, no origin, no scope).
+ *
+ * Columns are append-only; entries never change once written.
+ * Columns may move when grown, so hold indices, not pointers.
+ *
+ * `symbols` spells the names in the origins; like them it belongs
+ * to the program that was run (NULL before any run).
+ */
+typedef struct Timeline {
+    uint8_t        *kind;
+    void          **origin;
+    uint64_t       *info;
+    struct Scope  **scope;
+
+    size_t count;
+    size_t capacity;
+
+    const struct InternTable *symbols;
+} Timeline;
+
+void timeline_init(Timeline *tl);
+void timeline_free(Timeline *tl);
+
+/* Drop every entry but keep the columns for reuse */
+void timeline_reset(Timeline *tl);
+
+/*
+ * Release column capacity beyond `count`, for timelines kept long
+ * after they are written. The next append grows them again.
+ */
+void timeline_fit(Timeline *tl);
+
+/* Append one entry. Returns 0 on allocation failure. */
+int timeline_append(
+    Timeline *tl,
+    StepKind kind,
+    void *origin,
+    uint64_t info,
+    struct Scope *scope
+);
+
+/* Column accessors (no bounds checks) */
+static inline StepKind timeline_kind(const Timeline *tl, size_t i)
+{
+    return (StepKind)tl->kind[i];
+}
+
+static inline void *timeline_origin(const Timeline *tl, size_t i)
+{
+    return tl->origin[i];
+}
+
+static inline uint64_t timeline_info(const Timeline *tl, size_t i)
+{
+    return tl->info[i];
+}
+
+static inline struct Scope *timeline_scope(const Timeline *tl, size_t i)
+{
+    return tl->scope[i];
+}
+
+#endif /* LIMINAL_EXECUTOR_TIMELINE_H */
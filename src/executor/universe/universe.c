@@ -1,6 +1,5 @@
 #include <stdlib.h>
 #include "./universe.h"
-#include "../world/world.h"
 #include "../scope/scope.h"
 #include "../step/step.h"
 #include "../variable/variable.h"
@@ -8,12 +7,14 @@
 #include "common/common.h"
 
 /*
- * Create an empty Universe.
+ * Create an empty Universe whose arenas start with the given
+ * first chunks.
  *
- * The Universe owns time and the World chain.
- * Initially, there are no Worlds.
+ * The Universe owns time and the timeline.
+ * Time 0 is the initial state: no scope, no cause.
  */
-Universe *universe_create(void)
+static Universe *universe_create_with(size_t scopes, size_t vars,
+                                      size_t storage)
 {
     Universe *u = calloc(1, sizeof(Universe));
     if (!u) {
@@ -21,200 +22,155 @@ Universe *universe_create(void)
     }
 
     u->current_time = 0;
-    u->head = NULL;
-    u->tail = NULL;
-    u->current = NULL;
-
-    arena_init(&u->world_arena, 64 * 1024); /* Worlds */
-    arena_init(&u->step_arena, 64 * 1024);  /* Steps */ /* plenty for now */
-    arena_init(&u->scope_arena, 64 * 1024); /* Scopes */ 
-    arena_init(&u->storage_arena, 64 * 1024); /* Storage */ 
-    
+    u->active_scope = NULL;
+
+    timeline_init(&u->timeline);
+
+    arena_init(&u->scope_arena, scopes);    /* Scopes + bindings */
+    arena_init(&u->var_arena, vars);        /* Variables */
+    arena_init(&u->storage_arena, storage); /* Storage */
+
     u->next_scope_id   = 1;
     u->next_storage_id = 1;
-    
+
+    /* Causal root */
+    if (!timeline_append(&u->timeline, STEP_UNKNOWN, NULL, 0, NULL)) {
+        universe_destroy(u);
+        return NULL;
+    }
+
     return u;
 }
 
-/*
- * Advance the Universe by one step in time.
- *
- * This clones the current World, increments time,
- * links history, and advances the current pointer.
- *
- * No execution happens here.
- * Only causality and time.
- */
-World *universe_step(Universe *u, void *origin)
+Universe *universe_create(void)
 {
-    if (!u || !u->current) {
-        return NULL;
-    }
+    /* Initial chunk sizes; arenas grow as the program does */
+    return universe_create_with(64 * 1024, 4 * 1024, 64 * 1024);
+}
 
-    World *prev = u->current;
-    World *next = world_clone(u, prev);
-    if (!next) {
-        return NULL;
+Universe *universe_create_sized(size_t arena_size)
+{
+    return universe_create_with(arena_size, arena_size, arena_size);
+}
+
+void universe_destroy(Universe *u)
+{
+    if (!u) {
+        return;
     }
 
-    /* Advance time */
-    next->time = prev->time + 1;
+    timeline_free(&u->timeline);
+    arena_destroy(&u->scope_arena);
+    arena_destroy(&u->var_arena);
+    arena_destroy(&u->storage_arena);
+    free(u);
+}
 
-    /* Attach semantic cause with AST origin */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return NULL;
+int universe_reset(Universe *u)
+{
+    if (!u) {
+        return 0;
     }
 
-    s->kind   = STEP_OTHER;
-    s->origin = origin;
-    s->info   = 0;
-
-    next->step = s;
+    u->current_time = 0;
+    u->active_scope = NULL;
 
-    /* Link temporal history */
-    next->prev = prev;
-    prev->next = next;
+    timeline_reset(&u->timeline);
+    arena_reset(&u->scope_arena);
+    arena_reset(&u->var_arena);
+    arena_reset(&u->storage_arena);
 
-    /* Update Universe */
-    u->current = next;
-    u->tail = next;
-    u->current_time = next->time;
+    u->next_scope_id   = 1;
+    u->next_var_id     = 0;
+    u->next_storage_id = 1;
 
-    return next;
+    /* Causal root */
+    return timeline_append(&u->timeline, STEP_UNKNOWN, NULL, 0, NULL);
 }
 
 /*
- * Attach the initial World to the Universe.
+ * Record one step and advance time.
  *
- * This establishes time = 0.
+ * `scope` becomes the active scope from this step on.
  */
-
- void universe_attach_initial_world(Universe *u, World *w)
+static int universe_record(
+    Universe *u,
+    StepKind kind,
+    void *origin,
+    uint64_t info,
+    Scope *scope
+)
 {
-    if (!u || !w) {
-        return;
+    if (!timeline_append(&u->timeline, kind, origin, info, scope)) {
+        return 0;
     }
 
-    /* Allocate initial Step from the Universe arena */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return; /* fatal in practice, but keep function total */
-    }
+    u->active_scope = scope;
+    u->current_time = u->timeline.count - 1;
 
-    s->kind   = STEP_UNKNOWN;
-    s->origin = NULL;
-    s->info   = 0;
+    return 1;
+}
 
-    /* Attach causal root */
-    w->step = s;
+/*
+ * Advance the Universe by one step in time.
+ *
+ * Scope state carries over unchanged.
+ * No execution happens here.
+ * Only causality and time.
+ */
+int universe_step(Universe *u, StepKind kind, void *origin)
+{
+    if (!u) {
+        return 0;
+    }
 
-    /* Establish timeline */
-    u->head = w;
-    u->tail = w;
-    u->current = w;
-    u->current_time = w->time;
+    return universe_record(u, kind, origin, 0, u->active_scope);
 }
 
 /*
  * Enter a new lexical scope.
  *
- * This creates a new Scope, clones the current World,
- * updates the active scope, and links history.
+ * This creates a new Scope whose parent is the current
+ * active scope, and makes it active.
  */
-
-World *universe_enter_scope(Universe *u, void *origin)
+int universe_enter_scope(Universe *u, void *origin)
 {
-    if (!u || !u->current) {
-        return NULL;
+    if (!u) {
+        return 0;
     }
 
-    /* Allocate new Scope */
-    Scope *scope = arena_alloc(&u->scope_arena, sizeof(Scope));
+    Scope *scope = arena_alloc_uninit(&u->scope_arena, sizeof(Scope));
     if (!scope) {
-        return NULL;
+        return 0;
     }
 
     scope->id       = u->next_scope_id++;
-    scope->parent   = u->current->active_scope;
+    scope->parent   = u->active_scope;
+    scope->outer    = u->active_scope;
     scope->bindings = NULL; /* later */
 
-    /* Clone world */
-    World *next = world_clone(u, u->current);
-    if (!next) {
-        return NULL;
-    }
-
-    next->time = u->current->time + 1;
-    next->active_scope = scope;
-
-    /* Create Step */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return NULL;
-    }
-
-    s->kind   = STEP_ENTER_SCOPE;
-    s->origin = origin;
-    s->info   = scope->id;
-
-    next->step = s;
-
-    /* Link timeline */
-    next->prev = u->current;
-    u->current->next = next;
-    u->current = next;
-    u->tail = next;
-    u->current_time = next->time;
-
-    return next;
+    return universe_record(u, STEP_ENTER_SCOPE, origin, scope->id, scope);
 }
 
 
 /*
  * Exit the current lexical scope.
  *
- * This clones the current World, updates the active scope
- * to the parent scope, and links history.
+ * The active scope becomes the one active when the exiting scope
+ * was entered (`outer`). Not the frame's parent: every declaration
+ * adds a frame of the same scope, so the parent may still hold the
+ * exiting scope's names.
  */
-World *universe_exit_scope(Universe *u, void *origin)
+int universe_exit_scope(Universe *u, void *origin)
 {
-    if (!u || !u->current || !u->current->active_scope) {
-        return NULL;
+    if (!u || !u->active_scope) {
+        return 0;
     }
 
-    Scope *exiting = u->current->active_scope;
-    Scope *parent  = exiting->parent;
+    Scope *exiting = u->active_scope;
 
-    /* Clone world */
-    World *next = world_clone(u, u->current);
-    if (!next) {
-        return NULL;
-    }
-
-    next->time = u->current->time + 1;
-    next->active_scope = parent;
-
-    /* Create Step */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return NULL;
-    }
-
-    s->kind   = STEP_EXIT_SCOPE;
-    s->origin = origin;
-    s->info   = exiting->id;
-
-    next->step = s;
-
-    /* Link timeline */
-    next->prev = u->current;
-    u->current->next = next;
-    u->current = next;
-    u->tail = next;
-    u->current_time = next->time;
-
-    return next;
+    return universe_record(
+        u, STEP_EXIT_SCOPE, origin, exiting->id, exiting->outer);
 }
 
 
@@ -222,147 +178,82 @@ World *universe_exit_scope(Universe *u, void *origin)
 /*
  * Declare a new variable in the current scope.
  *
- * This creates a new Storage, clones the current World,
- * updates the active scope's bindings, and links history.
+ * This creates a new Storage and a new scope frame whose
+ * bindings extend the current ones.
  */
-World *universe_declare_variable(
+int universe_declare_variable(
     Universe *u,
-    const char *name,
+    Symbol name,
     void *origin
 )
 {
-    if (!u || !u->current || !name) {
-        return NULL;
+    if (!u || name == SYMBOL_NONE || !u->active_scope) {
+        return 0;
     }
 
-    World *prev = u->current;
-    World *next = world_clone(u, prev);
-    if (!next) {
-        return NULL;
-    }
-
-    /* Advance time */
-    next->time = prev->time + 1;
-
     /* Allocate Storage */
-    Storage *st = arena_alloc(&u->storage_arena, sizeof(Storage));
+    Storage *st = arena_alloc_uninit(&u->storage_arena, sizeof(Storage));
     if (!st) {
-        return NULL;
+        return 0;
     }
 
     st->id = u->next_storage_id++;
-    st->declared_at = next->time;
+    st->declared_at = u->current_time + 1;
 
     /* Create new scope frame */
-    Scope *old = prev->active_scope;
+    Scope *old = u->active_scope;
 
-    Scope *sc = arena_alloc(&u->scope_arena, sizeof(Scope));
+    Scope *sc = arena_alloc_uninit(&u->scope_arena, sizeof(Scope));
     if (!sc) {
-        return NULL;
+        return 0;
     }
 
     sc->id = old->id;
     sc->parent = old;
+    sc->outer = old->outer;
 
-    sc->bindings = hashmap_clone(
-        old ? old->bindings : NULL,
-        &u->scope_arena
-    );
+    /* Persistent insert: shares all untouched nodes with `old` */
+    HashMap *bindings = old->bindings
+        ? old->bindings
+        : hashmap_create(&u->scope_arena);
 
-    hashmap_put(sc->bindings, name, st);
-
-    next->active_scope = sc;
-
-    /* Emit STEP_DECLARE */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return NULL;
+    sc->bindings = hashmap_put(bindings, name, st);
+    if (!sc->bindings) {
+        return 0;
     }
 
-    s->kind   = STEP_DECLARE;
-    s->origin = origin;
-    s->info   = st->id;
-
-    next->step = s;
-
-    /* Link timeline */
-    next->prev = prev;
-    prev->next = next;
-
-    u->current = next;
-    u->tail = next;
-    u->current_time = next->time;
-
-    return next;
+    return universe_record(u, STEP_DECLARE, origin, st->id, sc);
 }
 
 
 /*
  * Use (read) a variable by name.
  *
- * This resolves the variable in the current scope chain,
- * clones the current World, and links history.
+ * This resolves the variable in the current scope chain
+ * and records the attempt.
  */
-World *universe_use_variable(
+int universe_use_variable(
     Universe *u,
-    const char *name,
+    Symbol name,
     void *origin
 )
 {
-    if (!u || !u->current || !name) {
-        return NULL;
+    if (!u || name == SYMBOL_NONE) {
+        return 0;
     }
 
-    World *prev = u->current;
-
     /* Resolve name in current scope chain */
-    Scope *sc = prev->active_scope;
     Storage *st = NULL;
 
-    while (sc) {
-        if (sc->bindings) {
-            st = hashmap_get(sc->bindings, name);
-            if (st) {
-                break;
-            }
+    for (Scope *sc = u->active_scope; sc; sc = scope_next_distinct(sc)) {
+        st = sc->bindings ? hashmap_get(sc->bindings, name) : NULL;
+        if (st) {
+            break;
         }
-        sc = sc->parent;
     }
 
-    /* Clone world regardless — we record the attempt */
-    World *next = world_clone(u, prev);
-    if (!next) {
-        return NULL;
-    }
-
-    next->time = prev->time + 1;
-
-    /* Emit STEP_USE */
-    Step *s = arena_alloc(&u->step_arena, sizeof(Step));
-    if (!s) {
-        return NULL;
-    }
-
-    s->kind   = STEP_USE;
-    s->origin = origin;
-
-    if (st) {
-        /* Valid use */
-        s->info = st->id;
-    } else {
-        /* Unresolved use — semantic error */
-        s->info = UINT64_MAX;
-    }
-
-    next->step = s;
-
-    /* Link timeline */
-    next->prev = prev;
-    prev->next = next;
-
-    u->current = next;
-    u->tail = next;
-    u->current_time = next->time;
+    /* Valid use records the storage; unresolved is a semantic error */
+    uint64_t info = st ? st->id : UINT64_MAX;
 
-    return next;
+    return universe_record(u, STEP_USE, origin, info, u->active_scope);
 }
@@ -2,34 +2,35 @@
 #define LIMINAL_UNIVERSE_H
 
 #include <stdint.h>
-#include "../world/world.h"
+#include "../timeline/timeline.h"
 #include "../../common/common.h"
 
+struct Scope;
+
 /*
  * Universe
  *
  * The Universe owns time and history.
  *
  * It is responsible for:
- * - creating Worlds
- * - linking Worlds into a timeline
- * - tracking the current World
+ * - appending Steps to the timeline
+ * - tracking the current active scope
  *
  * The Universe does NOT:
  * - execute semantics
- * - analyze Worlds
- * - mutate existing Worlds
+ * - analyze the timeline
+ * - rewrite history
  */
 
 typedef struct Universe {
     uint64_t current_time;
 
-    World *head;
-    World *tail;
-    World *current;
+    /* History: one column entry per step, time == index */
+    Timeline timeline;
+
+    /* State at current_time */
+    struct Scope *active_scope;
 
-    Arena world_arena;
-    Arena step_arena;
     Arena scope_arena;
     Arena var_arena;
     Arena storage_arena;
@@ -40,28 +41,55 @@ typedef struct Universe {
     uint64_t next_storage_id;
 } Universe;
 
+/*
+ * Create a Universe at time 0.
+ * The timeline starts with the initial (STEP_UNKNOWN) entry.
+ */
+Universe *universe_create(void);
 
-World *universe_step(Universe *u, void *origin);
+/*
+ * As universe_create, with every arena starting at `arena_size`
+ * bytes (arenas still double as they fill). For callers holding
+ * many small Universes at once, where the default first chunks
+ * would dominate memory.
+ */
+Universe *universe_create_sized(size_t arena_size);
 
-void universe_attach_initial_world(Universe *u, World *w);
+void universe_destroy(Universe *u);
 
-Universe *universe_create(void);
+/*
+ * Return `u` to time 0 for another program.
+ *
+ * Arenas and timeline columns are kept (arena_reset), so a run
+ * over many inputs stops allocating once it has seen the largest.
+ * Every Scope, Variable and Storage from the previous program is
+ * invalidated. Returns 0 on allocation failure.
+ */
+int universe_reset(Universe *u);
+
+/*
+ * All step operations return 1 on success and 0 if the Universe
+ * could not record the step (allocation failure).
+ */
+
+/* Structural marker step */
+int universe_step(Universe *u, StepKind kind, void *origin);
 
 /* Scope control */
-World *universe_enter_scope(Universe *u, void *origin);
-World *universe_exit_scope(Universe *u, void *origin);
+int universe_enter_scope(Universe *u, void *origin);
+int universe_exit_scope(Universe *u, void *origin);
 
 
 /* Variable operations */
-World *universe_declare_variable(
+int universe_declare_variable(
     Universe *u,
-    const char *name,
+    Symbol name,
     void *origin
 );
 
-World *universe_use_variable(
+int universe_use_variable(
     Universe *u,
-    const char *name,
+    Symbol name,
     void *origin
 );
 
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#include "common/intern/intern.h"
+
 /*
  * Variable
  *
@@ -14,7 +16,7 @@
 typedef struct Variable {
     uint64_t id;          /* unique id */
     uint64_t scope_id;    /* scope that owns this variable */
-    const char *name;     /* optional (frontend later) */
+    Symbol   name;        /* interned; SYMBOL_NONE if anonymous */
 } Variable;
 
 #endif /* LIMINAL_VARIABLE_H */
@@ -4,22 +4,88 @@
 #include <stdio.h>
 
 
+/* Place an empty program at the start of `a`; NULL on failure */
+static ASTProgram *ast_program_place(Arena *a,
+                                     const char *path,
+                                     const char *src,
+                                     size_t len)
+{
+    ASTProgram *p = arena_alloc(a, sizeof(ASTProgram));
+    if (!p) {
+        return NULL;
+    }
+
+    size_t plen = path ? strlen(path) + 1 : 0;
+    char *pcopy = plen ? arena_alloc_uninit(a, plen) : NULL;
+    if (pcopy) {
+        memcpy(pcopy, path, plen);
+    }
+
+    p->arena = *a;
+
+    p->pages      = NULL;
+    p->page_count = 0;
+    p->page_cap   = 0;
+    p->count      = 0;
+
+    p->source_path  = pcopy;
+    p->source_text  = src;
+    p->source_len   = len;
+
+    p->root_id = 0; /* IMPORTANT */
+
+    return p;
+}
+
 ASTProgram *ast_program_new(const char *path,
                             const char *src,
                             size_t len)
 {
-    ASTProgram *p = calloc(1, sizeof(ASTProgram));
-    if (!p) return NULL;
+    /*
+     * Size the first chunk from the source: roughly one 32-byte node
+     * per statement of a few bytes, so most files fit in one chunk.
+     */
+    Arena a;
+    arena_init(&a, 16 * 1024 + len * 4);
 
-    p->nodes = NULL;
-    p->count = 0;
-    p->cap   = 0;
+    /* The program lives in its own arena */
+    ASTProgram *p = ast_program_place(&a, path, src, len);
+    if (!p) {
+        arena_destroy(&a);
+        return NULL;
+    }
 
-    p->source_path = strdup(path);
-    p->source_text = strdup(src);
-    p->source_len  = len;
+    intern_init(&p->symbols);
 
-    p->root_id = 0; /* IMPORTANT */
+    return p;
+}
+
+ASTProgram *ast_program_recycle(ASTProgram *old,
+                                const char *path,
+                                const char *src,
+                                size_t len)
+{
+    if (!old) {
+        return ast_program_new(path, src, len);
+    }
+
+    source_buffer_close(&old->source);
+
+    /* Both handles live inside the arena being reset */
+    Arena a = old->arena;
+    InternTable symbols = old->symbols;
+
+    arena_reset(&a);
+    intern_reset(&symbols);
+
+    ASTProgram *p = ast_program_place(&a, path, src, len);
+    if (!p) {
+        intern_free(&symbols);
+        arena_destroy(&a);
+        return NULL;
+    }
+
+    p->symbols = symbols;
 
     return p;
 }
@@ -29,45 +95,68 @@ void ast_program_free(ASTProgram *p)
 {
     if (!p) return;
 
-    /* Free block stmt arrays */
-    for (size_t i = 0; i < p->count; i++) {
-        ASTNode *n = &p->nodes[i];
-        if (n->kind == AST_BLOCK) {
-            free(n->as.block.stmt_ids);
-            n->as.block.stmt_ids = NULL;
-            n->as.block.stmt_count = 0;
-        }
-    }
+    intern_free(&p->symbols);
+    source_buffer_close(&p->source);
 
-    free(p->nodes);
-    free(p->source_path);
-    free(p->source_text);
-    free(p);
+    /* `p` itself is in the arena: copy the handle out first */
+    Arena a = p->arena;
+    arena_destroy(&a);
 }
 
-ASTNode *ast_node_get(ASTProgram *p, uint32_t id)
+void ast_program_adopt_source(ASTProgram *p, SourceBuffer *sb)
+{
+    if (!p || !sb) return;
+    p->source = *sb;
+    memset(sb, 0, sizeof(*sb));
+}
+
+void *ast_alloc(ASTProgram *p, size_t size)
+{
+    return p ? arena_alloc_uninit(&p->arena, size) : NULL;
+}
+
+ASTNode *ast_node_get(const ASTProgram *p, uint32_t id)
 {
     if (!p || id == 0) return NULL;
     size_t idx = (size_t)(id - 1);
     if (idx >= p->count) return NULL;
-    return &p->nodes[idx];
+    return &p->pages[idx >> AST_PAGE_SHIFT][idx & (AST_PAGE_NODES - 1)];
+}
+
+/* Append one page; the page table doubles inside the arena */
+static int ast_add_page(ASTProgram *p)
+{
+    if (p->page_count == p->page_cap) {
+        size_t ncap = p->page_cap ? p->page_cap * 2 : 8;
+        ASTNode **np = arena_alloc_uninit(&p->arena, ncap * sizeof(*np));
+        if (!np) return 0;
+        if (p->page_count) {
+            memcpy(np, p->pages, p->page_count * sizeof(*np));
+        }
+        p->pages = np;
+        p->page_cap = ncap;
+    }
+
+    ASTNode *page = arena_alloc_uninit(
+        &p->arena, AST_PAGE_NODES * sizeof(ASTNode));
+    if (!page) return 0;
+
+    p->pages[p->page_count++] = page;
+    return 1;
 }
 
 uint32_t ast_add_node(ASTProgram *p, ASTKind kind, ASTSpan at)
 {
     if (!p) return 0;
 
-    if (p->count >= p->cap) {
-        size_t ncap = (p->cap == 0) ? 8 : p->cap * 2;
-        ASTNode *nn = (ASTNode *)realloc(p->nodes, ncap * sizeof(ASTNode));
-        if (!nn) return 0;
-        /* zero new range */
-        memset(nn + p->cap, 0, (ncap - p->cap) * sizeof(ASTNode));
-        p->nodes = nn;
-        p->cap = ncap;
+    if (p->count >= UINT32_MAX) return 0;
+
+    if (p->count == p->page_count * AST_PAGE_NODES && !ast_add_page(p)) {
+        return 0;
     }
 
-    ASTNode *n = &p->nodes[p->count];
+    ASTNode *n = &p->pages[p->count >> AST_PAGE_SHIFT]
+                          [p->count & (AST_PAGE_NODES - 1)];
     memset(n, 0, sizeof(*n));
     n->id = (uint32_t)(p->count + 1);
     n->kind = kind;
@@ -4,6 +4,10 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "common/arena/arena.h"
+#include "common/file/file.h"
+#include "common/intern/intern.h"
+
 typedef enum ASTKind {
     AST_UNKNOWN = 0,
 
@@ -29,38 +33,60 @@ typedef struct ASTSpan {
 
 typedef struct ASTNode ASTNode;
 
+/* Nodes per page; pages never move, so node pointers stay valid */
+#define AST_PAGE_SHIFT 8u
+#define AST_PAGE_NODES (1u << AST_PAGE_SHIFT)
+
+/*
+ * ASTProgram
+ *
+ * Everything the program holds (the program itself, node pages,
+ * statement lists, the path) lives in one arena, so teardown is a
+ * single arena_destroy regardless of program size.
+ *
+ * The source text is not copied: `source_text` points at the
+ * frontend's SourceBuffer (usually a file mapping), which the
+ * program releases only once adopted.
+ */
 typedef struct ASTProgram {
-    /* Arena-owned nodes */
-    ASTNode  *nodes;
+    Arena     arena;
+
+    /* Nodes, AST_PAGE_NODES per page */
+    ASTNode **pages;
+    size_t    page_count;
+    size_t    page_cap;
     size_t    count;
-    size_t    cap;
 
-    /* Source (owned copy) */
-    char     *source_path;
-    char     *source_text;
-    size_t    source_len;
+    /* Source */
+    const char *source_path;  /* arena copy */
+    const char *source_text;  /* borrowed unless adopted; no NUL */
+    size_t      source_len;
+    SourceBuffer source;      /* adopted buffer, may be empty */
 
     /* Root node id (index+1) */
     uint32_t  root_id;
+
+    /* Identifier spellings, interned by the lexer */
+    InternTable symbols;
 } ASTProgram;
 
 /* Node payloads (keep these dead simple for Step 1) */
 typedef struct ASTFunction {
-    const char *name;   /* owned by ASTProgram */
+    Symbol      name;   /* in ASTProgram.symbols */
     uint32_t    body_id;
 } ASTFunction;
 
 typedef struct ASTBlock {
-    uint32_t *stmt_ids;   /* array of node ids */
+    uint32_t *stmt_ids;   /* array of node ids (arena) */
     size_t    stmt_count;
 } ASTBlock;
 
 typedef struct ASTVarDecl {
-    const char *name;     /* points into program-owned memory */
+    Symbol name;          /* in ASTProgram.symbols */
 } ASTVarDecl;
 
 typedef struct ASTVarUse {
-    const char *name;     /* points into program-owned memory */
+    Symbol name;          /* in ASTProgram.symbols */
 } ASTVarUse;
 
 typedef struct ASTReturn {
@@ -85,11 +111,25 @@ struct ASTNode {
 ASTProgram *ast_program_new(const char *source_path, const char *source_text, size_t len);
 void        ast_program_free(ASTProgram *p);
 
-ASTNode    *ast_node_get(ASTProgram *p, uint32_t id);
+/*
+ * Like ast_program_new, but rebuilds in the memory of `old`
+ * (its arena and symbol table are reset, its source released).
+ * `old` is consumed even on failure; NULL behaves like _new.
+ */
+ASTProgram *ast_program_recycle(ASTProgram *old, const char *source_path,
+                                const char *source_text, size_t len);
+
+/* Take ownership of the buffer `source_text` points into; `sb` is emptied */
+void        ast_program_adopt_source(ASTProgram *p, SourceBuffer *sb);
+
+ASTNode    *ast_node_get(const ASTProgram *p, uint32_t id);
 
 /* Builders */
 uint32_t    ast_add_node(ASTProgram *p, ASTKind kind, ASTSpan at);
 
+/* Uninitialised program-lifetime storage (NULL on failure) */
+void       *ast_alloc(ASTProgram *p, size_t size);
+
 /* Debug */
 void        ast_dump(const ASTProgram *p);
 
@@ -32,7 +32,7 @@ void ast_dump(const ASTProgram *p)
     printf("root_id=%u\n\n", p->root_id);
 
     for (size_t i = 0; i < p->count; i++) {
-        const ASTNode *n = &p->nodes[i];
+        const ASTNode *n = ast_node_get(p, (uint32_t)(i + 1));
 
         printf("[%u] ", n->id);
 
@@ -43,7 +43,7 @@ void ast_dump(const ASTProgram *p)
 
         case AST_FUNCTION:
             printf("FUNCTION name=%s body=%u\n",
-                n->as.fn.name,
+                intern_name(&p->symbols, n->as.fn.name),
                 n->as.fn.body_id);
             break;
 
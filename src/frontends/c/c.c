@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "./c.h"
 #include "./lexer/lexer.h"
 #include "./parser/parser.h"
 #include "../../common/common.h" 
@@ -12,14 +13,49 @@
  */
 ASTProgram *c_parse_file_to_ast(const char *path)
 {
-    char *src = NULL;
-    size_t len = 0;
+    return c_parse_file_recycle(path, NULL);
+}
+
+ASTProgram *c_parse_file_recycle(const char *path, ASTProgram *old)
+{
+    SourceBuffer sb;
 
-    if (!read_entire_file(path, &src, &len))
+    if (!source_buffer_open(&sb, path)) {
+        ast_program_free(old);
         return NULL;
+    }
 
+    return c_parse_buffer_recycle(path, &sb, old);
+}
+
+ASTProgram *c_parse_buffer_recycle(const char *path,
+                                   SourceBuffer *sb,
+                                   ASTProgram *old)
+{
+    Lexer lx;
+    lexer_init(&lx, path, sb->data, sb->len);
+
+    ASTProgram *p = parse_translation_unit_recycle(&lx, old);
+    lexer_free(&lx);
+    if (!p) {
+        source_buffer_close(sb);
+        return NULL;
+    }
+
+    /* Nothing is copied out of the source: the program keeps it */
+    ast_program_adopt_source(p, sb);
+    return p;
+}
+
+ASTProgram *c_parse_source_recycle(const char *name,
+                                   const char *src,
+                                   size_t len,
+                                   ASTProgram *old)
+{
     Lexer lx;
-    lexer_init(&lx, path, src, len);
+    lexer_init(&lx, name, src, len);
 
-    return parse_translation_unit(&lx);
+    ASTProgram *p = parse_translation_unit_recycle(&lx, old);
+    lexer_free(&lx);
+    return p;
 }
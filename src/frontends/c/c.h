@@ -9,6 +9,7 @@
  * Frontend artifact:
  *
  * Parse a C source file into an immutable ASTProgram.
+ * `path` may be "-" for stdin.
  *
  * Ownership:
  *   - Returned ASTProgram is heap / arena owned
@@ -16,4 +17,32 @@
  */
 ASTProgram *c_parse_file_to_ast(const char *path);
 
+/*
+ * Parse `path` reusing the memory of a previous program.
+ *
+ * `old` is consumed whether or not the parse succeeds; pass the
+ * result back in for the next file. NULL behaves like
+ * c_parse_file_to_ast.
+ */
+ASTProgram *c_parse_file_recycle(const char *path, ASTProgram *old);
+
+/*
+ * As c_parse_file_recycle, for a file the caller already opened
+ * (e.g. to hash it). The program takes over `sb`; on failure it is
+ * closed.
+ */
+ASTProgram *c_parse_buffer_recycle(const char *path,
+                                   SourceBuffer *sb,
+                                   ASTProgram *old);
+
+/*
+ * Parse `len` bytes of source held by the caller, reported under
+ * `name`. The program borrows `src`, which must outlive it.
+ * `old` is consumed as in c_parse_file_recycle.
+ */
+ASTProgram *c_parse_source_recycle(const char *name,
+                                   const char *src,
+                                   size_t len,
+                                   ASTProgram *old);
+
 #endif /* LIMINAL_FRONTEND_C_H */
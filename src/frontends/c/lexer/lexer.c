@@ -1,76 +1,401 @@
 #include "./lexer.h"
+#include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <stdint.h>
+
+/*
+ * Runs of whitespace and identifier characters are skipped 16 bytes
+ * at a time with SSE2 where available; the class table below is
+ * the scalar path and the reference for both.
+ * Build with -DLEXER_NO_SIMD to force the scalar path.
+ */
+#if defined(__SSE2__) && defined(__GNUC__) && !defined(LEXER_NO_SIMD)
+#include <emmintrin.h>
+#define LEXER_SIMD 1
+#endif
+
+/* ------------------------------------------------------------
+ * Character classes (C locale isspace / isdigit / isalpha)
+ * ------------------------------------------------------------ */
+
+enum {
+    CC_SPACE = 1u << 0,
+    CC_DIGIT = 1u << 1,
+    CC_ALPHA = 1u << 2,
+    CC_ALNUM = CC_DIGIT | CC_ALPHA
+};
+
+#define N 0
+#define S CC_SPACE
+#define D CC_DIGIT
+#define A CC_ALPHA
+
+static const uint8_t CHAR_CLASS[256] = {
+    N, N, N, N, N, N, N, N, N, S, S, S, S, S, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    S, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    D, D, D, D, D, D, D, D, D, D, N, N, N, N, N, N,
+    N, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, N, N, N, N, N,
+    N, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+    N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+};
+
+#undef N
+#undef S
+#undef D
+#undef A
+
+#define CLASS(c) CHAR_CLASS[(unsigned char)(c)]
+
+/* Single-character tokens; 0 (TOK_EOF) means "not punctuation" */
+static const uint8_t PUNCT[256] = {
+    ['('] = TOK_LPAREN,
+    [')'] = TOK_RPAREN,
+    ['{'] = TOK_LBRACE,
+    ['}'] = TOK_RBRACE,
+    [';'] = TOK_SEMI
+};
+
+/* ------------------------------------------------------------
+ * Keywords: perfect hash on (first, last, length)
+ *
+ * Each keyword owns one slot. Adding one is a single row; if its
+ * slot is taken the duplicate designator trips -Woverride-init
+ * (part of -Wextra), and the multiplier or KW_SLOTS must change.
+ * ------------------------------------------------------------ */
+
+#define KW_SLOTS   16u
+#define KW_MAX_LEN 6u
+
+#define KW_HASH(first, last, len)                                   \
+    ((((unsigned)(unsigned char)(first) * 31u) +                    \
+      (unsigned)(unsigned char)(last) + (unsigned)(len)) & (KW_SLOTS - 1u))
+
+typedef struct Keyword {
+    const char *text;
+    size_t      len;
+    TokKind     kind;
+} Keyword;
+
+static const Keyword KEYWORDS[KW_SLOTS] = {
+    [KW_HASH('i', 't', 3)] = { "int",    3, TOK_INT    },
+    [KW_HASH('r', 'n', 6)] = { "return", 6, TOK_RETURN },
+};
+
+static TokKind keyword_kind(const char *s, size_t len)
+{
+    if (len > KW_MAX_LEN) {
+        return TOK_IDENT;
+    }
+
+    const Keyword *kw = &KEYWORDS[KW_HASH(s[0], s[len - 1], len)];
+    if (kw->len == len && memcmp(kw->text, s, len) == 0) {
+        return kw->kind;
+    }
+    return TOK_IDENT;
+}
+
+/* ------------------------------------------------------------
+ * Run skipping
+ * ------------------------------------------------------------ */
+
+#ifdef LEXER_SIMD
+/* Bytes in [lo, hi]; bytes >= 0x80 compare negative and never match */
+static __m128i in_range(__m128i v, char lo, char hi)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8((char)(hi + 1))));
+}
+#endif
+
+/* Length of the whitespace run at s[0..n) */
+static size_t span_space(const char *s, size_t n)
+{
+    size_t i = 0;
+
+#ifdef LEXER_SIMD
+    /* Most runs are a single byte: only go wide for longer ones */
+    if (n >= 17 && (CLASS(s[0]) & CC_SPACE) && (CLASS(s[1]) & CC_SPACE)) {
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+            __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                     in_range(v, '\t', '\r'));
+            unsigned bits = (unsigned)_mm_movemask_epi8(m);
+            if (bits != 0xFFFFu) {
+                return i + (size_t)__builtin_ctz(~bits);
+            }
+        }
+    }
+#endif
+
+    while (i < n && (CLASS(s[i]) & CC_SPACE)) i++;
+    return i;
+}
+
+/* Length of the [0-9A-Za-z] run at s[0..n) */
+static size_t span_alnum(const char *s, size_t n)
+{
+    size_t i = 0;
+
+#ifdef LEXER_SIMD
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i m = _mm_or_si128(in_range(v, '0', '9'),
+                                 in_range(lower, 'a', 'z'));
+        unsigned bits = (unsigned)_mm_movemask_epi8(m);
+        if (bits != 0xFFFFu) {
+            return i + (size_t)__builtin_ctz(~bits);
+        }
+    }
+#endif
+
+    while (i < n && (CLASS(s[i]) & CC_ALNUM)) i++;
+    return i;
+}
+
+/* ------------------------------------------------------------
+ * Scanner
+ * ------------------------------------------------------------ */
 
 void lexer_init(Lexer *lx, const char *path, const char *src, size_t len)
 {
+    memset(lx, 0, sizeof(*lx));
     lx->path = path;
     lx->src  = src;
     lx->len  = len;
     lx->pos  = 0;
+    lx->symbols = NULL;
+    lx->line = 1;
+    lx->line_start = 0;
+}
+
+void lexer_free(Lexer *lx)
+{
+    if (!lx) return;
+    free(lx->stream.items);
+    memset(&lx->stream, 0, sizeof(lx->stream));
+    lx->tokenized = 0;
 }
 
-static void skip_ws(Lexer *lx)
+/* Skip whitespace; newlines only ever occur inside these runs */
+static void skip_space(Lexer *lx)
 {
-    while (lx->pos < lx->len && isspace((unsigned char)lx->src[lx->pos])) {
-        lx->pos++;
+    const char *s = lx->src + lx->pos;
+    size_t n = span_space(s, lx->len - lx->pos);
+    const char *end = s + n;
+
+    for (const char *nl = memchr(s, '\n', n); nl;
+         nl = memchr(nl + 1, '\n', (size_t)(end - nl - 1))) {
+        lx->line++;
+        lx->line_start = (size_t)(nl - lx->src) + 1;
     }
+
+    lx->pos += n;
 }
 
-Token lexer_next(Lexer *lx)
+static Token make_token(const Lexer *lx, TokKind kind, const char *s,
+                        size_t len, Symbol sym)
+{
+    return (Token){
+        .kind   = kind,
+        .lexeme = s,
+        .len    = len,
+        .sym    = sym,
+        .line   = lx->line,
+        .col    = (uint32_t)(lx->pos - lx->line_start + 1)
+    };
+}
+
+/* Scan one token from `pos` */
+static Token lexer_scan(Lexer *lx)
 {
-    skip_ws(lx);
+    skip_space(lx);
 
     if (lx->pos >= lx->len) {
-        return (Token){ TOK_EOF, NULL, 0 };
+        return make_token(lx, TOK_EOF, NULL, 0, SYMBOL_NONE);
     }
 
     const char *s = lx->src + lx->pos;
+    size_t rest = lx->len - lx->pos;
+    uint8_t cls = CLASS(*s);
+    Token t;
 
-    /* Keywords */
-    if (strncmp(s, "int", 3) == 0 && !isalnum(s[3])) {
-        lx->pos += 3;
-        return (Token){ TOK_INT, s, 3 };
-    }
+    /* Keyword or identifier */
+    if (cls & CC_ALPHA) {
+        size_t i = 1 + span_alnum(s + 1, rest - 1);
+        TokKind kind = keyword_kind(s, i);
+        Symbol sym = SYMBOL_NONE;
 
-    if (strncmp(s, "return", 6) == 0 && !isalnum(s[6])) {
-        lx->pos += 6;
-        return (Token){ TOK_RETURN, s, 6 };
-    }
+        if (kind == TOK_IDENT && lx->symbols) {
+            sym = intern(lx->symbols, s, i);
+        }
 
-    /* Identifier (only "main" supported) */
-    if (isalpha((unsigned char)*s)) {
-        size_t i = 0;
-        while (isalnum((unsigned char)s[i])) i++;
+        t = make_token(lx, kind, s, i, sym);
         lx->pos += i;
-        return (Token){ TOK_IDENT, s, i };
+        return t;
     }
 
     /* Integer literal */
-    if (isdigit((unsigned char)*s)) {
-        size_t i = 0;
-        while (isdigit((unsigned char)s[i])) i++;
+    if (cls & CC_DIGIT) {
+        size_t i = 1;
+        while (i < rest && (CLASS(s[i]) & CC_DIGIT)) i++;
+        t = make_token(lx, TOK_INT_LIT, s, i, SYMBOL_NONE);
         lx->pos += i;
-        return (Token){ TOK_INT_LIT, s, i };
+        return t;
     }
 
-    /* Punctuation */
+    /* Punctuation; anything else ends the stream */
+    TokKind punct = (TokKind)PUNCT[(unsigned char)*s];
+    t = punct != TOK_EOF
+        ? make_token(lx, punct, s, 1, SYMBOL_NONE)
+        : make_token(lx, TOK_EOF, NULL, 0, SYMBOL_NONE);
     lx->pos++;
-    switch (*s) {
-    case '(': return (Token){ TOK_LPAREN, s, 1 };
-    case ')': return (Token){ TOK_RPAREN, s, 1 };
-    case '{': return (Token){ TOK_LBRACE, s, 1 };
-    case '}': return (Token){ TOK_RBRACE, s, 1 };
-    case ';': return (Token){ TOK_SEMI,   s, 1 };
-    default:  return (Token){ TOK_EOF, NULL, 0 };
+    return t;
+}
+
+/* ------------------------------------------------------------
+ * Tokenised mode
+ * ------------------------------------------------------------ */
+
+static Token token_from_rec(const Lexer *lx, const TokenRec *r)
+{
+    return (Token){
+        .kind   = (TokKind)r->kind,
+        .lexeme = r->kind == TOK_EOF ? NULL : lx->src + r->offset,
+        .len    = r->len,
+        .sym    = r->sym,
+        .line   = r->line,
+        .col    = r->col
+    };
+}
+
+/* Record at `cursor + k`; the final TOK_EOF repeats forever */
+static const TokenRec *stream_at(const Lexer *lx, size_t k)
+{
+    size_t i = lx->cursor + k;
+    if (i >= lx->stream.count) {
+        i = lx->stream.count - 1;
+    }
+    return &lx->stream.items[i];
+}
+
+int lexer_tokenize(Lexer *lx)
+{
+    if (!lx || lx->tokenized || lx->len > UINT32_MAX) {
+        return 0;
+    }
+
+    TokenStream ts = {0};
+
+    /* Roughly one token per 8 bytes of typical source */
+    ts.cap = lx->len / 8 + 64;
+    ts.items = malloc(ts.cap * sizeof(*ts.items));
+    if (!ts.items) {
+        return 0;
+    }
+
+    /* A token already peeked comes first */
+    for (;;) {
+        Token t = lexer_next(lx);
+
+        if (ts.count == ts.cap) {
+            size_t ncap = ts.cap * 2;
+            TokenRec *ni = realloc(ts.items, ncap * sizeof(*ni));
+            if (!ni) {
+                free(ts.items);
+                return 0;
+            }
+            ts.items = ni;
+            ts.cap = ncap;
+        }
+
+        ts.items[ts.count++] = (TokenRec){
+            .offset = t.lexeme ? (uint32_t)(t.lexeme - lx->src) : 0,
+            .len    = (uint32_t)t.len,
+            .line   = t.line,
+            .col    = t.col,
+            .sym    = t.sym,
+            .kind   = (uint32_t)t.kind
+        };
+
+        /* Every TOK_EOF ends the parse, so nothing after it matters */
+        if (t.kind == TOK_EOF) {
+            break;
+        }
+    }
+
+    lx->stream = ts;
+    lx->cursor = 0;
+    lx->tokenized = 1;
+    return 1;
+}
+
+/* ------------------------------------------------------------
+ * Consumption
+ * ------------------------------------------------------------ */
+
+Token lexer_next(Lexer *lx)
+{
+    if (lx->tokenized) {
+        Token t = token_from_rec(lx, stream_at(lx, 0));
+        if (lx->cursor < lx->stream.count - 1) {
+            lx->cursor++;
+        }
+        return t;
+    }
+
+    if (lx->has_peek) {
+        lx->has_peek = 0;
+        return lx->peek;
+    }
+    return lexer_scan(lx);
+}
+
+Token lexer_peek(Lexer *lx)
+{
+    if (lx->tokenized) {
+        return token_from_rec(lx, stream_at(lx, 0));
+    }
+
+    if (!lx->has_peek) {
+        lx->peek = lexer_scan(lx);
+        lx->has_peek = 1;
+    }
+    return lx->peek;
+}
+
+Token lexer_peek_at(Lexer *lx, size_t k)
+{
+    if (lx->tokenized) {
+        return token_from_rec(lx, stream_at(lx, k));
+    }
+
+    if (k == 0) {
+        return lexer_peek(lx);
+    }
+
+    /* On demand: scan ahead on a copy, leaving `lx` untouched */
+    Lexer ahead = *lx;
+    Token t = lexer_next(&ahead);
+    for (size_t i = 0; i < k && t.kind != TOK_EOF; i++) {
+        t = lexer_next(&ahead);
     }
+    return t;
 }
 
 int lexer_accept(Lexer *lx, TokKind k)
 {
-    size_t save = lx->pos;
-    Token t = lexer_next(lx);
-    if (t.kind == k) return 1;
-    lx->pos = save;
-    return 0;
+    if (lexer_peek(lx).kind != k) return 0;
+    lexer_next(lx);
+    return 1;
 }
@@ -2,6 +2,9 @@
 #define LIMINAL_C_LEXER_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include "common/intern/intern.h"
 
 typedef enum TokKind {
     TOK_EOF = 0,
@@ -26,18 +29,90 @@ typedef struct Token {
     TokKind kind;
     const char *lexeme;   /* points into source */
     size_t len;
+    Symbol sym;           /* TOK_IDENT only, when interning */
+    uint32_t line;        /* 1-based */
+    uint32_t col;         /* 1-based, in bytes */
 } Token;
 
+/*
+ * TokenStream
+ *
+ * Compact record of every token, written in one pass by
+ * lexer_tokenize. The lexeme is recovered from `offset`.
+ */
+typedef struct TokenRec {
+    uint32_t offset;
+    uint32_t len;
+    uint32_t line;
+    uint32_t col;
+    Symbol   sym;
+    uint32_t kind;        /* TokKind */
+} TokenRec;
+
+typedef struct TokenStream {
+    TokenRec *items;
+    size_t    count;      /* includes the final TOK_EOF */
+    size_t    cap;
+} TokenStream;
+
+/*
+ * Lexer
+ *
+ * Two modes:
+ *
+ *   on demand  — tokens are scanned as they are consumed. A single
+ *                token of lookahead is buffered, so lexer_accept and
+ *                lexer_peek never re-scan: `pos` is the offset just
+ *                past the last token scanned, peeked or not.
+ *   tokenised  — lexer_tokenize scans the whole input once into
+ *                `stream`; every call after that indexes the array
+ *                and any lookahead is free.
+ *
+ * Both track line and column as they go. Sources are limited to
+ * 4 GiB (offsets are 32-bit in token records). The source need not
+ * be NUL-terminated.
+ */
 typedef struct Lexer {
     const char *path;
     const char *src;
     size_t      len;
     size_t      pos;
+
+    /* Identifiers are interned here when set (may be NULL) */
+    InternTable *symbols;
+
+    /* Position of `pos` */
+    uint32_t line;
+    size_t   line_start;
+
+    /* One-token lookahead (on demand) */
+    Token peek;
+    int   has_peek;
+
+    /* Tokenised mode */
+    TokenStream stream;
+    size_t      cursor;
+    int         tokenized;
 } Lexer;
 
 /* API */
 void  lexer_init(Lexer *lx, const char *path, const char *src, size_t len);
+void  lexer_free(Lexer *lx);
 Token lexer_next(Lexer *lx);
+Token lexer_peek(Lexer *lx);
 int   lexer_accept(Lexer *lx, TokKind k);
 
+/*
+ * Token `k` positions ahead (0 == lexer_peek).
+ * O(1) once tokenised; re-scans from a copy otherwise.
+ */
+Token lexer_peek_at(Lexer *lx, size_t k);
+
+/*
+ * Scan the rest of the input into `lx->stream` and switch to
+ * tokenised mode. Returns 0 on allocation failure or if the source
+ * is too large, leaving the lexer in on-demand mode.
+ */
+int   lexer_tokenize(Lexer *lx);
+
 #endif /* LIMINAL_C_LEXER_H */
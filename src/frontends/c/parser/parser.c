@@ -2,9 +2,81 @@
 #include <string.h>
 #include "./parser.h"
 
+/*
+ * Scratch stack of statement ids shared by every block of a parse.
+ *
+ * A block pushes its statements above the entries of the blocks
+ * that enclose it, copies them into the AST arena once it sees the
+ * closing brace, and pops back to where it started. The stack grows
+ * by doubling, so any block size parses in linear time.
+ */
+typedef struct {
+    uint32_t *items;
+    size_t count;
+    size_t cap;
+} StmtStack;
+
 // Forward Declarations
-static uint32_t parse_block(ASTProgram *p, Lexer *lx);
-static uint32_t parse_statement(ASTProgram *p, Lexer *lx);
+static uint32_t parse_block(ASTProgram *p, Lexer *lx, StmtStack *ss,
+                            ASTSpan at);
+static uint32_t parse_statement(ASTProgram *p, Lexer *lx, StmtStack *ss);
+
+static int stmt_push(StmtStack *ss, uint32_t id)
+{
+    if (ss->count == ss->cap) {
+        size_t ncap = ss->cap ? ss->cap * 2 : 256;
+        uint32_t *ni = realloc(ss->items, ncap * sizeof(*ni));
+        if (!ni) return 0;
+        ss->items = ni;
+        ss->cap = ncap;
+    }
+
+    ss->items[ss->count++] = id;
+    return 1;
+}
+
+/*
+ * Parse statements up to and including the closing brace, pushing
+ * their ids onto the stack.
+ */
+static int parse_stmt_list(ASTProgram *p, Lexer *lx, StmtStack *ss)
+{
+    for (;;) {
+        /* End of block */
+        if (lexer_accept(lx, TOK_RBRACE)) {
+            break;
+        }
+
+        uint32_t stmt = parse_statement(p, lx, ss);
+        if (stmt == 0 || !stmt_push(ss, stmt)) {
+            return 0; /* parse error */
+        }
+    }
+
+    return 1;
+}
+
+/* Copy the statements above `base` into `blk` and pop them */
+static int stmt_commit(ASTProgram *p, StmtStack *ss, size_t base,
+                       uint32_t blk_id)
+{
+    size_t n = ss->count - base;
+    ASTNode *blk = ast_node_get(p, blk_id);
+    if (!blk) return 0;
+
+    blk->as.block.stmt_ids = ast_alloc(p, sizeof(uint32_t) * n);
+    if (!blk->as.block.stmt_ids && n)
+        return 0;
+
+    if (n) {
+        memcpy(blk->as.block.stmt_ids, ss->items + base,
+               sizeof(uint32_t) * n);
+    }
+    blk->as.block.stmt_count = n;
+
+    ss->count = base;
+    return 1;
+}
 
 /*
  * Parse a C translation unit.
@@ -12,144 +84,135 @@ static uint32_t parse_statement(ASTProgram *p, Lexer *lx);
  * STAGE 1.5:
  *   - minimal real parser
  *   - supports:
- *       int main() { <stmts> }
+ *       int <ident>() { <stmts> }   one or more
  *       int <ident> ;
  *       return <int> ;
+ *       { <stmts> }
+ *
+ * Blocks may hold any number of statements.
  *
  * Produces a structural AST artifact only.
  */
 ASTProgram *parse_translation_unit(Lexer *lx)
 {
-    ASTProgram *p = ast_program_new(lx->path, lx->src, lx->len);
+    return parse_translation_unit_recycle(lx, NULL);
+}
+
+ASTProgram *parse_translation_unit_recycle(Lexer *lx, ASTProgram *old)
+{
+    ASTProgram *p = ast_program_recycle(old, lx->path, lx->src, lx->len);
     if (!p) return NULL;
 
-    /* dummy span for now */
-    ASTSpan z = { .line = 1, .col = 1 };
+    StmtStack ss = {0};
 
-    /* Expect: int */
-    if (!lexer_accept(lx, TOK_INT)) goto fail;
+    /* Identifiers become symbols of this program */
+    lx->symbols = &p->symbols;
 
-    /* Expect: main */
-    Token ident = lexer_next(lx);
-    if (ident.kind != TOK_IDENT) goto fail;
+    /*
+     * Tokenise once up front; if that fails (out of memory) the
+     * lexer simply keeps scanning on demand.
+     */
+    lexer_tokenize(lx);
 
-    /* Expect: () */
-    if (!lexer_accept(lx, TOK_LPAREN)) goto fail;
-    if (!lexer_accept(lx, TOK_RPAREN)) goto fail;
+    ASTSpan origin = { .line = 1, .col = 1 };
+    uint32_t prog_id = 0;
 
-    /* Expect: { */
-    if (!lexer_accept(lx, TOK_LBRACE)) goto fail;
+    /* One or more of: int <ident> ( ) { <statements> } */
+    do {
+        /* Expect: int */
+        Token kw = lexer_peek(lx);
+        ASTSpan fn_at = { .line = kw.line, .col = kw.col };
+        if (!lexer_accept(lx, TOK_INT)) goto fail;
 
-    /* ---- Parse statements ---- */
+        /* Expect: name */
+        Token ident = lexer_next(lx);
+        if (ident.kind != TOK_IDENT || ident.sym == SYMBOL_NONE) goto fail;
 
-    uint32_t stmts[64];
-    size_t stmt_count = 0;
+        /* Expect: () */
+        if (!lexer_accept(lx, TOK_LPAREN)) goto fail;
+        if (!lexer_accept(lx, TOK_RPAREN)) goto fail;
 
-    for (;;) {
-        if (lexer_accept(lx, TOK_RBRACE))
-            break;
+        /* Expect: { */
+        Token lb = lexer_peek(lx);
+        ASTSpan body_at = { .line = lb.line, .col = lb.col };
+        if (!lexer_accept(lx, TOK_LBRACE)) goto fail;
 
-        uint32_t stmt = parse_statement(p, lx);
-        if (stmt == 0)
-            goto fail;
+        /* ---- Parse statements ---- */
 
-        stmts[stmt_count++] = stmt;
-    }
-    /* ---- Build structural AST ---- */
+        if (!parse_stmt_list(p, lx, &ss)) goto fail;
 
-    uint32_t prog_id = ast_add_node(p, AST_PROGRAM, z);
-    uint32_t fn_id   = ast_add_node(p, AST_FUNCTION, z);
-    uint32_t blk_id  = ast_add_node(p, AST_BLOCK, z);
+        /* ---- Build structural AST ---- */
 
-    ASTNode *fn  = ast_node_get(p, fn_id);
-    ASTNode *blk = ast_node_get(p, blk_id);
+        /*
+         * The program node follows the first function's statements,
+         * so a function's nodes are contiguous, ending with its
+         * FUNCTION and body BLOCK.
+         */
+        if (!prog_id) {
+            prog_id = ast_add_node(p, AST_PROGRAM, origin);
+            if (!prog_id) goto fail;
+        }
 
-    /* function name */
-    {
-        const char *name = "main";
-        size_t len = strlen(name) + 1;
-        char *owned = malloc(len);
-        if (!owned) goto fail;
-        memcpy(owned, name, len);
-        fn->as.fn.name = owned;
-    }
+        uint32_t fn_id  = ast_add_node(p, AST_FUNCTION, fn_at);
+        uint32_t blk_id = ast_add_node(p, AST_BLOCK, body_at);
+        if (!fn_id || !blk_id) goto fail;
 
-    fn->as.fn.body_id = blk_id;
+        ASTNode *fn = ast_node_get(p, fn_id);
+        fn->as.fn.name    = ident.sym;
+        fn->as.fn.body_id = blk_id;
 
-    blk->as.block.stmt_ids = malloc(sizeof(uint32_t) * stmt_count);
-    if (!blk->as.block.stmt_ids) goto fail;
+        if (!stmt_commit(p, &ss, 0, blk_id)) goto fail;
+    } while (lexer_peek(lx).kind != TOK_EOF);
 
-    memcpy(blk->as.block.stmt_ids, stmts, sizeof(uint32_t) * stmt_count);
-    blk->as.block.stmt_count = stmt_count;
+    free(ss.items);
 
     p->root_id = prog_id;
     return p;
 
 fail:
+    free(ss.items);
     ast_program_free(p);
     return NULL;
 }
 
 
-static uint32_t parse_block(ASTProgram *p, Lexer *lx)
+/* `at` is the position of the opening brace */
+static uint32_t parse_block(ASTProgram *p, Lexer *lx, StmtStack *ss,
+                            ASTSpan at)
 {
-    ASTSpan z = { .line = 1, .col = 1 };
-
-    uint32_t stmt_ids[64];
-    size_t stmt_count = 0;
-
-    for (;;) {
-        /* End of block */
-        if (lexer_accept(lx, TOK_RBRACE)) {
-            break;
-        }
-
-        uint32_t stmt = parse_statement(p, lx);
-        if (stmt == 0) {
-            return 0; /* parse error */
-        }
-
-        stmt_ids[stmt_count++] = stmt;
-    }
-
-    uint32_t block_id = ast_add_node(p, AST_BLOCK, z);
-    ASTNode *blk = ast_node_get(p, block_id);
-
-    blk->as.block.stmt_ids =
-        malloc(sizeof(uint32_t) * stmt_count);
-    if (!blk->as.block.stmt_ids)
+    size_t base = ss->count;
+    if (!parse_stmt_list(p, lx, ss))
         return 0;
 
-    memcpy(
-        blk->as.block.stmt_ids,
-        stmt_ids,
-        sizeof(uint32_t) * stmt_count
-    );
-    blk->as.block.stmt_count = stmt_count;
+    uint32_t block_id = ast_add_node(p, AST_BLOCK, at);
+    if (!block_id || !stmt_commit(p, ss, base, block_id))
+        return 0;
 
     return block_id;
 }
 
-static uint32_t parse_statement(ASTProgram *p, Lexer *lx)
+static uint32_t parse_statement(ASTProgram *p, Lexer *lx, StmtStack *ss)
 {
-    ASTSpan z = { .line = 1, .col = 1 };
+    /* A statement is located at its first token */
+    Token first = lexer_peek(lx);
+    ASTSpan at = { .line = first.line, .col = first.col };
 
     /* Nested block */
     if (lexer_accept(lx, TOK_LBRACE)) {
-        return parse_block(p, lx);
+        return parse_block(p, lx, ss, at);
     }
 
     /* int <ident> ; */
     if (lexer_accept(lx, TOK_INT)) {
         Token id = lexer_next(lx);
-        if (id.kind != TOK_IDENT)
+        if (id.kind != TOK_IDENT || id.sym == SYMBOL_NONE)
             return 0;
         if (!lexer_accept(lx, TOK_SEMI))
             return 0;
 
-        uint32_t node_id = ast_add_node(p, AST_VAR_DECL, z);
+        uint32_t node_id = ast_add_node(p, AST_VAR_DECL, at);
         ASTNode *vd = ast_node_get(p, node_id);
-        vd->as.vdecl.name = strndup(id.lexeme, id.len);
+        vd->as.vdecl.name = id.sym;
         return node_id;
     }
 
@@ -161,23 +224,22 @@ static uint32_t parse_statement(ASTProgram *p, Lexer *lx)
         if (!lexer_accept(lx, TOK_SEMI))
             return 0;
 
-        uint32_t node_id = ast_add_node(p, AST_RETURN, z);
+        uint32_t node_id = ast_add_node(p, AST_RETURN, at);
         ASTNode *r = ast_node_get(p, node_id);
         r->as.ret.value = 0;
         return node_id;
     }
 
     /* <ident> ; → variable use */
-    {
-        size_t save = lx->pos;
+    if (lexer_peek(lx).kind == TOK_IDENT) {
         Token id = lexer_next(lx);
-        if (id.kind == TOK_IDENT && lexer_accept(lx, TOK_SEMI)) {
-            uint32_t node_id = ast_add_node(p, AST_VAR_USE, z);
-            ASTNode *vu = ast_node_get(p, node_id);
-            vu->as.vuse.name = strndup(id.lexeme, id.len);
-            return node_id;
-        }
-        lx->pos = save;
+        if (id.sym == SYMBOL_NONE || !lexer_accept(lx, TOK_SEMI))
+            return 0;
+
+        uint32_t node_id = ast_add_node(p, AST_VAR_USE, at);
+        ASTNode *vu = ast_node_get(p, node_id);
+        vu->as.vuse.name = id.sym;
+        return node_id;
     }
 
     return 0;
@@ -18,4 +18,7 @@
 
 ASTProgram *parse_translation_unit(Lexer *lx);
 
+/* Same, building in the memory of `old` (see ast_program_recycle) */
+ASTProgram *parse_translation_unit_recycle(Lexer *lx, ASTProgram *old);
+
 #endif /* LIMINAL_C_PARSER_H */
@@ -26,10 +26,17 @@
 
 static void print_usage(const char *prog)
 {
-    printf("Usage: %s run <file> [options]\n", prog);
+    printf("Usage: %s run <file|-> [options]\n", prog);
+    printf("       %s analyze <file>\n", prog);
+    printf("       %s batch <dir|@listfile> [-j N] [--artifact-dir <path>] "
+           "[--run-id <string>]\n"
+           "             [--cache] [--cache-size <MiB>]\n", prog);
+    printf("       %s serve --socket <path> [-j N] [--queue N]\n", prog);
     printf("\nOptions:\n");
     printf("  --emit-artifacts\n");
     printf("  --emit-timeline\n");
+    printf("  --timeline-format <ndjson|binary|both>  (default: ndjson)\n");
+    printf("  --timeline-varint       (delta+varint timeline.bin)\n");
     printf("  --artifact-dir <path>   (default: .liminal)\n");
     printf("  --run-id <string>       (optional override)\n");
     printf("\n");
@@ -43,10 +50,14 @@ static int cmd_run(int argc, char **argv)
 
     bool emit_artifacts = false;
     bool emit_timeline_flag = false;
+    unsigned timeline_formats = ARTIFACT_TIMELINE_NDJSON;
+    bool timeline_varint = false;
 
     /* ---- ARG PARSING ---- */
     for (int i = 0; i < argc; i++) {
-        if (!input_path && argv[i][0] != '-') {
+        /* "-" reads the translation unit from stdin */
+        if (!input_path &&
+            (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
             input_path = argv[i];
             continue;
         }
@@ -61,6 +72,29 @@ static int cmd_run(int argc, char **argv)
             continue;
         }
 
+        if (strcmp(argv[i], "--timeline-format") == 0) {
+            const char *v = i + 1 < argc ? argv[++i] : "";
+            if (strcmp(v, "ndjson") == 0) {
+                timeline_formats = ARTIFACT_TIMELINE_NDJSON;
+            } else if (strcmp(v, "binary") == 0) {
+                timeline_formats = ARTIFACT_TIMELINE_BINARY;
+            } else if (strcmp(v, "both") == 0) {
+                timeline_formats = ARTIFACT_TIMELINE_NDJSON |
+                                   ARTIFACT_TIMELINE_BINARY;
+            } else {
+                fprintf(stderr,
+                        "error: --timeline-format needs ndjson, binary "
+                        "or both\n");
+                return 1;
+            }
+            continue;
+        }
+
+        if (strcmp(argv[i], "--timeline-varint") == 0) {
+            timeline_varint = true;
+            continue;
+        }
+
         if (strcmp(argv[i], "--artifact-dir") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr, "error: --artifact-dir requires a path\n");
@@ -105,11 +139,19 @@ static int cmd_run(int argc, char **argv)
     executor_dump(u);
 
     /* ---- ANALYSIS ---- */
-    DiagnosticArtifact diagnostics = analyze_diagnostics(u->head);
+    DiagnosticArtifact diagnostics = analyze_diagnostics(&u->timeline);
+    if (!diagnostics.items) {
+        fprintf(stderr, "failed to analyze timeline\n");
+        universe_destroy(u);
+        ast_program_free(ast);
+        return 1;
+    }
     diagnostic_dump(&diagnostics);
 
     /* ---- POLICY (STAGE 6) ---- */
     if (cmd_apply_policy(&LIMINAL_DEFAULT_POLICY, &diagnostics) != 0) {
+        diagnostic_artifact_free(&diagnostics);
+        universe_destroy(u);
         ast_program_free(ast);
         return 1;
     }
@@ -130,26 +172,60 @@ static int cmd_run(int argc, char **argv)
             .run_id     = run_id,
             .input_path = input_path,
             .started_at = (unsigned long)now,
-            .world_head = u->head
+            .timeline   = &u->timeline,
+            .timeline_formats = timeline_formats
         };
+        if (timeline_varint &&
+            (timeline_formats & ARTIFACT_TIMELINE_BINARY)) {
+            ctx.timeline_formats |= ARTIFACT_TIMELINE_VARINT;
+        }
 
         if (emit_artifacts) {
             artifact_emit_all(&ctx, &diagnostics);
         }
 
         if (emit_timeline_flag) {
-          emit_timeline(u->head, stdout);
+          emit_timeline(&u->timeline, stdout);
         }
     }
 
+    diagnostic_artifact_free(&diagnostics);
+    universe_destroy(u);
     ast_program_free(ast);
     return 0;
 }
 
+/* analyze <file>: root chains, convergence and fix surface */
+static int cmd_analyze_file(int argc, char **argv)
+{
+    (void)argc;
+
+    ASTProgram *ast = c_parse_file_to_ast(argv[0]);
+    if (!ast) {
+        fprintf(stderr, "failed to parse AST\n");
+        return 1;
+    }
+
+    Universe *u = executor_build(ast);
+    if (!u) {
+        fprintf(stderr, "failed to build execution artifact\n");
+        ast_program_free(ast);
+        return 1;
+    }
+
+    int rc = cmd_analyze(&u->timeline);
+
+    universe_destroy(u);
+    ast_program_free(ast);
+    return rc;
+}
+
 static const CommandSpec COMMANDS[] = {
     { "run",     0, cmd_run     },
-    { "analyze", 1, cmd_analyze },
+    { "analyze", 1, cmd_analyze_file },
     { "diff",    2, cmd_diff    },
+    { "batch",   1, cmd_batch   },
+    { "serve",   1, cmd_serve   },
 };
 
 int main(int argc, char **argv)
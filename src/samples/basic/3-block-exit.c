@@ -0,0 +1,8 @@
+int main() {
+    {
+        int x;
+        int y;
+    }
+    int x;
+    return 0;
+}
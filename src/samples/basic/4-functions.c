@@ -0,0 +1,9 @@
+int helper() {
+    int x;
+    return 0;
+}
+
+int main() {
+    int x;
+    return 0;
+}
@@ -0,0 +1,8 @@
+int helper() {
+    return 0;
+}
+
+int main() {
+    int x;
+    int x;
+}